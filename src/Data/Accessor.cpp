@@ -19,53 +19,69 @@
 
 #include "Mission/ACTResource.h"
 
-#define SEARCH( CLASS_NAME, GET_METHOD_NAME, ALL_METHOD_NAME, GET_CONST_METHOD_NAME, ALL_CONST_METHOD_NAME ) \
+#include <algorithm>
+#include <numeric>
+
+#define SEARCH( CLASS_NAME, TABLE, GET_METHOD_NAME, ALL_METHOD_NAME, GET_CONST_METHOD_NAME, ALL_CONST_METHOD_NAME ) \
 \
 Mission::CLASS_NAME* Accessor::GET_METHOD_NAME( uint32_t resource_id ) {\
-    Mission::Resource *resource_r = nullptr;\
-    SearchValue search_value = { Mission::CLASS_NAME::IDENTIFIER_TAG, resource_id };\
+    const IndexEntry *entry_r = findEntry( { Mission::CLASS_NAME::IDENTIFIER_TAG, resource_id } );\
+\
+    if( entry_r == nullptr )\
+        return nullptr;\
 \
-    auto result = search.find(search_value);\
+    Mission::CLASS_NAME *resource_r = TABLE.changable_r[ entry_r->position ];\
 \
-    if( result != search.end() )\
-        resource_r = (*result).second.changable_r;\
+    if( resource_r != nullptr )\
+        resource_r->ensureParsed();\
 \
-    return dynamic_cast<Mission::CLASS_NAME*>( resource_r );\
+    return resource_r;\
 }\
 const Mission::CLASS_NAME* Accessor::GET_CONST_METHOD_NAME( uint32_t resource_id ) const {\
-    const Mission::Resource *resource_r = nullptr;\
-    SearchValue search_value = { Mission::CLASS_NAME::IDENTIFIER_TAG, resource_id };\
+    const IndexEntry *entry_r = findEntry( { Mission::CLASS_NAME::IDENTIFIER_TAG, resource_id } );\
 \
-    auto result = search.find(search_value);\
+    if( entry_r == nullptr )\
+        return nullptr;\
 \
-    if( result != search.end() )\
-        resource_r = (*result).second.constant_r;\
+    const Mission::CLASS_NAME *resource_r = TABLE.constant_r[ entry_r->position ];\
 \
-    return dynamic_cast<const Mission::CLASS_NAME*>( resource_r );\
-}\
-std::vector<Mission::CLASS_NAME*> Accessor::ALL_METHOD_NAME() {\
-    std::vector<Mission::CLASS_NAME*> array;\
+    resource_r->ensureParsed();\
 \
-    for( auto r_it = search.begin(); r_it != search.end(); r_it++ ) {\
-        if( (*r_it).first.type == Mission::CLASS_NAME::IDENTIFIER_TAG ) {\
-            assert( dynamic_cast<Mission::CLASS_NAME*>( (*r_it).second.changable_r ) );\
-            array.emplace_back( dynamic_cast<Mission::CLASS_NAME*>( (*r_it).second.changable_r ) );\
-        }\
+    return resource_r;\
+}\
+const std::vector<Mission::CLASS_NAME*>& Accessor::ALL_METHOD_NAME() {\
+    for( Mission::CLASS_NAME *resource_r : TABLE.changable_r ) {\
+        if( resource_r != nullptr )\
+            resource_r->ensureParsed();\
     }\
 \
-    return array;\
+    return TABLE.changable_r;\
 }\
-std::vector<const Mission::CLASS_NAME*> Accessor::ALL_CONST_METHOD_NAME() const {\
-    std::vector<const Mission::CLASS_NAME*> array;\
+const std::vector<const Mission::CLASS_NAME*>& Accessor::ALL_CONST_METHOD_NAME() const {\
+    for( const Mission::CLASS_NAME *resource_r : TABLE.constant_r )\
+        resource_r->ensureParsed();\
 \
-    for( auto r_it = search.begin(); r_it != search.end(); r_it++ ) {\
-        if( (*r_it).first.type == Mission::CLASS_NAME::IDENTIFIER_TAG ) {\
-            assert( dynamic_cast<const Mission::CLASS_NAME*>( (*r_it).second.constant_r ) );\
-            array.emplace_back( dynamic_cast<const Mission::CLASS_NAME*>( (*r_it).second.constant_r ) );\
-        }\
-    }\
-\
-    return array;\
+    return TABLE.constant_r;\
+}
+
+namespace {
+
+const uint32_t EMPTY_POSITION = 0xFFFFFFFF;
+const size_t   MIN_INDEX_SIZE = 64;
+
+size_t hashKey( Data::Accessor::SearchValue key ) {
+    uint64_t hash = (static_cast<uint64_t>( key.type ) << 32) | key.resource_id;
+
+    // The finalizer of MurmurHash3, so that the ids next to each other spread out.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
 }
 
 namespace Data {
@@ -77,59 +93,197 @@ bool Accessor::SearchValue::operator< ( const Accessor::SearchValue & operand )
         return (resource_id < operand.resource_id);
 }
 
-void Accessor::emplaceConstant( const Mission::Resource *constant_resource_r ) {
-    assert(constant_resource_r != nullptr);
+const Accessor::IndexEntry* Accessor::findEntry( SearchValue key ) const {
+    if( index.empty() )
+        return nullptr;
 
-    SearchValue search_value;
+    const size_t mask = index.size() - 1;
 
-    search_value.type = constant_resource_r->getResourceTagID();
-    search_value.resource_id = constant_resource_r->getResourceID();
+    for( size_t i = hashKey( key ) & mask; index[ i ].position != EMPTY_POSITION; i = (i + 1) & mask ) {
+        if( index[ i ].key.type == key.type && index[ i ].key.resource_id == key.resource_id )
+            return &index[ i ];
+    }
 
-    search[ search_value ] = {nullptr, constant_resource_r};
+    return nullptr;
 }
 
-void Accessor::emplace( Mission::Resource *resource_r ) {
-    assert(resource_r != nullptr);
+void Accessor::insertEntry( SearchValue key, uint32_t position ) {
+    // Keep the load factor under a half so the probes stay short.
+    if( 2 * (index_amount + 1) > index.size() ) {
+        std::vector<IndexEntry> old_index( std::max( MIN_INDEX_SIZE, 2 * index.size() ), IndexEntry { { 0, 0 }, EMPTY_POSITION } );
+
+        old_index.swap( index );
+        index_amount = 0;
+
+        for( const IndexEntry &entry : old_index ) {
+            if( entry.position != EMPTY_POSITION )
+                insertEntry( entry.key, entry.position );
+        }
+    }
 
-    SearchValue search_value;
+    const size_t mask = index.size() - 1;
+    size_t i = hashKey( key ) & mask;
 
-    search_value.type = resource_r->getResourceTagID();
-    search_value.resource_id = resource_r->getResourceID();
+    while( index[ i ].position != EMPTY_POSITION )
+        i = (i + 1) & mask;
 
-    search[ search_value ] = {resource_r, resource_r};
+    index[ i ].key = key;
+    index[ i ].position = position;
+    index_amount++;
 }
 
-Accessor::Accessor() {}
+template<class T>
+void Accessor::emplaceInTable( Table<T> &table, Mission::Resource *changable_r, const Mission::Resource *constant_r ) {
+    // The type is only checked here, so the get methods can trust the tables.
+    const T *typed_constant_r = dynamic_cast<const T*>( constant_r );
 
-Accessor::~Accessor() {}
+    if( typed_constant_r == nullptr )
+        return;
 
-void Accessor::loadConstant( const Mission::IFF &iff ) {
-    SearchValue search_value;
+    T *typed_changable_r = nullptr;
 
-    for( auto constant_resource_r : iff.getAllResources() ) {
-        const Mission::ACTResource *actor_resource_r = dynamic_cast<const Mission::ACTResource*>(constant_resource_r);
+    if( changable_r != nullptr )
+        typed_changable_r = const_cast<T*>( typed_constant_r );
 
-        if(actor_resource_r != nullptr)
-            actor_accessor.emplaceActorConstant(actor_resource_r);
-        else {
+    const SearchValue key = { constant_r->getResourceTagID(), constant_r->getResourceID() };
+    const IndexEntry *entry_r = findEntry( key );
+
+    if( entry_r != nullptr ) {
+        // The last loaded resource replaces the one with the same id.
+        table.changable_r[ entry_r->position ] = typed_changable_r;
+        table.constant_r[ entry_r->position ]  = typed_constant_r;
+    }
+    else {
+        insertEntry( key, table.constant_r.size() );
+
+        table.changable_r.push_back( typed_changable_r );
+        table.constant_r.push_back( typed_constant_r );
+    }
+}
+
+template<class T>
+void Accessor::sortTable( Table<T> &table ) {
+    auto is_lower = []( const T *left_r, const T *right_r ) {
+        return left_r->getResourceID() < right_r->getResourceID();
+    };
 
-            search_value.type = constant_resource_r->getResourceTagID();
-            search_value.resource_id = constant_resource_r->getResourceID();
+    if( !std::is_sorted( table.constant_r.begin(), table.constant_r.end(), is_lower ) ) {
+        std::vector<uint32_t> order( table.constant_r.size() );
 
-            search[ search_value ] = {nullptr, constant_resource_r};
+        std::iota( order.begin(), order.end(), 0 );
+        std::sort( order.begin(), order.end(), [&table, &is_lower]( uint32_t left, uint32_t right ) {
+            return is_lower( table.constant_r[ left ], table.constant_r[ right ] );
+        } );
+
+        Table<T> sorted;
+
+        sorted.changable_r.reserve( order.size() );
+        sorted.constant_r.reserve( order.size() );
+
+        for( uint32_t position : order ) {
+            sorted.changable_r.push_back( table.changable_r[ position ] );
+            sorted.constant_r.push_back( table.constant_r[ position ] );
         }
+
+        table.changable_r.swap( sorted.changable_r );
+        table.constant_r.swap( sorted.constant_r );
     }
 
-    if(iff.getMSICResource() != nullptr) {
-        auto constant_resource_r = iff.getMSICResource();
+    for( uint32_t position = 0; position < table.constant_r.size(); position++ )
+        insertEntry( { T::IDENTIFIER_TAG, table.constant_r[ position ]->getResourceID() }, position );
+}
 
-        search_value.type = constant_resource_r->getResourceTagID();
-        search_value.resource_id = constant_resource_r->getResourceID();
+void Accessor::emplace( Mission::Resource *changable_r, const Mission::Resource *constant_r ) {
+    assert(constant_r != nullptr);
+
+    const uint32_t type = constant_r->getResourceTagID();
+
+    if( type == Mission::ANMResource::IDENTIFIER_TAG )
+        emplaceInTable( anm_table, changable_r, constant_r );
+    else if( type == Mission::BMPResource::IDENTIFIER_TAG )
+        emplaceInTable( bmp_table, changable_r, constant_r );
+    else if( type == Mission::DCSResource::IDENTIFIER_TAG )
+        emplaceInTable( dcs_table, changable_r, constant_r );
+    else if( type == Mission::FUNResource::IDENTIFIER_TAG )
+        emplaceInTable( fun_table, changable_r, constant_r );
+    else if( type == Mission::FontResource::IDENTIFIER_TAG )
+        emplaceInTable( fnt_table, changable_r, constant_r );
+    else if( type == Mission::MSICResource::IDENTIFIER_TAG )
+        emplaceInTable( msic_table, changable_r, constant_r );
+    else if( type == Mission::NetResource::IDENTIFIER_TAG )
+        emplaceInTable( net_table, changable_r, constant_r );
+    else if( type == Mission::ObjResource::IDENTIFIER_TAG )
+        emplaceInTable( obj_table, changable_r, constant_r );
+    else if( type == Mission::PTCResource::IDENTIFIER_TAG )
+        emplaceInTable( ptc_table, changable_r, constant_r );
+    else if( type == Mission::PYRResource::IDENTIFIER_TAG )
+        emplaceInTable( pyr_table, changable_r, constant_r );
+    else if( type == Mission::RPNSResource::IDENTIFIER_TAG )
+        emplaceInTable( rpns_table, changable_r, constant_r );
+    else if( type == Mission::SHDResource::IDENTIFIER_TAG )
+        emplaceInTable( shd_table, changable_r, constant_r );
+    else if( type == Mission::SNDSResource::IDENTIFIER_TAG )
+        emplaceInTable( snds_table, changable_r, constant_r );
+    else if( type == Mission::TilResource::IDENTIFIER_TAG )
+        emplaceInTable( til_table, changable_r, constant_r );
+    else if( type == Mission::TOSResource::IDENTIFIER_TAG )
+        emplaceInTable( tos_table, changable_r, constant_r );
+    else if( type == Mission::WAVResource::IDENTIFIER_TAG )
+        emplaceInTable( wav_table, changable_r, constant_r );
+
+    // Every other type has no get method, so it does not need to be stored.
+}
+
+void Accessor::emplaceConstant( const Mission::Resource *constant_resource_r ) {
+    emplace( nullptr, constant_resource_r );
+}
+
+void Accessor::emplace( Mission::Resource *resource_r ) {
+    emplace( resource_r, resource_r );
+}
+
+void Accessor::sortTables() {
+    index.clear();
+    index_amount = 0;
+
+    sortTable( anm_table );
+    sortTable( bmp_table );
+    sortTable( dcs_table );
+    sortTable( fun_table );
+    sortTable( fnt_table );
+    sortTable( msic_table );
+    sortTable( net_table );
+    sortTable( obj_table );
+    sortTable( ptc_table );
+    sortTable( pyr_table );
+    sortTable( rpns_table );
+    sortTable( shd_table );
+    sortTable( snds_table );
+    sortTable( til_table );
+    sortTable( tos_table );
+    sortTable( wav_table );
+}
+
+Accessor::Accessor() : index_amount( 0 ) {}
+
+Accessor::~Accessor() {}
 
-        search[ search_value ] = {nullptr, constant_resource_r};
+void Accessor::loadConstant( const Mission::IFF &iff ) {
+    for( auto constant_resource_r : iff.getAllResources() ) {
+        const Mission::ACTResource *actor_resource_r = dynamic_cast<const Mission::ACTResource*>(constant_resource_r);
+
+        if(actor_resource_r != nullptr)
+            actor_accessor.emplaceActorConstant(actor_resource_r);
+        else
+            emplaceConstant( constant_resource_r );
     }
 
-    auto tos_array = getAllConstTOS();
+    if(iff.getMSICResource() != nullptr)
+        emplaceConstant( iff.getMSICResource() );
+
+    sortTables();
+
+    const auto &tos_array = getAllConstTOS();
 
     if(!tos_array.empty()) {
         for(auto tos_offset : tos_array[0]->getOffsets()) {
@@ -141,34 +295,27 @@ void Accessor::loadConstant( const Mission::IFF &iff ) {
             }
         }
     }
+
+    for( auto &swvr_file : swvr_files )
+        swvr_file.second.sortTables();
 }
 
 void Accessor::load( Mission::IFF &iff ) {
-    SearchValue search_value;
-
     for( auto resource_r : iff.getAllResources() ) {
         Mission::ACTResource *actor_resource_r = dynamic_cast<Mission::ACTResource*>(resource_r);
 
         if(actor_resource_r != nullptr)
             actor_accessor.emplaceActor(actor_resource_r);
-        else {
-            search_value.type = resource_r->getResourceTagID();
-            search_value.resource_id = resource_r->getResourceID();
-
-            search[ search_value ] = {resource_r, resource_r};
-        }
+        else
+            emplace( resource_r );
     }
 
-    if(iff.getMSICResource() != nullptr) {
-        auto resource_r = iff.getMSICResource();
+    if(iff.getMSICResource() != nullptr)
+        emplace( iff.getMSICResource() );
 
-        search_value.type = resource_r->getResourceTagID();
-        search_value.resource_id = resource_r->getResourceID();
+    sortTables();
 
-        search[ search_value ] = {resource_r, resource_r};
-    }
-
-    auto tos_array = getAllConstTOS();
+    const auto &tos_array = getAllConstTOS();
 
     if(!tos_array.empty()) {
         for(auto tos_offset : tos_array[0]->getOffsets()) {
@@ -180,10 +327,32 @@ void Accessor::load( Mission::IFF &iff ) {
             }
         }
     }
+
+    for( auto &swvr_file : swvr_files )
+        swvr_file.second.sortTables();
 }
 
 void Accessor::clear() {
-    search.clear();
+    index.clear();
+    index_amount = 0;
+
+    anm_table.clear();
+    bmp_table.clear();
+    dcs_table.clear();
+    fun_table.clear();
+    fnt_table.clear();
+    msic_table.clear();
+    net_table.clear();
+    obj_table.clear();
+    ptc_table.clear();
+    pyr_table.clear();
+    rpns_table.clear();
+    shd_table.clear();
+    snds_table.clear();
+    til_table.clear();
+    tos_table.clear();
+    wav_table.clear();
+
     actor_accessor.clear();
     swvr_files.clear();
 }
@@ -204,22 +373,22 @@ const Accessor* Accessor::getSWVRAccessor(uint32_t tos_offset) const {
     return const_cast<const Accessor*>(&(*swvr_accessor).second);
 }
 
-SEARCH(ANMResource,   getANM,  getAllANM, getConstANM, getAllConstANM)
-SEARCH(BMPResource,   getBMP,  getAllBMP, getConstBMP, getAllConstBMP)
-SEARCH(DCSResource,   getDCS,  getAllDCS, getConstDCS, getAllConstDCS)
-SEARCH(FUNResource,   getFUN,  getAllFUN, getConstFUN, getAllConstFUN)
-SEARCH(FontResource,  getFNT,  getAllFNT, getConstFNT, getAllConstFNT)
-SEARCH(MSICResource, getMSIC, getAllMSIC, getConstMSIC, getAllConstMSIC)
-SEARCH(NetResource,   getNET,  getAllNET, getConstNET, getAllConstNET)
-SEARCH(ObjResource,   getOBJ,  getAllOBJ, getConstOBJ, getAllConstOBJ)
-SEARCH(PTCResource,   getPTC,  getAllPTC, getConstPTC, getAllConstPTC)
-SEARCH(PYRResource,   getPYR,  getAllPYR, getConstPYR, getAllConstPYR)
-SEARCH(RPNSResource, getRPNS, getAllRPNS, getConstRPNS, getAllConstRPNS)
-SEARCH(SNDSResource, getSNDS, getAllSNDS, getConstSNDS, getAllConstSNDS)
-SEARCH(SHDResource,   getSHD,  getAllSHD, getConstSHD, getAllConstSHD)
-SEARCH(TilResource,   getTIL,  getAllTIL, getConstTIL, getAllConstTIL)
-SEARCH(TOSResource,   getTOS,  getAllTOS, getConstTOS, getAllConstTOS)
-SEARCH(WAVResource,   getWAV,  getAllWAV, getConstWAV, getAllConstWAV)
+SEARCH(ANMResource,   anm_table, getANM,  getAllANM, getConstANM, getAllConstANM)
+SEARCH(BMPResource,   bmp_table, getBMP,  getAllBMP, getConstBMP, getAllConstBMP)
+SEARCH(DCSResource,   dcs_table, getDCS,  getAllDCS, getConstDCS, getAllConstDCS)
+SEARCH(FUNResource,   fun_table, getFUN,  getAllFUN, getConstFUN, getAllConstFUN)
+SEARCH(FontResource,  fnt_table, getFNT,  getAllFNT, getConstFNT, getAllConstFNT)
+SEARCH(MSICResource, msic_table, getMSIC, getAllMSIC, getConstMSIC, getAllConstMSIC)
+SEARCH(NetResource,   net_table, getNET,  getAllNET, getConstNET, getAllConstNET)
+SEARCH(ObjResource,   obj_table, getOBJ,  getAllOBJ, getConstOBJ, getAllConstOBJ)
+SEARCH(PTCResource,   ptc_table, getPTC,  getAllPTC, getConstPTC, getAllConstPTC)
+SEARCH(PYRResource,   pyr_table, getPYR,  getAllPYR, getConstPYR, getAllConstPYR)
+SEARCH(RPNSResource, rpns_table, getRPNS, getAllRPNS, getConstRPNS, getAllConstRPNS)
+SEARCH(SNDSResource, snds_table, getSNDS, getAllSNDS, getConstSNDS, getAllConstSNDS)
+SEARCH(SHDResource,   shd_table, getSHD,  getAllSHD, getConstSHD, getAllConstSHD)
+SEARCH(TilResource,   til_table, getTIL,  getAllTIL, getConstTIL, getAllConstTIL)
+SEARCH(TOSResource,   tos_table, getTOS,  getAllTOS, getConstTOS, getAllConstTOS)
+SEARCH(WAVResource,   wav_table, getWAV,  getAllWAV, getConstWAV, getAllConstWAV)
 
 }
 
@@ -38,20 +38,69 @@ public:
 
         bool operator< ( const SearchValue & operand ) const;
     };
-    struct DataValue {
-        Mission::Resource*       changable_r;
-        const Mission::Resource* constant_r;
-    };
 
 private:
-    std::map<SearchValue, DataValue> search;
+    /**
+     * Every resource type has its own table, so getAll can return it without a scan.
+     * Both arrays are sorted by resource id, and changable_r holds nullptr for resources that got loaded as constant.
+     */
+    template<class T>
+    struct Table {
+        std::vector<T*>       changable_r;
+        std::vector<const T*> constant_r;
+
+        void clear() { changable_r.clear(); constant_r.clear(); }
+    };
+
+    // This tells where a resource is inside its table.
+    struct IndexEntry {
+        SearchValue key;
+        uint32_t position; // EMPTY_POSITION if this entry is not used.
+    };
+
+    // The index is an open addressing hash table with linear probing. Its size is always a power of two.
+    std::vector<IndexEntry> index;
+    size_t index_amount;
+
+    Table<Mission::ANMResource>  anm_table;
+    Table<Mission::BMPResource>  bmp_table;
+    Table<Mission::DCSResource>  dcs_table;
+    Table<Mission::FUNResource>  fun_table;
+    Table<Mission::FontResource> fnt_table;
+    Table<Mission::MSICResource> msic_table;
+    Table<Mission::NetResource>  net_table;
+    Table<Mission::ObjResource>  obj_table;
+    Table<Mission::PTCResource>  ptc_table;
+    Table<Mission::PYRResource>  pyr_table;
+    Table<Mission::RPNSResource> rpns_table;
+    Table<Mission::SHDResource>  shd_table;
+    Table<Mission::SNDSResource> snds_table;
+    Table<Mission::TilResource>  til_table;
+    Table<Mission::TOSResource>  tos_table;
+    Table<Mission::WAVResource>  wav_table;
+
     ActorAccessor actor_accessor;
 
     std::map<uint32_t, Accessor> swvr_files;
 
+    const IndexEntry* findEntry( SearchValue key ) const;
+    void insertEntry( SearchValue key, uint32_t position );
+
+    template<class T>
+    void emplaceInTable( Table<T> &table, Mission::Resource *changable_r, const Mission::Resource *constant_r );
+
+    template<class T>
+    void sortTable( Table<T> &table );
+
+    void emplace( Mission::Resource *changable_r, const Mission::Resource *constant_r );
     void emplaceConstant( const Mission::Resource *resource_r );
     void emplace( Mission::Resource *resource_r );
 
+    /**
+     * This sorts every table by resource id and rebuilds the index to match.
+     */
+    void sortTables();
+
 public:
     Accessor();
     virtual ~Accessor();
@@ -66,85 +115,87 @@ public:
     ActorAccessor& getActorAccessor() { return actor_accessor; }
     const ActorAccessor& getActorAccessor() const { return actor_accessor; }
 
+    // The arrays returned by the getAll methods belong to this Accessor. They are valid until the next load or clear.
+
     Mission::ANMResource* getANM( uint32_t resource_id );
     const Mission::ANMResource* getConstANM( uint32_t resource_id ) const;
-    std::vector<Mission::ANMResource*> getAllANM();
-    std::vector<const Mission::ANMResource*> getAllConstANM() const;
+    const std::vector<Mission::ANMResource*>& getAllANM();
+    const std::vector<const Mission::ANMResource*>& getAllConstANM() const;
 
     Mission::BMPResource* getBMP( uint32_t resource_id );
     const Mission::BMPResource* getConstBMP( uint32_t resource_id ) const;
-    std::vector<Mission::BMPResource*> getAllBMP();
-    std::vector<const Mission::BMPResource*> getAllConstBMP() const;
+    const std::vector<Mission::BMPResource*>& getAllBMP();
+    const std::vector<const Mission::BMPResource*>& getAllConstBMP() const;
 
     Mission::DCSResource* getDCS( uint32_t resource_id );
     const Mission::DCSResource* getConstDCS( uint32_t resource_id ) const;
-    std::vector<Mission::DCSResource*> getAllDCS();
-    std::vector<const Mission::DCSResource*> getAllConstDCS() const;
+    const std::vector<Mission::DCSResource*>& getAllDCS();
+    const std::vector<const Mission::DCSResource*>& getAllConstDCS() const;
 
     Mission::FUNResource* getFUN( uint32_t resource_id );
     const Mission::FUNResource* getConstFUN( uint32_t resource_id ) const;
-    std::vector<Mission::FUNResource*> getAllFUN();
-    std::vector<const Mission::FUNResource*> getAllConstFUN() const;
+    const std::vector<Mission::FUNResource*>& getAllFUN();
+    const std::vector<const Mission::FUNResource*>& getAllConstFUN() const;
 
     Mission::FontResource* getFNT( uint32_t resource_id );
     const Mission::FontResource* getConstFNT( uint32_t resource_id ) const;
-    std::vector<Mission::FontResource*> getAllFNT();
-    std::vector<const Mission::FontResource*> getAllConstFNT() const;
+    const std::vector<Mission::FontResource*>& getAllFNT();
+    const std::vector<const Mission::FontResource*>& getAllConstFNT() const;
 
     Mission::MSICResource* getMSIC( uint32_t resource_id );
     const Mission::MSICResource* getConstMSIC( uint32_t resource_id ) const;
-    std::vector<Mission::MSICResource*> getAllMSIC();
-    std::vector<const Mission::MSICResource*> getAllConstMSIC() const;
+    const std::vector<Mission::MSICResource*>& getAllMSIC();
+    const std::vector<const Mission::MSICResource*>& getAllConstMSIC() const;
 
     Mission::NetResource* getNET( uint32_t resource_id );
     const Mission::NetResource* getConstNET( uint32_t resource_id ) const;
-    std::vector<Mission::NetResource*> getAllNET();
-    std::vector<const Mission::NetResource*> getAllConstNET() const;
+    const std::vector<Mission::NetResource*>& getAllNET();
+    const std::vector<const Mission::NetResource*>& getAllConstNET() const;
 
     Mission::ObjResource* getOBJ( uint32_t resource_id );
     const Mission::ObjResource* getConstOBJ( uint32_t resource_id ) const;
-    std::vector<Mission::ObjResource*> getAllOBJ();
-    std::vector<const Mission::ObjResource*> getAllConstOBJ() const;
+    const std::vector<Mission::ObjResource*>& getAllOBJ();
+    const std::vector<const Mission::ObjResource*>& getAllConstOBJ() const;
 
     Mission::PTCResource* getPTC( uint32_t resource_id );
     const Mission::PTCResource* getConstPTC( uint32_t resource_id ) const;
-    std::vector<Mission::PTCResource*> getAllPTC();
-    std::vector<const Mission::PTCResource*> getAllConstPTC() const;
+    const std::vector<Mission::PTCResource*>& getAllPTC();
+    const std::vector<const Mission::PTCResource*>& getAllConstPTC() const;
 
     Mission::PYRResource* getPYR( uint32_t resource_id );
     const Mission::PYRResource* getConstPYR( uint32_t resource_id ) const;
-    std::vector<Mission::PYRResource*> getAllPYR();
-    std::vector<const Mission::PYRResource*> getAllConstPYR() const;
+    const std::vector<Mission::PYRResource*>& getAllPYR();
+    const std::vector<const Mission::PYRResource*>& getAllConstPYR() const;
 
     Mission::RPNSResource* getRPNS( uint32_t resource_id );
     const Mission::RPNSResource* getConstRPNS( uint32_t resource_id ) const;
-    std::vector<Mission::RPNSResource*> getAllRPNS();
-    std::vector<const Mission::RPNSResource*> getAllConstRPNS() const;
+    const std::vector<Mission::RPNSResource*>& getAllRPNS();
+    const std::vector<const Mission::RPNSResource*>& getAllConstRPNS() const;
 
     Mission::SHDResource* getSHD( uint32_t resource_id );
     const Mission::SHDResource* getConstSHD( uint32_t resource_id ) const;
-    std::vector<Mission::SHDResource*> getAllSHD();
-    std::vector<const Mission::SHDResource*> getAllConstSHD() const;
+    const std::vector<Mission::SHDResource*>& getAllSHD();
+    const std::vector<const Mission::SHDResource*>& getAllConstSHD() const;
 
     Mission::SNDSResource* getSNDS( uint32_t resource_id );
     const Mission::SNDSResource* getConstSNDS( uint32_t resource_id ) const;
-    std::vector<Mission::SNDSResource*> getAllSNDS();
-    std::vector<const Mission::SNDSResource*> getAllConstSNDS() const;
+    const std::vector<Mission::SNDSResource*>& getAllSNDS();
+    const std::vector<const Mission::SNDSResource*>& getAllConstSNDS() const;
 
     Mission::TilResource* getTIL( uint32_t resource_id );
     const Mission::TilResource* getConstTIL( uint32_t resource_id ) const;
-    std::vector<Mission::TilResource*> getAllTIL();
-    std::vector<const Mission::TilResource*> getAllConstTIL() const;
+    const std::vector<Mission::TilResource*>& getAllTIL();
+    const std::vector<const Mission::TilResource*>& getAllConstTIL() const;
 
     Mission::TOSResource* getTOS( uint32_t resource_id );
     const Mission::TOSResource* getConstTOS( uint32_t resource_id ) const;
-    std::vector<Mission::TOSResource*> getAllTOS();
-    std::vector<const Mission::TOSResource*> getAllConstTOS() const;
+    const std::vector<Mission::TOSResource*>& getAllTOS();
+    const std::vector<const Mission::TOSResource*>& getAllConstTOS() const;
 
     Mission::WAVResource* getWAV( uint32_t resource_id );
     const Mission::WAVResource* getConstWAV( uint32_t resource_id ) const;
-    std::vector<Mission::WAVResource*> getAllWAV();
-    std::vector<const Mission::WAVResource*> getAllConstWAV() const;
+    const std::vector<Mission::WAVResource*>& getAllWAV();
+    const std::vector<const Mission::WAVResource*>& getAllConstWAV() const;
 };
 
 } // Data
@@ -83,6 +83,9 @@ ActorAccessor::~ActorAccessor() {}
 void ActorAccessor::emplaceActorConstant( const Mission::ACTResource *constant_resource_r ) {
     SearchValue search_value;
 
+    // The type of an unknown actor is only known after it is parsed.
+    constant_resource_r->ensureParsed();
+
     search_value.actor_type = constant_resource_r->getTypeID();
     search_value.resource_id = constant_resource_r->getResourceID();
 
@@ -92,6 +95,9 @@ void ActorAccessor::emplaceActorConstant( const Mission::ACTResource *constant_r
 void ActorAccessor::emplaceActor( Mission::ACTResource *resource_r ) {
     SearchValue search_value;
 
+    // The type of an unknown actor is only known after it is parsed.
+    resource_r->ensureParsed();
+
     search_value.actor_type = resource_r->getTypeID();
     search_value.resource_id = resource_r->getResourceID();
 
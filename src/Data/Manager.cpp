@@ -1,5 +1,10 @@
 #include "Manager.h"
 
+#include "../Utilities/Parallel.h"
+
+#include <algorithm>
+#include <memory>
+
 namespace {
 
 std::filesystem::path makePath(const std::filesystem::path &base, const std::filesystem::path &file) {
@@ -97,11 +102,11 @@ Data::Manager::IFFEntryStorage::IFFEntryStorage( const IFFEntry& obj ) : IFFEntr
 
 Data::Manager::IFFEntryStorage::~IFFEntryStorage() {}
 
-bool Data::Manager::IFFEntryStorage::load( Platform platform ) {
+bool Data::Manager::IFFEntryStorage::load( Platform platform, const Mission::IFF::OpenSettings &open_settings ) {
     if( platform < Platform::ALL && this->iff_p[ platform ] == nullptr ) {
         this->iff_p[ platform ] = new Mission::IFF;
         
-        auto result = this->iff_p[ platform ]->open( paths[ platform ] );
+        auto result = this->iff_p[ platform ]->open( paths[ platform ], open_settings );
         
         if( result == 1 )
             return true;
@@ -137,46 +142,47 @@ bool Data::Manager::IFFEntryStorage::unload( Platform platform ) {
         return false;
 }
 
-Data::Manager::Manager() : /*thread_lock(),*/ entries(), currently_loaded_platforms( {false} ),
+bool Data::Manager::IFFEntryStorage::setIFF( Platform platform, Mission::IFF *iff_p ) {
+    if( platform < Platform::ALL && this->iff_p[ platform ] == nullptr ) {
+        this->iff_p[ platform ] = iff_p;
+        return true;
+    }
+    else {
+        delete iff_p;
+        return false;
+    }
+}
+
+Data::Manager::Manager() : thread_lock(), entries(), open_settings(), currently_loaded_platforms( {false} ),
                            platforms_to_support( {false} ), current_importance_to_load( NEEDED ) {
+    // The manager could keep many IFF files loaded, so the resources should reference the mapped files instead of copies.
+    open_settings.memory_map = true;
 }
 
 Data::Manager::~Manager() {
+    cancelPrefetches();
+
     for(auto &i : this->entries)
         i.second.unload(Platform::ALL);
 }
 
 bool Data::Manager::hasEntry( const std::string &name ) {
-    bool is_found;
-
-    // thread_lock.lock();
-
-    is_found = entries.find( name ) != entries.end();
-
-    // thread_lock.unlock();
+    std::lock_guard<std::mutex> guard( thread_lock );
 
-    return is_found;
+    return entries.find( name ) != entries.end();
 }
 
 Data::Manager::IFFEntry Data::Manager::getIFFEntry( const std::string &name ) {
-    IFFEntry entry;
+    std::lock_guard<std::mutex> guard( thread_lock );
 
-    // thread_lock.lock();
-
-    entry = entries[ name ];
-
-    // thread_lock.unlock();
-
-    return entry;
+    return entries[ name ];
 }
 
 bool Data::Manager::setIFFEntry( const std::string &name, const IFFEntry &entry ) {
-    // thread_lock.lock();
+    std::lock_guard<std::mutex> guard( thread_lock );
 
     entries[ name ] = IFFEntryStorage( entry );
 
-    // thread_lock.unlock();
-
     return true;
 }
 
@@ -500,7 +506,7 @@ void Data::Manager::autoSetEntries( const std::filesystem::path &base_path, Plat
 }
 
 void Data::Manager::togglePlatform( Platform platform, bool can_be_loaded ) {
-    // thread_lock.lock();
+    std::lock_guard<std::mutex> guard( thread_lock );
 
     switch( platform ) {
         case MACINTOSH:
@@ -518,14 +524,209 @@ void Data::Manager::togglePlatform( Platform platform, bool can_be_loaded ) {
             platforms_to_support.toggle[ Platform::WINDOWS ]     = can_be_loaded;
     }
 
-    // thread_lock.unlock();
+    // The prefetches of a platform that is no longer supported would never be taken.
+    if( !can_be_loaded ) {
+        for( auto it = prefetches.begin(); it != prefetches.end(); ) {
+            if( !platforms_to_support.toggle[ (*it).platform ] )
+                it = discardPrefetch( it );
+            else
+                it++;
+        }
+    }
+}
+
+Data::Mission::IFF* Data::Manager::takePrefetch( const std::string &name, Platform platform ) {
+    for( auto it = prefetches.begin(); it != prefetches.end(); it++ ) {
+        if( (*it).name == name && (*it).platform == platform ) {
+            std::future<Mission::IFF*> iff = std::move( (*it).iff );
+
+            prefetches.erase( it );
+
+            // The entry is loaded with the raised importance now, so dropping the other prefetches of it must not lower it.
+            for( auto &other : prefetches ) {
+                if( other.name == name )
+                    other.raised_importance = false;
+            }
+
+            // This waits for the background thread if it is still opening the file.
+            return iff.get();
+        }
+    }
+
+    return nullptr;
+}
+
+std::vector<Data::Manager::Prefetch>::iterator Data::Manager::discardPrefetch( std::vector<Prefetch>::iterator it ) {
+    (*it).cancel_p->store( true );
+
+    if( (*it).raised_importance ) {
+        auto other_it = std::find_if( prefetches.begin(), prefetches.end(), [it]( const Prefetch &other ) {
+            return other.name == (*it).name && &other != &(*it);
+        } );
+
+        // The importance stays raised while another prefetch of the entry is running.
+        if( other_it != prefetches.end() )
+            (*other_it).raised_importance = true;
+        else {
+            auto entry_it = entries.find( (*it).name );
+
+            if( entry_it != entries.end() && (*entry_it).second.importance == CACHE_NEXT )
+                (*entry_it).second.importance = NOT_NEEDED;
+        }
+    }
+
+    dropped_prefetches.push_back( std::move( (*it).iff ) );
+
+    return prefetches.erase( it );
+}
+
+void Data::Manager::collectDroppedPrefetches( bool wait ) {
+    for( auto it = dropped_prefetches.begin(); it != dropped_prefetches.end(); ) {
+        if( wait || (*it).wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready ) {
+            try {
+                delete (*it).get();
+            }
+            catch( ... ) {
+                // The file is being discarded anyways.
+            }
+
+            it = dropped_prefetches.erase( it );
+        }
+        else
+            it++;
+    }
+}
+
+bool Data::Manager::prefetch( const std::string &name, Platform platform ) {
+    if( platform >= Platform::ALL )
+        return false;
+
+    std::lock_guard<std::mutex> guard( thread_lock );
+
+    collectDroppedPrefetches( false );
+
+    auto entry_it = entries.find( name );
+
+    if( entry_it == entries.end() || (*entry_it).second.getIFF( platform ) != nullptr )
+        return false;
+
+    for( const auto &i : prefetches ) {
+        if( i.name == name && i.platform == platform )
+            return true; // It is already being prefetched.
+    }
+
+    const bool raised_importance = (*entry_it).second.importance == NOT_NEEDED;
+
+    if( raised_importance )
+        (*entry_it).second.importance = CACHE_NEXT;
+
+    Mission::IFF::OpenSettings prefetch_open_settings = open_settings;
+
+    // Leave half of the cores to the mission that is currently being played.
+    prefetch_open_settings.parse_thread_amount = std::max( 1u, Utilities::Parallel::getThreadAmount( 0 ) / 2 );
+
+    const std::filesystem::path path = (*entry_it).second.getPath( platform );
+
+    Prefetch prefetch;
+    prefetch.name = name;
+    prefetch.platform = platform;
+    prefetch.raised_importance = raised_importance;
+    prefetch.cancel_p = std::make_shared<std::atomic<bool>>( false );
+    prefetch.iff = std::async( std::launch::async, [path, prefetch_open_settings, cancel_p = prefetch.cancel_p]() mutable -> Mission::IFF* {
+        std::unique_ptr<Mission::IFF> iff_p = std::make_unique<Mission::IFF>();
+
+        prefetch_open_settings.cancel_r = cancel_p.get();
+
+        if( iff_p->open( path, prefetch_open_settings ) == 1 && !cancel_p->load() )
+            return iff_p.release();
+        else
+            return nullptr;
+    } );
+
+    prefetches.push_back( std::move( prefetch ) );
+
+    return true;
+}
+
+bool Data::Manager::dropPrefetch( const std::string &name, Platform platform ) {
+    std::lock_guard<std::mutex> guard( thread_lock );
+
+    collectDroppedPrefetches( false );
+
+    for( auto it = prefetches.begin(); it != prefetches.end(); it++ ) {
+        if( (*it).name == name && (*it).platform == platform ) {
+            discardPrefetch( it );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Data::Manager::cancelPrefetches() {
+    std::lock_guard<std::mutex> guard( thread_lock );
+
+    while( !prefetches.empty() )
+        discardPrefetch( prefetches.begin() );
+
+    collectDroppedPrefetches( true );
+}
+
+void Data::Manager::loadJobs( const std::vector<LoadJob> &jobs, unsigned core_amount ) {
+    auto global_it = entries.find( global );
+    IFFEntryStorage *global_entry_r = global_it != entries.end() ? &(*global_it).second : nullptr;
+
+    // The global IFF files are loaded first, so the other IFF files could copy the resources that they have in common with them.
+    std::vector<LoadJob> global_jobs;
+    std::vector<LoadJob> other_jobs;
+
+    for( const LoadJob &job : jobs ) {
+        if( job.entry_r == global_entry_r )
+            global_jobs.push_back( job );
+        else
+            other_jobs.push_back( job );
+    }
+
+    for( const std::vector<LoadJob> *group_r : { &global_jobs, &other_jobs } ) {
+        const std::vector<LoadJob> &group = *group_r;
+        const unsigned total_amount  = Utilities::Parallel::getThreadAmount( core_amount );
+        const unsigned thread_amount = std::min( static_cast<size_t>( total_amount ), std::max( group.size(), static_cast<size_t>( 1 ) ) );
+
+        Mission::IFF::OpenSettings job_open_settings = open_settings;
+
+        // Share the cores given to this call between the IFF files being loaded, so the parsing threads do not oversubscribe the cpu.
+        job_open_settings.parse_thread_amount = std::max( 1u, total_amount / thread_amount );
+
+        Utilities::Parallel::forEach( group.size(), thread_amount, [&group, &job_open_settings, global_entry_r]( size_t index ) {
+            Mission::IFF::OpenSettings settings = job_open_settings;
+
+            if( group[ index ].entry_r != global_entry_r && global_entry_r != nullptr )
+                settings.shared_iff_r = global_entry_r->getIFF( group[ index ].platform );
+
+            group[ index ].entry_r->load( group[ index ].platform, settings );
+        } );
+    }
 }
 
 int Data::Manager::setLoad( Importance importance, unsigned core_amount ) {
-    int number_loaded = 0;
     Platform platforms[] = { Platform::MACINTOSH, Platform::PLAYSTATION, Platform::WINDOWS };
+    std::vector<LoadJob> jobs;
+    int number_prefetched = 0;
+
+    // IFF::open could throw, so the lock must be released by the guard.
+    std::lock_guard<std::mutex> guard( thread_lock );
 
-    // thread_lock.lock();
+    // The prefetches that this call would not load are stale, so they should not keep their threads and their IFF files.
+    for( auto it = prefetches.begin(); it != prefetches.end(); ) {
+        auto entry_it = entries.find( (*it).name );
+
+        if( !platforms_to_support.toggle[ (*it).platform ] || entry_it == entries.end() || (*entry_it).second.importance > importance )
+            it = discardPrefetch( it );
+        else
+            it++;
+    }
+
+    collectDroppedPrefetches( false );
 
     for( auto &p : platforms ) {
         if( !platforms_to_support.toggle[ p ] ) {
@@ -540,8 +741,15 @@ int Data::Manager::setLoad( Importance importance, unsigned core_amount ) {
             for( auto &i : entries ) {
                 if( i.second.importance <= importance ) {
                     if( i.second.getIFF( p ) == nullptr ) {
-                        i.second.load( p );
-                        number_loaded++;
+                        // If the prefetch failed, then the IFF is opened again to get the same errors as a normal load.
+                        Mission::IFF *prefetched_iff_p = takePrefetch( i.first, p );
+
+                        if( prefetched_iff_p != nullptr ) {
+                            i.second.setIFF( p, prefetched_iff_p );
+                            number_prefetched++;
+                        }
+                        else
+                            jobs.push_back( { &i.second, p } );
                     }
                 }
                 else
@@ -551,33 +759,33 @@ int Data::Manager::setLoad( Importance importance, unsigned core_amount ) {
         }
     }
 
+    // The unloading is done first, so the memory is freed before the loading starts.
+    loadJobs( jobs, core_amount );
+
     // After loading and unloading the resources are done.
     currently_loaded_platforms = platforms_to_support;
 
-    // thread_lock.unlock();
-
-    return number_loaded;
+    return jobs.size() + number_prefetched;
 }
 
 int Data::Manager::reload( unsigned core_amount ) {
-    int number_reload = 0;
     Platform platforms[] = { Platform::MACINTOSH, Platform::PLAYSTATION, Platform::WINDOWS };
+    std::vector<LoadJob> jobs;
 
-    // thread_lock.lock();
+    std::lock_guard<std::mutex> guard( thread_lock );
 
     for( auto &i : entries ) {
         for( auto &d : platforms ) {
             if( i.second.getIFF( d ) != nullptr ) {
                 i.second.unload( d );
-                i.second.load( d );
-                number_reload++;
+                jobs.push_back( { &i.second, d } );
             }
         }
     }
 
-   //  thread_lock.unlock();
+    loadJobs( jobs, core_amount );
 
-    return number_reload;
+    return jobs.size();
 }
 
 void Data::Manager::listIDs( std::ostream &stream ) {
@@ -3,8 +3,10 @@
 
 #include "Mission/IFF.h"
 
-// #include <thread>
-// #include <mutex>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <filesystem>
 #include <string>
 #include <map>
@@ -164,20 +166,83 @@ public:
         IFFEntryStorage( const IFFEntry & );
         ~IFFEntryStorage();
 
-        bool load( Platform platform );
+        bool load( Platform platform, const Mission::IFF::OpenSettings &open_settings = Mission::IFF::DEFAULT_OPEN_SETTINGS );
         bool unload( Platform platform );
+
+        /**
+         * This gives an already opened IFF file to this entry.
+         * @param platform The platform of the IFF file.
+         * @param iff_p The opened IFF file. This entry would own it. If this entry already has an IFF for the platform then iff_p gets deleted.
+         * @return True if iff_p is now used by this entry.
+         */
+        bool setIFF( Platform platform, Mission::IFF *iff_p );
     };
 protected:
-    // std::mutex thread_lock;
+    std::mutex thread_lock;
 
     std::map< std::string, IFFEntryStorage > entries;
 
+    Mission::IFF::OpenSettings open_settings;
+
     // The enabled_platforms and current_importance_to_load checks which resources can be loaded.
     struct {
         bool toggle[ Platform::ALL ];
     } currently_loaded_platforms, platforms_to_support;
 
     Importance current_importance_to_load;
+
+    struct LoadJob {
+        IFFEntryStorage *entry_r;
+        Platform platform;
+    };
+
+    // These IFF files are being opened on background threads, and they are given to their entries once setLoad needs them.
+    struct Prefetch {
+        std::string name;
+        Platform platform;
+        bool raised_importance; // If true, this prefetch raised the importance of its entry from NOT_NEEDED to CACHE_NEXT.
+        std::shared_ptr<std::atomic<bool>> cancel_p;
+        std::future<Mission::IFF*> iff;
+    };
+    std::vector<Prefetch> prefetches;
+
+    // These prefetches are no longer wanted. They have been told to stop, and their IFF files get deleted once their threads are done.
+    std::vector<std::future<Mission::IFF*>> dropped_prefetches;
+
+    /**
+     * This tells the prefetch to stop and moves it to dropped_prefetches without waiting for it.
+     * @note If the prefetch raised the importance of its entry, and no other prefetch of the entry is left, then the importance goes back to NOT_NEEDED.
+     * @warning thread_lock must be locked before calling this.
+     * @param it The prefetch to drop.
+     * @return The prefetch after the dropped one.
+     */
+    std::vector<Prefetch>::iterator discardPrefetch( std::vector<Prefetch>::iterator it );
+
+    /**
+     * This deletes the IFF files of the dropped prefetches that are done.
+     * @warning thread_lock must be locked before calling this.
+     * @param wait If true, this waits for every dropped prefetch to be done.
+     */
+    void collectDroppedPrefetches( bool wait );
+
+    /**
+     * This waits for the prefetch of the entry if there is one.
+     * @warning thread_lock must be locked before calling this.
+     * @param name The IFF entry id.
+     * @param platform The platform of the IFF.
+     * @return The opened IFF file or nullptr if there is no prefetch or the prefetch could not open the file. The caller owns it.
+     */
+    Mission::IFF* takePrefetch( const std::string &name, Platform platform );
+
+    /**
+     * This loads every job. Each job has its own IFF file, so the jobs are loaded at the same time.
+     * @note The global IFF files are loaded before the others, so the others could share their resources.
+     * @note Each IFF file gets core_amount divided by the amount of IFF files loaded at once as its parse threads, and at least one.
+     * @warning thread_lock must be locked before calling this.
+     * @param jobs The entries and the platforms to load.
+     * @param core_amount The maximum amount of threads to use. 0 means that every core of the cpu will be used.
+     */
+    void loadJobs( const std::vector<LoadJob> &jobs, unsigned core_amount );
 public:
     Manager();
     virtual ~Manager();
@@ -212,6 +277,18 @@ public:
      */
     void autoSetEntries( const std::filesystem::path &base_path, Platform platform = Platform::ALL );
 
+    /**
+     * This sets how the IFF files would be opened by setLoad and reload.
+     * @note The manager memory maps the IFF files by default.
+     * @param open_settings The settings given to every IFF::open call.
+     */
+    void setOpenSettings( const Mission::IFF::OpenSettings &open_settings ) { this->open_settings = open_settings; }
+
+    /**
+     * @return The settings given to every IFF::open call.
+     */
+    const Mission::IFF::OpenSettings& getOpenSettings() const { return this->open_settings; }
+
     /**
      * This enables which platform can be loaded.
      * @param platform This is the platfrom that is being toggled on or off.
@@ -227,6 +304,30 @@ public:
      */
     int setLoad( Importance importance, unsigned core_amount = 1 );
 
+    /**
+     * This starts opening the IFF file of the entry on a background thread, so a later setLoad call does not need to wait for all of it.
+     * @note If the entry has the importance NOT_NEEDED then it is set to CACHE_NEXT. It is set back if the prefetch gets dropped before setLoad takes it.
+     * @note A setLoad call that needs this entry would take the IFF file from the background thread even if it is not done yet.
+     * @param name IFF entry id which can be "griffith-park"
+     * @param platform The platform to prefetch. It cannot be Platform::ALL.
+     * @return True if the prefetch has started or is already running. False if the entry does not exist or the IFF is already loaded.
+     */
+    bool prefetch( const std::string &name, Platform platform );
+
+    /**
+     * This stops the prefetch of the entry without waiting for it. The IFF file it opens gets discarded.
+     * @note setLoad drops the prefetches that it would not load, and togglePlatform drops the prefetches of a disabled platform.
+     * @param name IFF entry id which can be "griffith-park"
+     * @param platform The platform of the prefetch.
+     * @return True if there was a prefetch to drop.
+     */
+    bool dropPrefetch( const std::string &name, Platform platform );
+
+    /**
+     * This waits for every prefetch to finish and discards the IFF files they opened.
+     */
+    void cancelPrefetches();
+
     /**
      * This sets every resource that is loaded to reload.
      * @param core_amount This is the amount of cpu cores or threads that this method will call. This method will wait until every thread is done. 0 means that every core of the cpu will be used.
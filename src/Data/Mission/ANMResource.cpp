@@ -177,8 +177,7 @@ bool Data::Mission::ANMResource::parse( const ParseSettings &settings ) {
 
                     if( scanline_raw_bytes_p != nullptr )
                     {
-                        for( size_t i = 0; i < buffer_size; i++ )
-                            this->scanline_raw_bytes_p[ i ] = reader.readU8();
+                        reader.readU8Array( this->scanline_raw_bytes_p, buffer_size );
 
                         return true;
                     }
@@ -286,7 +285,7 @@ void Data::Mission::ANMResource::setColorPalette( Utilities::ColorPalette &rgba_
 }
 
 int Data::Mission::ANMResource::write( const std::filesystem::path& file_path, const Data::Mission::IFFOptions &iff_options ) const {
-    Utilities::ImageFormat::Chooser chooser;
+    Utilities::ImageFormat::Chooser chooser( iff_options.png_compression_level, iff_options.thread_amount );
 
     // Check if there is data to export.
     if( getTotalScanlines() != 0 )
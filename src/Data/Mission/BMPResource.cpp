@@ -157,8 +157,7 @@ bool Data::Mission::BMPResource::parse( const ParseSettings &settings ) {
                 // This seems to be all 8 bit data in 4 lists each containing 0x100 bytes.
                 // In second thought
                 // I could be that this is simply a big list of 0x400 unsigned bytes and the 16-bit data is simply going to scale down.
-                for( unsigned int i = 0; i < LOOKUP_DATA_AMOUNT; i++ )
-                    lookUpData[ i ] = lkup_reader.readU8();
+                lkup_reader.readU8Array( lookUpData, LOOKUP_DATA_AMOUNT );
                 
                 // Playstation is disabled.
                 isPSX = false;
@@ -271,7 +270,11 @@ Data::Mission::Resource * Data::Mission::BMPResource::duplicate() const {
 }
 int Data::Mission::BMPResource::write( const std::filesystem::path& file_path, const Data::Mission::IFFOptions &iff_options ) const {
     if( iff_options.bmp.shouldWrite( iff_options.enable_global_dry_default ) && getImage() != nullptr ) {
-        if( this->format_p != nullptr ) {
+        // The writer of the parse does not have the options of the export.
+        Utilities::ImageFormat::Chooser chooser( iff_options.png_compression_level, iff_options.thread_amount );
+        Utilities::ImageFormat::ImageFormat *format_r = chooser.getWriterReference( Utilities::PixelFormatColor_R8G8B8A8::linear );
+
+        if( format_r != nullptr ) {
             Utilities::Buffer buffer;
             int state;
             
@@ -286,8 +289,8 @@ int Data::Mission::BMPResource::write( const std::filesystem::path& file_path, c
                     }
                 }
                 
-                state = this->format_p->write( image_convert, buffer );
-                buffer.write( this->format_p->appendExtension( file_path ) );
+                state = format_r->write( image_convert, buffer );
+                buffer.write( format_r->appendExtension( file_path ) );
             }
 
             buffer.set( nullptr, 0 ); // This effectively clears the buffer.
@@ -306,12 +309,12 @@ int Data::Mission::BMPResource::write( const std::filesystem::path& file_path, c
                 
                 auto palette = Utilities::ImagePalette2D( rgba_palette );
                 
-                state = this->format_p->write( palette, buffer );
+                state = format_r->write( palette, buffer );
 
                 std::filesystem::path full_file_path = file_path;
                 full_file_path +=  "_paletted";
 
-                buffer.write( this->format_p->appendExtension( full_file_path ) );
+                buffer.write( format_r->appendExtension( full_file_path ) );
             }
 
             return state;
@@ -0,0 +1,119 @@
+#include "ExportManifest.h"
+
+#include "../../Utilities/Buffer.h"
+
+namespace {
+
+// which is { 'F', 'C', 'E', 'M' } or "FCEM"
+const uint32_t MANIFEST_TAG = 0x4643454D;
+
+void addString( Utilities::Buffer &buffer, const std::string &text ) {
+    buffer.addU32( text.size(), Utilities::Buffer::Endian::LITTLE );
+    buffer.add( reinterpret_cast<const uint8_t*>( text.data() ), text.size() );
+}
+
+std::string readString( Utilities::Buffer::Reader &reader ) {
+    const uint32_t length = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+
+    const uint8_t *const text_r = reader.readSpan( length );
+
+    return std::string( reinterpret_cast<const char*>( text_r ), length );
+}
+
+}
+
+namespace Data::Mission {
+
+const std::filesystem::path ExportManifest::FILE_NAME = "export.fcmanifest";
+
+std::filesystem::path ExportManifest::getManifestPath( const std::filesystem::path &folder_path ) {
+    return folder_path / FILE_NAME;
+}
+
+bool ExportManifest::isUpToDate( const std::filesystem::path &folder_path, const std::string &name, uint64_t content_hash, uint64_t options_digest ) const {
+    // A hash of zero means that the resource has no data to hash.
+    if( content_hash == 0 )
+        return false;
+
+    auto entry = entries.find( name );
+
+    if( entry == entries.end() )
+        return false;
+
+    if( entry->second.content_hash != content_hash || entry->second.options_digest != options_digest )
+        return false;
+
+    std::error_code error_code;
+
+    for( const std::string &output_name : entry->second.output_names ) {
+        if( !std::filesystem::is_regular_file( folder_path / output_name, error_code ) )
+            return false;
+    }
+
+    return true;
+}
+
+bool ExportManifest::read( const std::filesystem::path &manifest_path ) {
+    entries.clear();
+
+    Utilities::Buffer buffer;
+
+    if( !buffer.read( manifest_path ) )
+        return false;
+
+    auto reader = buffer.getReader();
+
+    try {
+        if( reader.readU32( Utilities::Buffer::Endian::LITTLE ) != MANIFEST_TAG )
+            return false;
+
+        if( reader.readU32( Utilities::Buffer::Endian::LITTLE ) != VERSION )
+            return false;
+
+        const uint32_t entry_amount = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+
+        for( uint32_t e = 0; e < entry_amount; e++ ) {
+            const std::string name = readString( reader );
+            Entry entry;
+
+            entry.content_hash   = reader.readU64( Utilities::Buffer::Endian::LITTLE );
+            entry.options_digest = reader.readU64( Utilities::Buffer::Endian::LITTLE );
+
+            const uint32_t output_amount = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+
+            for( uint32_t i = 0; i < output_amount; i++ )
+                entry.output_names.push_back( readString( reader ) );
+
+            entries[ name ] = entry;
+        }
+    }
+    catch( const Utilities::Buffer::BufferOutOfBounds & ) {
+        // The manifest file is truncated.
+        entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool ExportManifest::write( const std::filesystem::path &manifest_path ) const {
+    Utilities::Buffer buffer;
+
+    buffer.addU32( MANIFEST_TAG,   Utilities::Buffer::Endian::LITTLE );
+    buffer.addU32( VERSION,        Utilities::Buffer::Endian::LITTLE );
+    buffer.addU32( entries.size(), Utilities::Buffer::Endian::LITTLE );
+
+    for( const auto &entry : entries ) {
+        addString( buffer, entry.first );
+        buffer.addU64( entry.second.content_hash,   Utilities::Buffer::Endian::LITTLE );
+        buffer.addU64( entry.second.options_digest, Utilities::Buffer::Endian::LITTLE );
+        buffer.addU32( entry.second.output_names.size(), Utilities::Buffer::Endian::LITTLE );
+
+        for( const std::string &output_name : entry.second.output_names )
+            addString( buffer, output_name );
+    }
+
+    return buffer.write( manifest_path );
+}
+
+}
@@ -0,0 +1,66 @@
+#ifndef DATA_MISSION_EXPORT_MANIFEST_HEADER
+#define DATA_MISSION_EXPORT_MANIFEST_HEADER
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Data::Mission {
+
+/**
+ * This is the record of an export folder that lets IFF::exportAllResources skip the resources that did not change.
+ *
+ * Every resource that got exported has the hash of its content, the digest of the options and the files it wrote.
+ * A resource is up to date if the hash and the digest match and all of its files are still in the folder.
+ */
+class ExportManifest {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static const std::filesystem::path FILE_NAME;
+
+    struct Entry {
+        uint64_t content_hash;
+        uint64_t options_digest;
+        std::vector<std::string> output_names; // The file names that the resource wrote into the folder.
+    };
+
+    // The key is the name of the resource without the extension, like "wav_1".
+    std::map<std::string, Entry> entries;
+
+    /**
+     * @param folder_path The export folder.
+     * @return The path of the manifest file inside the folder.
+     */
+    static std::filesystem::path getManifestPath( const std::filesystem::path &folder_path );
+
+    /**
+     * This checks if a resource would write the same files that are already in the folder.
+     * @note This method only reads, so it can be called from multiple threads.
+     * @param folder_path The export folder.
+     * @param name The name of the resource without the extension.
+     * @param content_hash The hash of the resource with the hashes of the resources it depends on.
+     * @param options_digest The digest of the export options.
+     * @return True if the resource does not need to be exported again.
+     */
+    bool isUpToDate( const std::filesystem::path &folder_path, const std::string &name, uint64_t content_hash, uint64_t options_digest ) const;
+
+    /**
+     * This reads the manifest file. A missing or broken manifest file gives an empty manifest, so everything gets exported.
+     * @param manifest_path The path of the manifest file.
+     * @return True if the manifest got read.
+     */
+    bool read( const std::filesystem::path &manifest_path );
+
+    /**
+     * This writes the manifest file.
+     * @param manifest_path The path of the manifest file.
+     * @return True if the manifest got written.
+     */
+    bool write( const std::filesystem::path &manifest_path ) const;
+};
+
+}
+
+#endif // DATA_MISSION_EXPORT_MANIFEST_HEADER
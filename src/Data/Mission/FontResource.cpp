@@ -289,7 +289,7 @@ Utilities::Image2D *const Data::Mission::FontResource::getImage() const {
 
 int Data::Mission::FontResource::write( const std::filesystem::path& file_path, const Data::Mission::IFFOptions &iff_options ) const {
     std::ofstream resource;
-    Utilities::ImageFormat::Chooser chooser;
+    Utilities::ImageFormat::Chooser chooser( iff_options.png_compression_level, iff_options.thread_amount );
 
     if( iff_options.font.shouldWrite( iff_options.enable_global_dry_default ) ) {
         std::filesystem::path full_file_path = file_path;
@@ -24,16 +24,23 @@
 #include "VAGMResource.h"
 #include "VKBResource.h"
 #include "RPNSResource.h"
+#include "IFFIndex.h"
+#include "ExportManifest.h"
 
 #include "ACT/Unknown.h"
 #include "ACT/SkyCaptain.h"
 
 #include "../../Utilities/Buffer.h"
+#include "../../Utilities/MappedFile.h"
+#include "../../Utilities/Parallel.h"
 
 #include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace {
@@ -148,6 +155,10 @@ namespace {
     };
 }
 
+const Data::Mission::IFF::OpenSettings Data::Mission::IFF::DEFAULT_OPEN_SETTINGS = Data::Mission::IFF::OpenSettings();
+
+Data::Mission::IFF::OpenSettings::OpenSettings() : memory_map( false ), parse_thread_amount( 1 ), lazy_parse( false ), use_index_cache( false ), shared_iff_r( nullptr ), cancel_r( nullptr ) {}
+
 bool Data::Mission::IFF::compareFunction( const Data::Mission::Resource *const l_operand, const Data::Mission::Resource *const r_operand ) {
     return ( *l_operand < *r_operand );
 }
@@ -256,16 +267,119 @@ std::string Data::Mission::IFF::getName() const {
 }
 
 namespace {
+    /**
+     * This places bytes in the arena, and makes the buffer a view of them.
+     * @param buffer The buffer that would reference the bytes.
+     * @param arena_p The arena to allocate the bytes from.
+     * @param byte_amount The amount of bytes to allocate.
+     * @return The bytes to fill in.
+     */
+    uint8_t* allocateInArena( Utilities::Buffer &buffer, const std::shared_ptr<std::pmr::monotonic_buffer_resource> &arena_p, size_t byte_amount ) {
+        uint8_t *const bytes_r = static_cast<uint8_t*>( arena_p->allocate( std::max<size_t>( byte_amount, 1 ), 1 ) );
+
+        buffer.setView( arena_p, bytes_r, byte_amount );
+
+        return bytes_r;
+    }
+
     class UnidentifiedResource : public Data::Mission::UnkResource {
     protected:
         static const std::string ext;
 
+        std::shared_ptr<const Utilities::MappedFile> mapped_file_p;
+        std::shared_ptr<std::pmr::monotonic_buffer_resource> arena_p;
+        Data::Mission::IFFIndex::Span header_span;
+        std::vector<Data::Mission::IFFIndex::Span> spans;
+
+        // In stream mode the data gets appended to these arena bytes.
+        uint8_t *arena_data_r;
+        size_t arena_capacity;
+
+        void assembleMappedData() {
+            data = std::make_unique<Utilities::Buffer>();
+
+            if( spans.size() == 1 ) {
+                // The resource is in one SDAT chunk, so it can reference the mapping directly.
+                data->setView( mapped_file_p, mapped_file_p->getData() + spans[0].offset, spans[0].size );
+            }
+            else {
+                // The resource got split across SDAT chunks, so it needs to be reassembled.
+                size_t total_size = 0;
+
+                for( const auto &span : spans )
+                    total_size += span.size;
+
+                uint8_t *bytes_r = allocateInArena( *data, arena_p, total_size );
+
+                for( const auto &span : spans ) {
+                    std::memcpy( bytes_r, mapped_file_p->getData() + span.offset, span.size );
+                    bytes_r += span.size;
+                }
+            }
+        }
+
     public:
-        UnidentifiedResource() : Data::Mission::UnkResource( 0, ext ) {}
+        UnidentifiedResource() : Data::Mission::UnkResource( 0, ext ), header_span( { 0, 0 } ), arena_data_r( nullptr ), arena_capacity( 0 ) {}
+
+        void setMappedFile( std::shared_ptr<const Utilities::MappedFile> mapped_file_p ) { this->mapped_file_p = mapped_file_p; }
+        void setArena( std::shared_ptr<std::pmr::monotonic_buffer_resource> arena_p ) { this->arena_p = arena_p; }
+
+        /**
+         * This starts the data of a new resource in stream mode.
+         * @param capacity The amount of bytes that the resource is expected to have.
+         */
+        void startArenaData( size_t capacity ) {
+            data = std::make_unique<Utilities::Buffer>();
+            arena_data_r = static_cast<uint8_t*>( arena_p->allocate( std::max<size_t>( capacity, 1 ), 1 ) );
+            arena_capacity = capacity;
+        }
 
-        Data::Mission::Resource* newResource( const Data::Mission::Resource::ParseSettings &default_settings, std::unordered_set<std::filesystem::path> &filenames, unsigned index_value, Utilities::Logger::Log& debug_log, Utilities::Logger::Log& error_log ) {
+        /**
+         * This appends the bytes of the reader to the data in stream mode.
+         * @param reader The reader to read the bytes from.
+         * @param byte_amount The amount of bytes to append.
+         */
+        void addArenaData( Utilities::Buffer::Reader &reader, size_t byte_amount ) {
+            const size_t data_size = data->getReader().totalSize();
+
+            if( (data->isView() || data_size == 0) && byte_amount <= arena_capacity - data_size ) {
+                reader.readU8Array( arena_data_r + data_size, byte_amount );
+                data->setView( arena_p, arena_data_r, data_size + byte_amount );
+            }
+            else {
+                // The resource is bigger than its header claims, so it gets copied out of the arena.
+                data->add( reader.readSpan( byte_amount ), byte_amount );
+            }
+        }
+
+        /**
+         * This starts the spans of a new resource. In memory map mode, this also starts a new resource without copying any bytes.
+         * @param header_span The SHDR bytes past the known header fields.
+         */
+        void startSpans( const Data::Mission::IFFIndex::Span &header_span ) {
+            this->header_span = header_span;
+            spans.clear();
+
+            if( mapped_file_p != nullptr ) {
+                data = nullptr;
+                setHeaderSize( 0 );
+            }
+        }
+
+        void addSpan( const Data::Mission::IFFIndex::Span &span ) { spans.push_back( span ); }
+
+        const Data::Mission::IFFIndex::Span& getHeaderSpan() const { return header_span; }
+        const std::vector<Data::Mission::IFFIndex::Span>& getSpans() const { return spans; }
+
+        /**
+         * This makes the resource from the gathered chunks. The resource would not be parsed yet.
+         */
+        Data::Mission::Resource* newResource( std::unordered_set<std::filesystem::path> &filenames, unsigned index_value, Utilities::Logger::Log& debug_log, Utilities::Logger::Log& error_log ) {
             Resource *new_resource_p;
 
+            if( mapped_file_p != nullptr )
+                assembleMappedData();
+
             // Find a resource
             auto file_type_it = file_type_list.find( this->getResourceTagID() );
 
@@ -290,11 +404,6 @@ namespace {
 
             new_resource_p->setMemory( data.release() );
 
-            new_resource_p->parse( default_settings );
-
-            // TODO Add option to discard memory once loaded.
-            // new_resource_p->setMemory( nullptr );
-
             // Check for naming conflicts
             const std::filesystem::path file_name = new_resource_p->getFullName( new_resource_p->getResourceID() );
 
@@ -309,8 +418,6 @@ namespace {
 
             return new_resource_p;
         }
-
-        std::unique_ptr<Utilities::Buffer>& getDataReference() { return data; }
     };
 
     const std::string UnidentifiedResource::ext = "unidentified";
@@ -323,14 +430,358 @@ namespace {
         else
             return 0;
     }
+
+    Data::Mission::IFFIndex::Record makeIndexRecord( const Data::Mission::Resource &resource, Data::Mission::IFFIndex::Kind kind, uint32_t resource_id, const Data::Mission::IFFIndex::Span &header_span, const std::vector<Data::Mission::IFFIndex::Span> &spans ) {
+        Data::Mission::IFFIndex::Record record;
+
+        record.kind             = kind;
+        record.tag              = resource.getResourceTagID();
+        record.resource_id      = resource_id;
+        record.offset           = resource.getOffset();
+        record.mis_index_number = resource.getMisIndexNumber();
+        record.index_number     = resource.getIndexNumber();
+
+        for( size_t i = 0; i < Data::Mission::Resource::RPNS_OFFSET_AMOUNT; i++ )
+            record.rpns_offsets[ i ] = resource.getRPNSOffset( i );
+
+        for( size_t i = 0; i < Data::Mission::Resource::CODE_AMOUNT; i++ )
+            record.code_sizes[ i ] = resource.getCodeAmount( i );
+
+        record.swvr_entry  = resource.getSWVREntry();
+        record.header_span = header_span;
+        record.spans       = spans;
+
+        return record;
+    }
+
+    /**
+     * @return True if the resource gets linked to other resources at the end of IFF::open.
+     */
+    bool isLinkedResource( const Data::Mission::Resource &resource ) {
+        const uint32_t TAG = resource.getResourceTagID();
+
+        return TAG == Data::Mission::ACTResource::IDENTIFIER_TAG ||
+               TAG == Data::Mission::ACTResource::SAC_IDENTI_TAG ||
+               TAG == Data::Mission::BMPResource::IDENTIFIER_TAG ||
+               TAG == Data::Mission::NetResource::IDENTIFIER_TAG ||
+               TAG == Data::Mission::ObjResource::IDENTIFIER_TAG ||
+               TAG == Data::Mission::PTCResource::IDENTIFIER_TAG ||
+               TAG == Data::Mission::TilResource::IDENTIFIER_TAG ||
+               TAG == Data::Mission::TOSResource::IDENTIFIER_TAG;
+    }
+
+    /**
+     * This parses the resources, and then finishes the resources that depend on other resources.
+     * @param lazy_parse If true, only the resources needed to link the other resources are parsed now.
+     * @param cancel_r If not nullptr and it becomes true, the parsing stops and the resources are not linked.
+     */
+    void parseResources( Data::Mission::IFF &iff, std::vector<Data::Mission::Resource*> &unparsed_resources_r, const Data::Mission::Resource::ParseSettings &default_settings, unsigned thread_amount, bool lazy_parse, const std::atomic<bool> *cancel_r, Utilities::Logger::Log &error_log ) {
+        std::vector<Data::Mission::Resource*> parse_now_r;
+
+        parse_now_r.reserve( unparsed_resources_r.size() );
+
+        for( Data::Mission::Resource *resource_r : unparsed_resources_r ) {
+            resource_r->deferParse( default_settings );
+
+            if( !lazy_parse || isLinkedResource( *resource_r ) )
+                parse_now_r.push_back( resource_r );
+        }
+
+        // Every resource only reads its own data while parsing, so they can be parsed in parallel.
+        Utilities::Parallel::forEach( parse_now_r.size(), thread_amount, [&]( size_t index ) {
+            if( cancel_r == nullptr || !cancel_r->load( std::memory_order_relaxed ) )
+                parse_now_r[ index ]->ensureParsed();
+        } );
+
+        // The resources that were skipped are still deferred, so they would parse on their first access.
+        if( cancel_r != nullptr && cancel_r->load() )
+            return;
+
+        // The resources that depend on other resources are done last.
+        Data::Accessor accessor;
+        accessor.load( iff );
+
+        const auto &ptc_pointers_r = accessor.getAllPTC();
+
+        if( ptc_pointers_r.size() != 0 ) {
+            if( !ptc_pointers_r[0]->makeTiles( accessor.getAllTIL() ) )
+            {
+                error_log.output << "PTC resource is found, but there are no Til resources.\n";
+            }
+        }
+        else
+        if( iff.getResource( Data::Mission::TilResource::IDENTIFIER_TAG ) != nullptr )
+            error_log.output << "PTC resource is not found, but the Til resources are in the file.\n";
+
+        // After makeTiles, the nodes and the textures of the models and the sections are independent of each other.
+        const auto &textures_from_prime = accessor.getAllBMP();
+
+        // TODO add optional global file.
+        // textures.insert( textures.end(), textures.begin(), textures.end() );
+
+        std::vector<Data::Mission::NetResource*> nets_r;
+
+        if( ptc_pointers_r.size() != 0 )
+            nets_r = accessor.getAllNET();
+
+        const auto &objects = accessor.getAllOBJ();
+        const auto &sections = accessor.getAllTIL();
+        std::vector<uint8_t> section_texture_status( sections.size(), true ); // Not vector<bool>, since every thread writes its own element.
+
+        const size_t OBJECTS_START  = nets_r.size();
+        const size_t SECTIONS_START = OBJECTS_START + objects.size();
+
+        Utilities::Parallel::forEach( SECTIONS_START + sections.size(), thread_amount, [&]( size_t index ) {
+            if( index < OBJECTS_START )
+                nets_r[ index ]->calculateNodeHeight( *ptc_pointers_r[0] );
+            else
+            if( index < SECTIONS_START )
+                objects[ index - OBJECTS_START ]->loadTextures( textures_from_prime );
+            else
+            if( !sections[ index - SECTIONS_START ]->loadTextures( textures_from_prime ) )
+                section_texture_status[ index - SECTIONS_START ] = false;
+        } );
+
+        for( size_t i = 0; i < sections.size(); i++ ) {
+            if( !section_texture_status[ i ] )
+                error_log.output << "Section/CTil ID: " << std::dec << sections[ i ]->getResourceID() << " had failed to load the textures!.\n";
+        }
+    }
+
+    /**
+     * @return True if the resource can be copied from another IFF, instead of being parsed.
+     */
+    bool isShareableResource( const Data::Mission::Resource &resource ) {
+        const uint32_t tag = resource.getResourceTagID();
+
+        return tag == Data::Mission::BMPResource::IDENTIFIER_TAG || tag == Data::Mission::ObjResource::IDENTIFIER_TAG ||
+            tag == Data::Mission::WAVResource::IDENTIFIER_TAG || tag == Data::Mission::SNDSResource::IDENTIFIER_TAG;
+    }
+
+    typedef std::unordered_multimap<uint64_t, const Data::Mission::Resource*> ContentIndex;
+
+    /**
+     * This indexes the shareable resources of an IFF by their content hash.
+     */
+    ContentIndex makeContentIndex( const Data::Mission::IFF &iff ) {
+        ContentIndex content_index;
+
+        for( const Data::Mission::Resource *resource_r : iff.getAllResources() ) {
+            if( isShareableResource( *resource_r ) )
+                content_index.emplace( resource_r->getContentHash(), resource_r );
+        }
+
+        return content_index;
+    }
+
+    /**
+     * If another IFF has a resource with the same content, then this replaces the resource with a parsed copy of it.
+     * @param resource_p The resource that has not been parsed or added yet. If it gets replaced, then the old resource gets deleted.
+     * @param content_index The resources of the other IFF.
+     * @return True if resource_p got replaced by an already parsed copy.
+     */
+    bool shareResource( Data::Mission::Resource *&resource_p, const ContentIndex &content_index ) {
+        if( content_index.empty() || !isShareableResource( *resource_p ) )
+            return false;
+
+        auto range = content_index.equal_range( resource_p->getContentHash() );
+
+        for( auto it = range.first; it != range.second; it++ ) {
+            const Data::Mission::Resource &shared_resource = *(*it).second;
+
+            if( shared_resource != *resource_p || !shared_resource.ensureParsed() )
+                continue;
+
+            Data::Mission::Resource *copy_p = shared_resource.duplicate();
+
+            // The copy keeps the data and the header size of the shared resource, but it has the place of resource_p.
+            copy_p->setOffset( resource_p->getOffset() );
+            copy_p->setMisIndexNumber( resource_p->getMisIndexNumber() );
+            copy_p->setIndexNumber( resource_p->getIndexNumber() );
+            // getResourceID() adds the index number when the resource has no ID of its own.
+            copy_p->setResourceID( resource_p->getResourceID() - (resource_p->noResourceID() ? resource_p->getIndexNumber() : 0) );
+            for( size_t a = 0; a < Data::Mission::Resource::RPNS_OFFSET_AMOUNT; a++ )
+                copy_p->setRPNSOffset( a, resource_p->getRPNSOffset( a ) );
+            for( size_t a = 0; a < Data::Mission::Resource::CODE_AMOUNT; a++ )
+                copy_p->setCodeAmount( a, resource_p->getCodeAmount( a ) );
+            copy_p->getSWVREntry() = resource_p->getSWVREntry();
+
+            delete resource_p;
+
+            resource_p = copy_p;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * This reads the bytes of an indexed resource.
+     * @param record The record of the resource.
+     * @param mapped_file_p The memory mapped IFF file. If nullptr, then file is used instead.
+     * @param file The IFF file stream.
+     * @param header_size This gets set to the amount of SHDR bytes placed in front of the data.
+     * @return The data of the resource or nullptr if the file could not be read.
+     */
+    Utilities::Buffer* readIndexedData( const Data::Mission::IFFIndex::Record &record, const std::shared_ptr<const Utilities::MappedFile> &mapped_file_p, const std::shared_ptr<std::pmr::monotonic_buffer_resource> &arena_p, std::fstream &file, size_t &header_size ) {
+        std::vector<Data::Mission::IFFIndex::Span> spans;
+
+        // Only the stream reader keeps the rest of the SHDR chunk, just like the chunk scan.
+        if( record.kind == Data::Mission::IFFIndex::SHOC && mapped_file_p == nullptr )
+            spans.push_back( record.header_span );
+
+        header_size = spans.empty() ? 0 : record.header_span.size;
+
+        spans.insert( spans.end(), record.spans.begin(), record.spans.end() );
+
+        auto data_p = new Utilities::Buffer();
+
+        if( mapped_file_p != nullptr && spans.size() == 1 ) {
+            data_p->setView( mapped_file_p, mapped_file_p->getData() + spans[0].offset, spans[0].size );
+            return data_p;
+        }
+
+        size_t total_size = 0;
+
+        for( const auto &span : spans )
+            total_size += span.size;
+
+        uint8_t *const bytes_r = allocateInArena( *data_p, arena_p, total_size );
+
+        size_t position = 0;
+
+        for( const auto &span : spans ) {
+            if( mapped_file_p != nullptr )
+                std::memcpy( bytes_r + position, mapped_file_p->getData() + span.offset, span.size );
+            else {
+                file.seekg( span.offset, std::ios::beg );
+                file.read( reinterpret_cast<char*>( bytes_r + position ), span.size );
+
+                if( !file ) {
+                    delete data_p;
+                    return nullptr;
+                }
+            }
+
+            position += span.size;
+        }
+
+        return data_p;
+    }
+
+    /**
+     * This makes the resource of an index record. The resource would not be parsed yet.
+     * @return The resource or nullptr if the data could not be read.
+     */
+    Data::Mission::Resource* newIndexedResource( const Data::Mission::IFFIndex::Record &record, const std::shared_ptr<const Utilities::MappedFile> &mapped_file_p, const std::shared_ptr<std::pmr::monotonic_buffer_resource> &arena_p, std::fstream &file ) {
+        size_t header_size;
+        Utilities::Buffer *data_p = readIndexedData( record, mapped_file_p, arena_p, file, header_size );
+
+        if( data_p == nullptr )
+            return nullptr;
+
+        Data::Mission::Resource *new_resource_p;
+
+        switch( record.kind ) {
+        case Data::Mission::IFFIndex::MSIC:
+            new_resource_p = new Data::Mission::MSICResource();
+            break;
+        case Data::Mission::IFFIndex::VAGM:
+            new_resource_p = new Data::Mission::VAGMResource();
+            break;
+        case Data::Mission::IFFIndex::VAGB:
+            new_resource_p = new Data::Mission::VAGBResource();
+            break;
+        case Data::Mission::IFFIndex::MDEC:
+            new_resource_p = new Data::Mission::UnkResource( PS1_CANM_TAG, "mdec", true );
+            break;
+        default:
+            {
+                auto file_type_it = file_type_list.find( record.tag );
+
+                if( file_type_it != file_type_list.end() )
+                    new_resource_p = (*file_type_it).second->genResourceByType( data_p->getReader( header_size ) );
+                else
+                    new_resource_p = new Data::Mission::UnkResource( record.tag, "unk" );
+            }
+        }
+
+        new_resource_p->setHeaderSize( header_size );
+        new_resource_p->setOffset( record.offset );
+        new_resource_p->setMisIndexNumber( record.mis_index_number );
+        new_resource_p->setIndexNumber( record.index_number );
+        new_resource_p->setResourceID( record.resource_id );
+        for( size_t a = 0; a < Data::Mission::Resource::RPNS_OFFSET_AMOUNT; a++ )
+            new_resource_p->setRPNSOffset( a, record.rpns_offsets[ a ] );
+        for( size_t a = 0; a < Data::Mission::Resource::CODE_AMOUNT; a++ )
+            new_resource_p->setCodeAmount( a, record.code_sizes[ a ] );
+        new_resource_p->getSWVREntry() = record.swvr_entry;
+
+        new_resource_p->setMemory( data_p );
+
+        return new_resource_p;
+    }
+
+    uint64_t combineHashes( uint64_t hash, uint64_t value ) {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+
+        return hash;
+    }
+
+    /**
+     * @return True if the export of the resource also reads other resources of the IFF.
+     */
+    bool isDependentResource( const Data::Mission::Resource &resource ) {
+        const uint32_t tag = resource.getResourceTagID();
+
+        return tag == Data::Mission::PTCResource::IDENTIFIER_TAG || tag == Data::Mission::TilResource::IDENTIFIER_TAG ||
+            tag == Data::Mission::ObjResource::IDENTIFIER_TAG || tag == Data::Mission::NetResource::IDENTIFIER_TAG;
+    }
+
+    /**
+     * This records the files that every written resource made into the manifest.
+     * The resources only tell the path without the extension, so a file belongs to a resource if its name is the name of the resource followed by a '.' or a '_'.
+     */
+    void recordOutputs( Data::Mission::ExportManifest &manifest, const std::filesystem::path &folder_path, const std::vector<std::filesystem::path> &full_paths, const std::vector<uint64_t> &content_hashes, uint64_t options_digest, const std::vector<uint8_t> &is_skipped ) {
+        std::unordered_map<std::string, Data::Mission::ExportManifest::Entry*> written_entries;
+
+        for( size_t i = 0; i < full_paths.size(); i++ ) {
+            if( is_skipped[ i ] )
+                continue;
+
+            const std::string name = full_paths[ i ].filename().string();
+            Data::Mission::ExportManifest::Entry &entry = manifest.entries[ name ];
+
+            entry.content_hash = content_hashes[ i ];
+            entry.options_digest = options_digest;
+            entry.output_names.clear();
+
+            written_entries[ name ] = &entry;
+        }
+
+        std::error_code error_code;
+
+        for( const auto &directory_entry : std::filesystem::directory_iterator( folder_path, error_code ) ) {
+            const std::string file_name = directory_entry.path().filename().string();
+
+            for( size_t position = file_name.find_first_of( "._" ); position != std::string::npos; position = file_name.find_first_of( "._", position + 1 ) ) {
+                auto written_entry = written_entries.find( file_name.substr( 0, position ) );
+
+                if( written_entry != written_entries.end() )
+                    written_entry->second->output_names.push_back( file_name );
+            }
+        }
+    }
 }
 
-int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
+int Data::Mission::IFF::open( const std::filesystem::path &file_path, const OpenSettings &settings ) {
     const size_t BLOCK_SIZE = 0x6000;
 
     std::unordered_set<std::filesystem::path> filenames; // Check for potential conflicts.
     Utilities::Logger &logger = Utilities::logger;
     std::fstream file;
+    std::shared_ptr<Utilities::MappedFile> mapped_file_p;
 
     auto info_log = logger.getLog( Utilities::Logger::INFO );
     info_log.info << "IFF: " << file_path << "\n";
@@ -343,24 +794,131 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
 
     this->setName( file_path.string() );
 
-    file.open( file_path, std::ios::binary | std::ios::in );
+    if( settings.memory_map ) {
+        mapped_file_p = std::make_shared<Utilities::MappedFile>();
 
-    if( file.is_open() )
+        if( !mapped_file_p->open( file_path ) ) {
+            warning_log.output << "The IFF file could not be memory mapped. Reading it as a stream instead.\n";
+            mapped_file_p = nullptr;
+        }
+    }
+
+    if( mapped_file_p == nullptr )
+        file.open( file_path, std::ios::binary | std::ios::in );
+
+    if( mapped_file_p != nullptr || file.is_open() )
     {
-        file.seekg(0, std::ios::end);
-        const int iff_file_size = file.tellg();
-        file.seekg(0, std::ios::beg);
+        int iff_file_size;
+
+        if( mapped_file_p != nullptr )
+            iff_file_size = mapped_file_p->getSize();
+        else {
+            file.seekg(0, std::ios::end);
+            iff_file_size = file.tellg();
+            file.seekg(0, std::ios::beg);
+        }
+
+        // In stream mode the resources take about as many bytes as the file, so the whole file is the first block of the arena.
+        // Memory mapped resources only use the arena if they are split across SDAT chunks.
+        if( mapped_file_p == nullptr )
+            arena_p = std::make_shared<std::pmr::monotonic_buffer_resource>( std::max( iff_file_size, 1 ) );
+        else
+            arena_p = std::make_shared<std::pmr::monotonic_buffer_resource>();
 
         Data::Mission::Resource::ParseSettings default_settings = Data::Mission::Resource::ParseSettings();
 
+        ContentIndex shared_content_index;
+
+        if( settings.shared_iff_r != nullptr && settings.shared_iff_r != this )
+            shared_content_index = makeContentIndex( *settings.shared_iff_r );
+
+        IFFIndex index;
+        const std::filesystem::path index_path = IFFIndex::getIndexPath( file_path, settings.index_cache_directory );
+
+        if( settings.use_index_cache && index.read( index_path, file_path ) ) {
+            std::vector<Resource*> indexed_resources_r;
+
+            indexed_resources_r.reserve( index.records.size() );
+
+            for( const IFFIndex::Record &record : index.records ) {
+                Resource *resource_p = newIndexedResource( record, mapped_file_p, arena_p, file );
+
+                if( resource_p == nullptr )
+                    break;
+
+                indexed_resources_r.push_back( resource_p );
+            }
+
+            if( indexed_resources_r.size() == index.records.size() ) {
+                debug_log.output << "Resources are read from the index " << index_path << ".\n";
+
+                if( mapped_file_p == nullptr )
+                    file.close();
+
+                std::vector<Resource*> unparsed_resources_r;
+
+                unparsed_resources_r.reserve( indexed_resources_r.size() );
+
+                for( Resource *resource_p : indexed_resources_r ) {
+                    if( !shareResource( resource_p, shared_content_index ) )
+                        unparsed_resources_r.push_back( resource_p );
+
+                    addResource( resource_p );
+                }
+
+                default_settings.endian = index.endian;
+
+                parseResources( *this, unparsed_resources_r, default_settings, settings.parse_thread_amount, settings.lazy_parse, settings.cancel_r, error_log );
+
+                return 1;
+            }
+
+            // The index does not work, so do the chunk scan instead.
+            warning_log.output << "The resource index " << index_path << " could not be used.\n";
+
+            for( Resource *resource_p : indexed_resources_r )
+                delete resource_p;
+
+            index.records.clear();
+
+            if( mapped_file_p == nullptr ) {
+                file.clear();
+                file.seekg(0, std::ios::beg);
+            }
+        }
+
         bool error_in_read = false;
 
+        // The streaming mode reads the file one block at a time into this buffer.
         Utilities::Buffer data_buffer;
-        data_buffer.allocate( BLOCK_SIZE );
-        Utilities::Buffer::Writer data_writer = data_buffer.getWriter();
-        Utilities::Buffer::Reader data_reader = data_buffer.getReader();
+
+        if( mapped_file_p == nullptr )
+            data_buffer.allocate( BLOCK_SIZE );
+
+        // The chunks are reassembled into resources first, then every resource gets parsed at once.
+        std::vector<Resource*> unparsed_resources_r;
+
+        auto addUnparsedResource = [&]( Resource* resource_p, IFFIndex::Kind kind, uint32_t resource_id, const IFFIndex::Span &header_span, const std::vector<IFFIndex::Span> &spans ) {
+            if( !shareResource( resource_p, shared_content_index ) )
+                unparsed_resources_r.push_back( resource_p );
+
+            addResource( resource_p );
+
+            if( settings.use_index_cache )
+                index.records.push_back( makeIndexRecord( *resource_p, kind, resource_id, header_span, spans ) );
+        };
+
+        // The spans of the sound and video resources, which only the index needs.
+        const IFFIndex::Span no_header_span = { 0, 0 };
+        std::vector<IFFIndex::Span> msic_spans;
+        std::vector<IFFIndex::Span> vagm_0_spans;
+        std::vector<IFFIndex::Span> vagm_1_spans;
+        std::vector<IFFIndex::Span> vagb_spans;
+        std::vector<IFFIndex::Span> mdec_spans;
 
         UnidentifiedResource unidentified_resource;
+        unidentified_resource.setMappedFile( mapped_file_p );
+        unidentified_resource.setArena( arena_p );
         size_t resources_amount = 0;
         MSICResource *msic_p = nullptr;
         Utilities::Buffer *msic_data_p;
@@ -381,13 +939,40 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
         std::map<uint32_t, uint32_t> *header_enum_numbers_r = &pc_header_enum_numbers;
 
         uint32_t block_index = 0;
+        size_t block_start_position = 0;
 
-        data_writer.setPosition(0);
-        data_writer.write( file, BLOCK_SIZE );
-        data_reader.setPosition(0);
+        auto getBlockReader = [&]() -> Utilities::Buffer::Reader {
+            if( mapped_file_p != nullptr ) {
+                const size_t block_offset = BLOCK_SIZE * block_index;
+
+                return mapped_file_p->getReader( block_offset, std::min( BLOCK_SIZE, mapped_file_p->getSize() - block_offset ) );
+            }
+            else
+                return data_buffer.getReader();
+        };
+
+        auto readBlock = [&]() -> bool {
+            if( mapped_file_p != nullptr )
+                return BLOCK_SIZE * block_index < mapped_file_p->getSize();
+
+            if( file.eof() )
+                return false;
+
+            Utilities::Buffer::Writer data_writer = data_buffer.getWriter();
+            data_writer.write( file, BLOCK_SIZE );
+
+            return !file.eof();
+        };
+
+        bool has_block = readBlock();
 
         {
-            const uint32_t TYPE_ID = data_reader.readU32( default_settings.endian );
+            Utilities::Buffer::Reader data_reader = getBlockReader();
+
+            uint32_t TYPE_ID = 0;
+
+            if( data_reader.totalSize() >= 6 * sizeof( uint32_t ) )
+                TYPE_ID = data_reader.readU32( default_settings.endian );
 
             if( TYPE_ID == IN_ENDIAN_CTRL_TAG || TYPE_ID == OP_ENDIAN_CTRL_TAG ) {
                 auto info_log = logger.getLog( Utilities::Logger::INFO );
@@ -412,7 +997,7 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
 
                 assert(ZERO == 0);
 
-                data_reader.setPosition( CHUNK_SIZE );
+                block_start_position = CHUNK_SIZE;
 
                 // TODO Add playstation detection
             }
@@ -423,7 +1008,11 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
             }
         }
 
-        while( !file.eof() && !error_in_read ) {
+        while( has_block && !error_in_read ) {
+            Utilities::Buffer::Reader data_reader = getBlockReader();
+            data_reader.setPosition( block_start_position );
+            block_start_position = 0;
+
             while( data_reader.getPosition(Utilities::Buffer::Direction::END) > 2 * sizeof(uint32_t) ) {
                 const int file_offset = BLOCK_SIZE * block_index + data_reader.getPosition();
 
@@ -446,6 +1035,11 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
 
                 auto block_chunk_reader = data_reader.getReader( DATA_SIZE );
 
+                // This gives the location of the next bytes of block_chunk_reader in the IFF file.
+                auto getChunkSpan = [&]( size_t size ) -> IFFIndex::Span {
+                    return { file_offset + 2 * sizeof( uint32_t ) + block_chunk_reader.getPosition(), size };
+                };
+
                 // Now that the data chunk can be read it is time for this switch statement.
                 switch( TYPE_ID ) {
                 case FILL_TAG:
@@ -466,6 +1060,7 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
                     assert(msic_p != nullptr);
                     assert(msic_data_p != nullptr);
 
+                    msic_spans.push_back( getChunkSpan( DATA_SIZE ) );
                     block_chunk_reader.addToBuffer(*msic_data_p, DATA_SIZE);
                     break;
                 case PS1_VAGM_TAG:
@@ -535,7 +1130,9 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
 
                                 swvr_entry.name = name_backup;
                             }
+                            vagm_0_spans.push_back( getChunkSpan( (DATA_SIZE - 20) / 2 ) );
                             block_chunk_reader.addToBuffer(*vagm_0_data_p, (DATA_SIZE - 20) / 2);
+                            vagm_1_spans.push_back( getChunkSpan( (DATA_SIZE - 20) / 2 ) );
                             block_chunk_reader.addToBuffer(*vagm_1_data_p, (DATA_SIZE - 20) / 2);
                         }
                         else if(TYPE_ID == PS1_VAGB_TAG) {
@@ -557,6 +1154,7 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
 
                                 vagb_data_p = new Utilities::Buffer();
                             }
+                            vagb_spans.push_back( getChunkSpan( DATA_SIZE - 16 ) );
                             block_chunk_reader.addToBuffer(*vagb_data_p, DATA_SIZE - 16);
                         }
                         else {
@@ -579,6 +1177,7 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
 
                                 mdec_data_p = new Utilities::Buffer();
                             }
+                            mdec_spans.push_back( getChunkSpan( DATA_SIZE - 32 ) );
                             block_chunk_reader.addToBuffer(*mdec_data_p, DATA_SIZE - 32);
                         }
                     }
@@ -598,7 +1197,7 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
 
                             if( DATA_SIZE >= 0x14 ) {
                                 if( resources_amount != 0 ) {
-                                    addResource( unidentified_resource.newResource(default_settings, filenames, id_to_resource_p[ unidentified_resource.getResourceTagID() ].size(), debug_log, error_log ) );
+                                    addUnparsedResource( unidentified_resource.newResource( filenames, id_to_resource_p[ unidentified_resource.getResourceTagID() ].size(), debug_log, error_log ), IFFIndex::SHOC, unidentified_resource.getResourceID(), unidentified_resource.getHeaderSpan(), unidentified_resource.getSpans() );
                                 }
 
                                 const auto ENUM_NUMBER = block_chunk_reader.readU32( default_settings.endian );
@@ -651,14 +1250,15 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
                                     unidentified_resource.setCodeAmount( i, block_chunk_reader.readU32( default_settings.endian ) );
                                 } // 0x30
 
-                                unidentified_resource.setHeaderSize( block_chunk_reader.getPosition( Utilities::Buffer::Direction::END ) );
-
-                                unidentified_resource.getDataReference() = std::make_unique<Utilities::Buffer>();
+                                unidentified_resource.startSpans( getChunkSpan( block_chunk_reader.getPosition( Utilities::Buffer::Direction::END ) ) );
 
-                                assert( unidentified_resource.getDataReference() != nullptr );
+                                if( mapped_file_p == nullptr ) {
+                                    unidentified_resource.setHeaderSize( block_chunk_reader.getPosition( Utilities::Buffer::Direction::END ) );
 
-                                unidentified_resource.getDataReference()->reserve( RESOURCE_SIZE + unidentified_resource.getHeaderSize() );
-                                block_chunk_reader.addToBuffer(*unidentified_resource.getDataReference(), unidentified_resource.getHeaderSize() );
+                                    // A bad RESOURCE_SIZE must not allocate more than the file could hold.
+                                    unidentified_resource.startArenaData( std::min<size_t>( RESOURCE_SIZE, iff_file_size ) + unidentified_resource.getHeaderSize() );
+                                    unidentified_resource.addArenaData( block_chunk_reader, unidentified_resource.getHeaderSize() );
+                                }
                             }
                             else {
                                 error_in_read = true;
@@ -676,7 +1276,10 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
                                     << ": METADATA is " << std::dec << METADATA << " for 0x" << std::hex << file_offset << ".\n";
                             }
 
-                            block_chunk_reader.addToBuffer(*unidentified_resource.getDataReference(), DATA_SIZE - 0xc );
+                            unidentified_resource.addSpan( getChunkSpan( DATA_SIZE - 0xc ) );
+
+                            if( mapped_file_p == nullptr )
+                                unidentified_resource.addArenaData( block_chunk_reader, DATA_SIZE - 0xc );
                         }
                         else
                             error_log.output << "This SHOC chunk is either too small or has an invalid tag." << std::endl;
@@ -750,10 +1353,10 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
                         {
                             // This gives msic_data_p to msic so there is no need to delete it.
                             vagb_p->setMemory( vagb_data_p );
-                            vagb_p->parse( default_settings );
 
                             // msic_p->setMemory( nullptr );
-                            addResource( vagb_p );
+                            addUnparsedResource( vagb_p, IFFIndex::VAGB, 1, no_header_span, vagb_spans );
+                            vagb_spans.clear();
 
                             vagb_p = nullptr;
                         }
@@ -763,10 +1366,10 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
                         {
                             // This gives msic_data_p to msic so there is no need to delete it.
                             mdec_p->setMemory( mdec_data_p );
-                            mdec_p->parse( default_settings );
 
                             // msic_p->setMemory( nullptr );
-                            addResource( mdec_p );
+                            addUnparsedResource( mdec_p, IFFIndex::MDEC, 1, no_header_span, mdec_spans );
+                            mdec_spans.clear();
 
                             mdec_p = nullptr;
                         }
@@ -780,33 +1383,31 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
             // Advance the block index.
             block_index++;
 
-            if(!file.eof()) {
-                data_writer.setPosition(0);
-                data_writer.write( file, BLOCK_SIZE );
-                data_reader.setPosition(0);
-            }
+            has_block = readBlock();
         }
 
-        // Find a potential error.
-        auto readstate = file.rdstate();
+        if( mapped_file_p == nullptr ) {
+            // Find a potential error.
+            auto readstate = file.rdstate();
 
-        if( errno != 0 )
-        {
-            if( ( readstate & std::ifstream::failbit ) != 0 ) {
-                error_log.output << "There is a logical error detected with the reading of the IFF or Mission File. Please report this to the developer!\n"
-                    << "Error: " << std::strerror(errno) << "\n";
-            }
-            if( ( readstate & std::ifstream::badbit ) != 0 ) {
-                error_log.output << "There is a input error detected with the reading of the IFF or Mission File.\n";
+            if( errno != 0 )
+            {
+                if( ( readstate & std::ifstream::failbit ) != 0 ) {
+                    error_log.output << "There is a logical error detected with the reading of the IFF or Mission File. Please report this to the developer!\n"
+                        << "Error: " << std::strerror(errno) << "\n";
+                }
+                if( ( readstate & std::ifstream::badbit ) != 0 ) {
+                    error_log.output << "There is a input error detected with the reading of the IFF or Mission File.\n";
+                }
             }
-        }
 
-        // We are done reading the IFF file.
-        file.close();
+            // We are done reading the IFF file.
+            file.close();
+        }
 
-        // Now, every resource can be parsed.
+        // Make the last resource.
         if( resources_amount != 0 ) {
-            addResource( unidentified_resource.newResource(default_settings, filenames, id_to_resource_p[ unidentified_resource.getResourceTagID() ].size(), debug_log, error_log ) );
+            addUnparsedResource( unidentified_resource.newResource( filenames, id_to_resource_p[ unidentified_resource.getResourceTagID() ].size(), debug_log, error_log ), IFFIndex::SHOC, unidentified_resource.getResourceID(), unidentified_resource.getHeaderSpan(), unidentified_resource.getSpans() );
         }
 
         // Then write the MISC file.
@@ -814,10 +1415,9 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
         {
             // This gives msic_data_p to msic so there is no need to delete it.
             msic_p->setMemory( msic_data_p );
-            msic_p->parse( default_settings );
             
             // msic_p->setMemory( nullptr );
-            addResource( msic_p );
+            addUnparsedResource( msic_p, IFFIndex::MSIC, 1, no_header_span, msic_spans );
         }
 
         // Then write the music file.
@@ -825,12 +1425,10 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
         {
             // This gives vagm_0_data_p to vagm_0_p so there is no need to delete it.
             vagm_0_p->setMemory( vagm_0_data_p );
-            vagm_0_p->parse( default_settings );
-            addResource( vagm_0_p );
+            addUnparsedResource( vagm_0_p, IFFIndex::VAGM, 1, no_header_span, vagm_0_spans );
 
             vagm_1_p->setMemory( vagm_1_data_p );
-            vagm_1_p->parse( default_settings );
-            addResource( vagm_1_p );
+            addUnparsedResource( vagm_1_p, IFFIndex::VAGM, 2, no_header_span, vagm_1_spans );
         }
 
         // Then write the voice file.
@@ -838,10 +1436,9 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
         {
             // This gives msic_data_p to msic so there is no need to delete it.
             vagb_p->setMemory( vagb_data_p );
-            vagb_p->parse( default_settings );
 
             // msic_p->setMemory( nullptr );
-            addResource( vagb_p );
+            addUnparsedResource( vagb_p, IFFIndex::VAGB, 1, no_header_span, vagb_spans );
         }
 
         // Then write the video file.
@@ -849,59 +1446,19 @@ int Data::Mission::IFF::open( const std::filesystem::path &file_path ) {
         {
             // This gives msic_data_p to msic so there is no need to delete it.
             mdec_p->setMemory( mdec_data_p );
-            mdec_p->parse( default_settings );
 
             // msic_p->setMemory( nullptr );
-            addResource( mdec_p );
+            addUnparsedResource( mdec_p, IFFIndex::MDEC, 1, no_header_span, mdec_spans );
         }
 
-        Data::Accessor accessor;
-        accessor.load( *this );
-
-        auto ptc_pointers_r = accessor.getAllPTC();
+        if( settings.use_index_cache && !error_in_read ) {
+            index.endian = default_settings.endian;
 
-        if( ptc_pointers_r.size() != 0 ) {
-            if( !ptc_pointers_r[0]->makeTiles( accessor.getAllTIL() ) )
-            {
-                error_log.output << "PTC resource is found, but there are no Til resources.\n";
-            }
-
-            auto objects = accessor.getAllNET();
-
-            for( auto it = objects.begin(); it != objects.end(); it++ ) {
-                (*it)->calculateNodeHeight( *ptc_pointers_r[0] );
-            }
+            if( !index.write( index_path, file_path ) )
+                warning_log.output << "The resource index " << index_path << " could not be written.\n";
         }
-        else
-        if( getResource( Data::Mission::TilResource::IDENTIFIER_TAG ) != nullptr )
-            error_log.output << "PTC resource is not found, but the Til resources are in the file.\n";
-
-        if( getResource( Data::Mission::ObjResource::IDENTIFIER_TAG ) != nullptr ) {
-            auto textures_from_prime = accessor.getAllBMP();
-
-            // TODO add optional global file.
-            // textures.insert( textures.end(), textures.begin(), textures.end() );
-
-            auto objects = accessor.getAllOBJ();
-
-            for( auto it = objects.begin(); it != objects.end(); it++ ) {
-                (*it)->loadTextures( textures_from_prime );
-            }
-        }
-
-        if( getResource( Data::Mission::TilResource::IDENTIFIER_TAG ) != nullptr ) {
-            auto textures_from_prime = accessor.getAllBMP();
 
-            // TODO add optional global file.
-            // textures.insert( textures.end(), textures.begin(), textures.end() );
-
-            auto sections = accessor.getAllTIL();
-
-            for( auto section = sections.begin(); section != sections.end(); section++ ) {
-                if( !(*section)->loadTextures( textures_from_prime ) )
-                    error_log.output << "Section/CTil ID: " << std::dec << (*section)->getResourceID() << " had failed to load the textures!.\n";
-            }
-        }
+        parseResources( *this, unparsed_resources_r, default_settings, settings.parse_thread_amount, settings.lazy_parse, settings.cancel_r, error_log );
 
         return 1;
     }
@@ -980,56 +1537,100 @@ std::vector<const Data::Mission::Resource*> Data::Mission::IFF::getAllSWVRResour
 }
 
 
-int Data::Mission::IFF::exportAllResources( const std::filesystem::path &folder_path, bool raw_file_mode, const std::vector<std::string>& arguments ) const {
+int Data::Mission::IFF::exportAllResources( const std::filesystem::path &folder_path, bool raw_file_mode, const std::vector<std::string>& arguments, unsigned thread_amount ) const {
+    Data::Mission::IFFOptions iff_options;
+
+    if( iff_options.readParams( arguments, &std::cout ) )
+        return exportAllResources( folder_path, raw_file_mode, iff_options, thread_amount );
+    else
+        return false;
+}
+
+int Data::Mission::IFF::exportAllResources( const std::filesystem::path &folder_path, bool raw_file_mode, const IFFOptions &iff_options, unsigned thread_amount, ExportManifest *manifest_r ) const {
     // This algorithm is an O(n) algorithm and it is as good as it is going to get in terms of data complexity. :)
     if( resource_amount != 0 )
     {
-        std::filesystem::path path = folder_path;
-
-        Data::Mission::IFFOptions iff_options;
-
-        if( iff_options.readParams( arguments, &std::cout ) ) {
-            // For every resource type categories in the Mission file.
-            for( auto map_it = id_to_resource_p.begin(); map_it != id_to_resource_p.end(); map_it++ ) {
-                for( auto it = map_it->second.begin(); it != map_it->second.end(); it++ ) {
-                    std::filesystem::path full_path = path;
-                    full_path /= (*it)->getFullName( (*it)->getResourceID() );
-
-                    if( raw_file_mode )
-                        (*it)->write( full_path, iff_options );
-                    else
-                    if( !iff_options.enable_global_dry_default )
-                        (*it)->writeRaw( full_path, iff_options );
-                }
+        std::vector<const Resource*> resources_r;
+
+        resources_r.reserve( resource_amount + 1 );
+
+        // For every resource type categories in the Mission file.
+        for( auto map_it = id_to_resource_p.begin(); map_it != id_to_resource_p.end(); map_it++ ) {
+            for( auto it = map_it->second.begin(); it != map_it->second.end(); it++ )
+                resources_r.push_back( *it );
+        }
+        for( auto tos_it : tos_to_map_p ) {
+            for( auto map_it : tos_it.second ) {
+                for( auto it : map_it.second )
+                    resources_r.push_back( it );
             }
-            for( auto tos_it : tos_to_map_p ) {
-                for( auto map_it : tos_it.second ) {
-                    for( auto it : map_it.second ) {
-                        std::filesystem::path full_path = path;
-                        full_path /= it->getFullName( it->getResourceID() );
-
-                        if( raw_file_mode )
-                            it->write( full_path, iff_options );
-                        else
-                        if( !iff_options.enable_global_dry_default )
-                            it->writeRaw( full_path, iff_options );
-                    }
-                }
+        }
+        if( this->music_p != nullptr )
+            resources_r.push_back( this->music_p );
+
+        std::vector<std::filesystem::path> full_paths( resources_r.size(), folder_path );
+        std::vector<uint8_t> is_overwritten( resources_r.size(), false ); // Not vector<bool>, since every thread reads its own element.
+        std::unordered_map<std::string, size_t> last_writer;
+
+        for( size_t i = 0; i < resources_r.size(); i++ ) {
+            full_paths[ i ] /= resources_r[ i ]->getFullName( resources_r[ i ]->getResourceID() );
+
+            // If two resources have the same path, then only the last one is written like the sequential export would leave it.
+            auto result = last_writer.emplace( full_paths[ i ].string(), i );
+
+            if( !result.second ) {
+                is_overwritten[ result.first->second ] = true;
+                result.first->second = i;
             }
-            if( this->music_p != nullptr ) {
-                std::filesystem::path full_path = path;
-                full_path /= this->music_p->getFullName( this->music_p->getResourceID() );
+        }
 
-                if( raw_file_mode )
-                    this->music_p->write( full_path, iff_options );
-                else
-                if( !iff_options.enable_global_dry_default )
-                    this->music_p->writeRaw( full_path, iff_options );
+        std::vector<uint64_t> content_hashes;
+        uint64_t options_digest = 0;
+
+        if( manifest_r != nullptr ) {
+            content_hashes.resize( resources_r.size() );
+
+            Utilities::Parallel::forEach( resources_r.size(), thread_amount, [&]( size_t index ) {
+                content_hashes[ index ] = resources_r[ index ]->getContentHash();
+            } );
+
+            // The models and the map are made from other resources, so they are only up to date if nothing in this IFF changed.
+            uint64_t dependency_hash = resources_r.size();
+
+            for( uint64_t content_hash : content_hashes )
+                dependency_hash = combineHashes( dependency_hash, content_hash );
+
+            for( size_t i = 0; i < resources_r.size(); i++ ) {
+                if( content_hashes[ i ] != 0 && isDependentResource( *resources_r[ i ] ) )
+                    content_hashes[ i ] = combineHashes( content_hashes[ i ], dependency_hash );
+            }
+
+            options_digest = combineHashes( iff_options.getDigest(), raw_file_mode );
+
+            for( size_t i = 0; i < resources_r.size(); i++ ) {
+                if( !is_overwritten[ i ] && manifest_r->isUpToDate( folder_path, full_paths[ i ].filename().string(), content_hashes[ i ], options_digest ) )
+                    is_overwritten[ i ] = true;
             }
-            return true;
         }
-        else
-            return false;
+
+        // Every resource is written on its own, so one thread can encode while the others wait on the file system.
+        Utilities::Parallel::forEach( resources_r.size(), thread_amount, [&]( size_t index ) {
+            if( is_overwritten[ index ] )
+                return;
+
+            if( raw_file_mode ) {
+                resources_r[ index ]->ensureParsed();
+                resources_r[ index ]->write( full_paths[ index ], iff_options );
+            }
+            else
+            if( !iff_options.enable_global_dry_default )
+                resources_r[ index ]->writeRaw( full_paths[ index ], iff_options );
+        } );
+
+        if( manifest_r != nullptr )
+            recordOutputs( *manifest_r, folder_path, full_paths, content_hashes, options_digest, is_overwritten );
+
+        return true;
     }
     else
         return false;
@@ -1061,6 +1662,14 @@ int Data::Mission::IFF::compare( const IFF &operand, std::ostream &out ) const {
     std::vector<Resource*> operand1( const_cast< Data::Mission::IFF* >(  this  )->getAllResources() );
     std::vector<Resource*> operand2( const_cast< Data::Mission::IFF& >( operand ).getAllResources() );
 
+    // The hashes are computed up front in parallel, so the sorting would rarely need to read the data.
+    Utilities::Parallel::forEach( operand1.size() + operand2.size(), 0, [&]( size_t index ) {
+        if( index < operand1.size() )
+            operand1[ index ]->getContentHash();
+        else
+            operand2[ index - operand1.size() ]->getContentHash();
+    } );
+
     // This makes sure that the operation is not a O-log(n^2) operation when the comparing happens.
     std::sort( operand1.begin(), operand1.end(), compareFunction );
     std::sort( operand2.begin(), operand2.end(), compareFunction );
@@ -1,9 +1,12 @@
 #ifndef MISSION_FILE_HEADER
 #define MISSION_FILE_HEADER
 
+#include <atomic>
 #include <cstdint>
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -14,6 +17,8 @@ namespace Mission {
 
 class Resource;
 class MSICResource;
+class IFFOptions;
+class ExportManifest;
 
 /**
  * This class reads an IFF file.
@@ -23,6 +28,35 @@ class IFF {
 public:
     enum DataType {GLOBALS, CRIME_WAR, PRECINCT_ASSUALT};
 
+    class OpenSettings {
+    public:
+        // If true the IFF file gets memory mapped. Resources stored in a single SDAT chunk would reference the mapping instead of being copied.
+        bool memory_map;
+
+        // The amount of threads that parse the resources. One, the default, parses on the calling thread only, and zero means every hardware thread.
+        unsigned parse_thread_amount;
+
+        // If true, only the resources that get linked together while opening are parsed. The rest are parsed on their first access from Data::Accessor or from Resource::ensureParsed().
+        bool lazy_parse;
+
+        // If true, the locations of the resources get cached in an index file, so the next open can skip the chunk scan.
+        bool use_index_cache;
+
+        // The directory of the index files. If empty, the index file is placed next to the IFF file.
+        std::filesystem::path index_cache_directory;
+
+        // If not nullptr, the BMP, OBJ and sound resources that are identical to a resource of this IFF are copied from it instead of being parsed again.
+        // The copies share the payload of the original if it is a memory mapped or an arena allocated view. Usually this would be the global IFF.
+        const IFF *shared_iff_r;
+
+        // If not nullptr and it becomes true, open() stops parsing, and the resources that are left get parsed on their first access instead.
+        // This lets a background open that is no longer wanted finish early.
+        const std::atomic<bool> *cancel_r;
+
+        OpenSettings();
+    };
+    static const OpenSettings DEFAULT_OPEN_SETTINGS;
+
 private:
     std::string name;
 
@@ -32,6 +66,10 @@ private:
 
     unsigned resource_amount;
 
+    // The bytes of the resources that do not reference the file directly are allocated from this arena, so they get released at once.
+    // Only open() allocates from it, and the buffers of the resources keep it alive.
+    std::shared_ptr<std::pmr::monotonic_buffer_resource> arena_p;
+
     static bool compareFunction( const Resource *const res_a, const Resource *const res_b );
 
     void addResourceTo( std::map<uint32_t, std::vector<Resource*>> &id_to_resource, Resource* resource_p );
@@ -98,9 +136,13 @@ public:
 
     /**
      * This opens the mission file and reads every resource in that file.
-     * @return TODO add some returns
+     * @note In memory map mode the SHDR bytes past the known header fields are not kept, so getHeaderSize() of every resource would be zero.
+     * @note If the resources are read from the index file, then the duplicate name check of the chunk scan is skipped.
+     * @param file_path The path to the IFF file.
+     * @param settings These settings change how the file is read.
+     * @return 1 if the file is read, and -1 if the file could not be opened.
      */
-    int open( const std::filesystem::path& file_path );
+    int open( const std::filesystem::path& file_path, const OpenSettings &settings = DEFAULT_OPEN_SETTINGS );
 
     /**
      * This exports all the resources from this mission file.
@@ -108,9 +150,22 @@ public:
      * @param folder_path This is where all the files will be exported. Be very careful as it will make a mess of your file system if placed in the wrong place.
      * @param raw_file_mode set this to true if you do not to write the decoded output. Note not every format is supported as of now.
      * @param arguments The arguments to be passed into every file in this resource.
+     * @param thread_amount The amount of threads that write the resources. Zero means every hardware thread.
      * @return 1 for a successfull, 0 for no export. TODO add yet more return values
      */
-    int exportAllResources( const std::filesystem::path& folder_path, bool raw_file_mode, const std::vector<std::string> & arguments ) const;
+    int exportAllResources( const std::filesystem::path& folder_path, bool raw_file_mode, const std::vector<std::string> & arguments, unsigned thread_amount = 1 ) const;
+
+    /**
+     * This exports all the resources from this mission file with options that are already read.
+     * @note This is for exporting many mission files, so the arguments only have to be read once.
+     * @param folder_path This is where all the files will be exported.
+     * @param raw_file_mode set this to true if you do not to write the decoded output.
+     * @param iff_options The options to be passed into every file in this resource. Every resource is written with iff_options.thread_amount threads of its own.
+     * @param thread_amount The amount of threads that write the resources. Zero means every hardware thread.
+     * @param manifest_r If not nullptr, the resources that the manifest has as up to date are skipped, and the written resources are recorded into it.
+     * @return 1 for a successfull, 0 for no export.
+     */
+    int exportAllResources( const std::filesystem::path& folder_path, bool raw_file_mode, const IFFOptions &iff_options, unsigned thread_amount = 1, ExportManifest *manifest_r = nullptr ) const;
 
     /**
      * This compares this mission file to another IFF.
@@ -0,0 +1,239 @@
+#include "IFFIndex.h"
+
+#include <algorithm>
+
+namespace {
+
+// which is { 'F', 'C', 'I', 'X' } or "FCIX"
+const uint32_t INDEX_TAG = 0x46434958;
+
+struct IndexKey {
+    std::string path;
+    uint64_t size;
+    int64_t modification_time;
+};
+
+bool getIndexKey( const std::filesystem::path &iff_path, IndexKey &key ) {
+    std::error_code error_code;
+
+    const std::filesystem::path absolute_path = std::filesystem::absolute( iff_path, error_code );
+
+    if( error_code )
+        return false;
+
+    key.path = absolute_path.string();
+
+    key.size = std::filesystem::file_size( iff_path, error_code );
+
+    if( error_code )
+        return false;
+
+    key.modification_time = std::filesystem::last_write_time( iff_path, error_code ).time_since_epoch().count();
+
+    if( error_code )
+        return false;
+
+    return true;
+}
+
+void addString( Utilities::Buffer &buffer, const std::string &text ) {
+    buffer.addU32( text.size(), Utilities::Buffer::Endian::LITTLE );
+    buffer.add( reinterpret_cast<const uint8_t*>( text.data() ), text.size() );
+}
+
+std::string readString( Utilities::Buffer::Reader &reader ) {
+    const uint32_t length = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+
+    const uint8_t *const text_r = reader.readSpan( length );
+
+    return std::string( reinterpret_cast<const char*>( text_r ), length );
+}
+
+void addSpan( Utilities::Buffer &buffer, const Data::Mission::IFFIndex::Span &span ) {
+    buffer.addU64( span.offset, Utilities::Buffer::Endian::LITTLE );
+    buffer.addU64( span.size,   Utilities::Buffer::Endian::LITTLE );
+}
+
+Data::Mission::IFFIndex::Span readSpan( Utilities::Buffer::Reader &reader ) {
+    Data::Mission::IFFIndex::Span span;
+
+    span.offset = reader.readU64( Utilities::Buffer::Endian::LITTLE );
+    span.size   = reader.readU64( Utilities::Buffer::Endian::LITTLE );
+
+    return span;
+}
+
+/**
+ * @return True if the span is inside a file of the given size. This is written so that it cannot wrap around.
+ */
+bool isInside( const Data::Mission::IFFIndex::Span &span, uint64_t file_size ) {
+    return span.size <= file_size && span.offset <= file_size - span.size;
+}
+
+// The smallest amount of bytes that a record or a span takes in the index file. These cap the amounts read from the file before reserving.
+const size_t SPAN_SIZE = 2 * sizeof( uint64_t );
+const size_t MIN_RECORD_SIZE = sizeof( uint8_t ) + 5 * sizeof( uint32_t ) +
+    (Data::Mission::Resource::RPNS_OFFSET_AMOUNT + Data::Mission::Resource::CODE_AMOUNT) * sizeof( uint32_t ) +
+    3 * sizeof( uint32_t ) + SPAN_SIZE + sizeof( uint32_t );
+
+}
+
+namespace Data::Mission {
+
+const std::filesystem::path IFFIndex::FILE_EXTENSION = "fcindex";
+
+IFFIndex::IFFIndex() : endian( Utilities::Buffer::Endian::NO_SWAP ) {}
+
+std::filesystem::path IFFIndex::getIndexPath( const std::filesystem::path &iff_path, const std::filesystem::path &directory ) {
+    std::filesystem::path index_path;
+
+    if( directory.empty() )
+        index_path = iff_path;
+    else {
+        index_path = directory;
+        index_path /= iff_path.filename();
+    }
+
+    index_path += ".";
+    index_path += FILE_EXTENSION;
+
+    return index_path;
+}
+
+bool IFFIndex::read( const std::filesystem::path &index_path, const std::filesystem::path &iff_path ) {
+    IndexKey key;
+
+    records.clear();
+
+    if( !getIndexKey( iff_path, key ) )
+        return false;
+
+    Utilities::Buffer buffer;
+
+    if( !buffer.read( index_path ) )
+        return false;
+
+    auto reader = buffer.getReader();
+
+    try {
+        if( reader.readU32( Utilities::Buffer::Endian::LITTLE ) != INDEX_TAG )
+            return false;
+
+        if( reader.readU32( Utilities::Buffer::Endian::LITTLE ) != VERSION )
+            return false;
+
+        // The index is only valid for the exact file that it has been made from.
+        if( readString( reader ) != key.path )
+            return false;
+
+        if( reader.readU64( Utilities::Buffer::Endian::LITTLE ) != key.size )
+            return false;
+
+        if( reader.readI64( Utilities::Buffer::Endian::LITTLE ) != key.modification_time )
+            return false;
+
+        endian = static_cast<Utilities::Buffer::Endian>( reader.readU8() );
+
+        const uint32_t record_amount = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+
+        // A corrupt amount must not make the reserve throw, so it is capped by the records that could fit in the rest of the file.
+        records.reserve( std::min<size_t>( record_amount, reader.getPosition( Utilities::Buffer::END ) / MIN_RECORD_SIZE ) );
+
+        for( uint32_t r = 0; r < record_amount; r++ ) {
+            Record record;
+
+            record.kind             = static_cast<Kind>( reader.readU8() );
+            record.tag              = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+            record.resource_id      = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+            record.offset           = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+            record.mis_index_number = reader.readI32( Utilities::Buffer::Endian::LITTLE );
+            record.index_number     = reader.readI32( Utilities::Buffer::Endian::LITTLE );
+
+            for( size_t i = 0; i < Resource::RPNS_OFFSET_AMOUNT; i++ )
+                record.rpns_offsets[ i ] = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+
+            for( size_t i = 0; i < Resource::CODE_AMOUNT; i++ )
+                record.code_sizes[ i ] = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+
+            record.swvr_entry.offset     = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+            record.swvr_entry.tos_offset = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+            record.swvr_entry.name       = readString( reader );
+
+            record.header_span = readSpan( reader );
+
+            const uint32_t span_amount = reader.readU32( Utilities::Buffer::Endian::LITTLE );
+
+            record.spans.reserve( std::min<size_t>( span_amount, reader.getPosition( Utilities::Buffer::END ) / SPAN_SIZE ) );
+
+            for( uint32_t i = 0; i < span_amount; i++ ) {
+                record.spans.push_back( readSpan( reader ) );
+
+                if( !isInside( record.spans.back(), key.size ) ) {
+                    records.clear();
+                    return false;
+                }
+            }
+
+            if( record.kind > MDEC || !isInside( record.header_span, key.size ) ) {
+                records.clear();
+                return false;
+            }
+
+            records.push_back( record );
+        }
+    }
+    catch( const Utilities::Buffer::BufferOutOfBounds & ) {
+        // The index file is truncated.
+        records.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool IFFIndex::write( const std::filesystem::path &index_path, const std::filesystem::path &iff_path ) const {
+    IndexKey key;
+
+    if( !getIndexKey( iff_path, key ) )
+        return false;
+
+    Utilities::Buffer buffer;
+
+    buffer.addU32( INDEX_TAG, Utilities::Buffer::Endian::LITTLE );
+    buffer.addU32( VERSION,   Utilities::Buffer::Endian::LITTLE );
+    addString( buffer, key.path );
+    buffer.addU64( key.size, Utilities::Buffer::Endian::LITTLE );
+    buffer.addI64( key.modification_time, Utilities::Buffer::Endian::LITTLE );
+    buffer.addU8( endian );
+    buffer.addU32( records.size(), Utilities::Buffer::Endian::LITTLE );
+
+    for( const Record &record : records ) {
+        buffer.addU8( record.kind );
+        buffer.addU32( record.tag,              Utilities::Buffer::Endian::LITTLE );
+        buffer.addU32( record.resource_id,      Utilities::Buffer::Endian::LITTLE );
+        buffer.addU32( record.offset,           Utilities::Buffer::Endian::LITTLE );
+        buffer.addI32( record.mis_index_number, Utilities::Buffer::Endian::LITTLE );
+        buffer.addI32( record.index_number,     Utilities::Buffer::Endian::LITTLE );
+
+        for( size_t i = 0; i < Resource::RPNS_OFFSET_AMOUNT; i++ )
+            buffer.addU32( record.rpns_offsets[ i ], Utilities::Buffer::Endian::LITTLE );
+
+        for( size_t i = 0; i < Resource::CODE_AMOUNT; i++ )
+            buffer.addU32( record.code_sizes[ i ], Utilities::Buffer::Endian::LITTLE );
+
+        buffer.addU32( record.swvr_entry.offset,     Utilities::Buffer::Endian::LITTLE );
+        buffer.addU32( record.swvr_entry.tos_offset, Utilities::Buffer::Endian::LITTLE );
+        addString( buffer, record.swvr_entry.name );
+
+        addSpan( buffer, record.header_span );
+
+        buffer.addU32( record.spans.size(), Utilities::Buffer::Endian::LITTLE );
+
+        for( const Span &span : record.spans )
+            addSpan( buffer, span );
+    }
+
+    return buffer.write( index_path );
+}
+
+}
@@ -0,0 +1,85 @@
+#ifndef DATA_MISSION_IFF_INDEX_HEADER
+#define DATA_MISSION_IFF_INDEX_HEADER
+
+#include "Resource.h"
+#include "../../Utilities/Buffer.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace Data::Mission {
+
+/**
+ * This is the sidecar file that lets IFF::open skip the chunk scan.
+ *
+ * It stores where every resource is inside the IFF file and the header values that the chunk scan would find.
+ * The index is keyed by the path, the size and the modification time of the IFF file, so a changed IFF file invalidates it.
+ */
+class IFFIndex {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static const std::filesystem::path FILE_EXTENSION;
+
+    // This tells which chunks made the resource.
+    enum Kind : uint8_t {
+        SHOC = 0,
+        MSIC = 1,
+        VAGM = 2,
+        VAGB = 3,
+        MDEC = 4
+    };
+
+    // A range of bytes in the IFF file.
+    struct Span {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct Record {
+        Kind kind;
+        uint32_t tag;
+        uint32_t resource_id; // The resource id as read from the header, not getResourceID().
+        uint32_t offset;
+        int32_t  mis_index_number;
+        int32_t  index_number;
+        uint32_t rpns_offsets[ Resource::RPNS_OFFSET_AMOUNT ];
+        uint32_t code_sizes[ Resource::CODE_AMOUNT ];
+        Resource::SWVREntry swvr_entry;
+
+        Span header_span; // The SHDR bytes past the known fields. Only the stream reader keeps them.
+        std::vector<Span> spans; // The data of the resource in order.
+    };
+
+    Utilities::Buffer::Endian endian;
+    std::vector<Record> records;
+
+    IFFIndex();
+
+    /**
+     * @param iff_path The path to the IFF file.
+     * @param directory The directory of the index file. If empty, the index is placed next to the IFF file.
+     * @return The path of the index file.
+     */
+    static std::filesystem::path getIndexPath( const std::filesystem::path &iff_path, const std::filesystem::path &directory );
+
+    /**
+     * This reads the index file and checks if it still matches the IFF file.
+     * @param index_path The path of the index file.
+     * @param iff_path The path of the IFF file that the index must match.
+     * @return True if the index got read and it matches the current IFF file.
+     */
+    bool read( const std::filesystem::path &index_path, const std::filesystem::path &iff_path );
+
+    /**
+     * This writes the index file.
+     * @param index_path The path of the index file.
+     * @param iff_path The path of the IFF file to key the index with.
+     * @return True if the index got written.
+     */
+    bool write( const std::filesystem::path &index_path, const std::filesystem::path &iff_path ) const;
+};
+
+}
+
+#endif // DATA_MISSION_IFF_INDEX_HEADER
@@ -1,5 +1,7 @@
 #include "IFFOptions.h"
 
+#include "../../Utilities/Buffer.h"
+
 namespace {
 
 bool hasExtraOf( std::string key_value, const std::map<std::string, std::vector<std::string>> arguments, std::ostream *output_r ) {
@@ -17,10 +19,10 @@ bool hasExtraOf( std::string key_value, const std::map<std::string, std::vector<
 
 namespace Data::Mission {
 
-IFFOptions::IFFOptions() : enable_global_dry_default( false ) {
+IFFOptions::IFFOptions() : enable_global_dry_default( false ), enable_glb( false ), enable_quantization( false ), enable_weld( false ), thread_amount( 1 ), png_compression_level( -1 ) {
 }
 
-IFFOptions::IFFOptions( const std::vector<std::string> & arguments, std::ostream *output_r ) : enable_global_dry_default( false ) {
+IFFOptions::IFFOptions( const std::vector<std::string> & arguments, std::ostream *output_r ) : enable_global_dry_default( false ), enable_glb( false ), enable_quantization( false ), enable_weld( false ), thread_amount( 1 ), png_compression_level( -1 ) {
     readParams( arguments, output_r );
 }
 
@@ -66,6 +68,10 @@ bool IFFOptions::readParams( const std::vector<std::string> &raw_arguments, std:
     }
 
     enable_global_dry_default = false;
+    enable_glb = false;
+    enable_quantization = false;
+    enable_weld = false;
+    png_compression_level = -1;
 
     invalid_parameters        |= aiff.readParams( arguments, output_r );
     enable_global_dry_default |= aiff.override_dry;
@@ -133,6 +139,30 @@ bool IFFOptions::readParams( const std::vector<std::string> &raw_arguments, std:
         }
     }
 
+    if( !singleArgument( arguments, "--GLB", output_r, enable_glb ) )
+        invalid_parameters |= true;
+
+    if( !singleArgument( arguments, "--QUANTIZE", output_r, enable_quantization ) )
+        invalid_parameters |= true;
+
+    if( !singleArgument( arguments, "--WELD", output_r, enable_weld ) )
+        invalid_parameters |= true;
+
+    auto png_level = arguments.find( "--PNG_LEVEL" );
+
+    if( png_level != arguments.end() ) {
+        if( png_level->second.size() == 1 && png_level->second[0].size() == 1 && png_level->second[0][0] >= '0' && png_level->second[0][0] <= '9' )
+            png_compression_level = png_level->second[0][0] - '0';
+        else {
+            if( output_r != nullptr )
+                *output_r << "--PNG_LEVEL needs one level from 0 to 9." << std::endl;
+
+            invalid_parameters |= true;
+        }
+
+        arguments.erase( png_level );
+    }
+
 
     if( !arguments.empty() ) {
         if( output_r != nullptr ) {
@@ -186,10 +216,62 @@ bool IFFOptions::singleArgument( std::map<std::string, std::vector<std::string>>
     return true; // Successfully executed.
 }
 
+uint64_t IFFOptions::getDigest() const {
+    Utilities::Buffer buffer;
+
+    buffer.addU8( enable_global_dry_default );
+    buffer.addU8( enable_glb );
+    buffer.addU8( enable_quantization );
+    buffer.addU8( enable_weld );
+    buffer.addI8( png_compression_level );
+
+    buffer.addU8( aiff.override_dry );
+    buffer.addU8( aiff.to_wav );
+    buffer.addU8( act.override_dry );
+    buffer.addU8( anm.override_dry );
+    buffer.addU8( anm.export_palette );
+    buffer.addU8( bmp.override_dry );
+    buffer.addU8( bmp.export_palette );
+    buffer.addU8( dcs.override_dry );
+    buffer.addU8( font.override_dry );
+    buffer.addU8( fun.override_dry );
+    buffer.addU8( msic.override_dry );
+    buffer.addU8( net.override_dry );
+    buffer.addU8( net.enable_obj );
+    buffer.addU8( obj.override_dry );
+    buffer.addU8( obj.no_model );
+    buffer.addU8( obj.export_metadata );
+    buffer.addU8( obj.export_bounding_box );
+    buffer.addU8( ptc.override_dry );
+    buffer.addU8( ptc.no_model );
+    buffer.addU8( ptc.entire_point_cloud );
+    buffer.addU8( ptc.entire_height_map );
+    buffer.addU8( ptc.enable_backface_culling );
+    buffer.addU8( pyr.override_dry );
+    buffer.addU8( pyr.export_prime_bw );
+    buffer.addU8( pyr.export_palettless_atlas );
+    buffer.addU8( rpns.override_dry );
+    buffer.addU8( snds.override_dry );
+    buffer.addU8( til.override_dry );
+    buffer.addU8( til.export_metadata );
+    buffer.addU8( til.enable_point_cloud_export );
+    buffer.addU8( til.enable_height_map_export );
+    buffer.addU8( til.enable_til_export_model );
+    buffer.addU8( til.enable_til_backface_culling );
+    buffer.addU8( wav.override_dry );
+    buffer.addU8( wav.reencode_wav );
+
+    return buffer.getHash();
+}
+
 std::string IFFOptions::getOptions() const {
     std::string option_dialog;
 
     option_dialog += "  --DRY      Do not export any decoded and raw files. Do not use with ENABLE commands\n";
+    option_dialog += "  --GLB      Write the models as binary glTF (.glb) files instead of .gltf and .bin files\n";
+    option_dialog += "  --QUANTIZE Write the static models with short positions and byte normals and colors (KHR_mesh_quantization)\n";
+    option_dialog += "  --WELD     Weld the duplicate vertices of the models, and write the models with index buffers\n";
+    option_dialog += "  --PNG_LEVEL <0-9> The zlib level of the PNG files, 0 is the fastest and 9 is the smallest\n";
     option_dialog += "  --*_ENABLE This sets specific resources to be exported rather than decoding them all. WARNING: This disables raw output\n";
     option_dialog += aiff.getOptions();
     option_dialog +=  act.getOptions();
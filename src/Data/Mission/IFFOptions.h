@@ -1,6 +1,7 @@
 #ifndef DATA_MISSION_IFF_OPTIONS_HEADER
 #define DATA_MISSION_IFF_OPTIONS_HEADER
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <ostream>
@@ -21,6 +22,13 @@ struct IFFOptions {
 
     std::string getOptions() const;
 
+    /**
+     * This makes a hash of every option, so an export can tell if it was made with the same options.
+     * @note A new option must also be added to this method.
+     * @return The hash of the options.
+     */
+    uint64_t getDigest() const;
+
     struct ResourceOption {
         bool override_dry;
 
@@ -39,6 +47,11 @@ struct IFFOptions {
 
     // This area stores the actual options.
     bool enable_global_dry_default;
+    bool enable_glb; // If true, the models are written as binary glTF files.
+    bool enable_quantization; // If true, the models that can be are written with the KHR_mesh_quantization extension.
+    bool enable_weld; // If true, the duplicate vertices of the models are welded, and the models are written with an index buffer.
+    unsigned thread_amount; // The amount of threads that one resource may use to write itself. It is not an argument, and it is not in getDigest since it does not change the output.
+    int png_compression_level; // The zlib level of the written PNG files from 0 to 9, or -1 for the default of zlib.
 
     // This is the the option to other resources.
 
@@ -12,6 +12,9 @@
 #include <iostream>
 
 namespace {
+    // 4DVL and 4DNL are read straight into arrays of i16vec3.
+    static_assert( sizeof( glm::i16vec3 ) == 3 * sizeof( uint16_t ), "glm::i16vec3 must be tightly packed." );
+
     // The header
     const uint32_t TAG_4DGI = 0x34444749; // which is { 0x34, 0x44, 0x47, 0x49 } or { '4', 'D', 'G', 'I' } or "4DGI"
     // Texture reference list
@@ -1192,6 +1195,44 @@ Data::Mission::ObjResource::ObjResource() {
     this->bone_frames = 0;
     this->max_bone_childern = 0;
     this->bone_animation_data = nullptr;
+    this->bone_animation_data_size = 0;
+}
+
+Data::Mission::ObjResource::ObjResource( const ObjResource &obj ) : ModelResource( obj ),
+    info( obj.info ), vertex_data( obj.vertex_data ),
+    face_types( obj.face_types ), face_type_overrides( obj.face_type_overrides ), override_uvs( obj.override_uvs ), face_color_overrides( obj.face_color_overrides ),
+    num_vertex_position_channel( obj.num_vertex_position_channel ), vertex_position_data( obj.vertex_position_data ),
+    primitives( obj.primitives ),
+    bones( obj.bones ), max_bone_childern( obj.max_bone_childern ), bone_frames( obj.bone_frames ), bone_animation_data( nullptr ), bone_animation_data_size( obj.bone_animation_data_size ),
+    baked_bone_poses( obj.baked_bone_poses ), baked_bone_matrices( obj.baked_bone_matrices ),
+    bounding_box_per_frame( obj.bounding_box_per_frame ), bounding_box_frames( obj.bounding_box_frames ), bounding_boxes( obj.bounding_boxes ),
+    texture_references( obj.texture_references )
+{
+    for( unsigned i = 0; i < 4; i++ )
+        position_indexes[ i ] = obj.position_indexes[ i ];
+
+    if( obj.bone_animation_data != nullptr ) {
+        bone_animation_data = new int16_t [ bone_animation_data_size ];
+        std::copy( obj.bone_animation_data, obj.bone_animation_data + bone_animation_data_size, bone_animation_data );
+    }
+
+    // The parents must point to the bones of this resource, not to the bones of obj.
+    for( size_t i = 0; i < bones.size(); i++ ) {
+        if( obj.bones[ i ].parent_r != nullptr )
+            bones[ i ].parent_r = bones.data() + (obj.bones[ i ].parent_r - obj.bones.data());
+    }
+
+    // The same goes for the face types of the primitives.
+    for( auto &primitive : primitives ) {
+        if( primitive.face_type_r != nullptr ) {
+            auto face_type = face_types.find( primitive.face_type_offset );
+
+            if( face_type != face_types.end() )
+                primitive.face_type_r = &face_type->second;
+            else
+                primitive.face_type_r = nullptr;
+        }
+    }
 }
 
 Data::Mission::ObjResource::~ObjResource() {
@@ -1776,8 +1817,7 @@ bool Data::Mission::ObjResource::parse( const ParseSettings &settings ) {
                 
                 this->bone_animation_data = new int16_t [ this->bone_animation_data_size ];
                 
-                for( size_t d = 0; d < this->bone_animation_data_size; d++ )
-                    this->bone_animation_data[ d ] = reader3DMI.readU16( settings.endian );
+                reader3DMI.readU16Array( reinterpret_cast<uint16_t*>( this->bone_animation_data ), this->bone_animation_data_size, settings.endian );
             }
             else
             if( identifier == TAG_3DAL ) {
@@ -1907,12 +1947,8 @@ bool Data::Mission::ObjResource::parse( const ParseSettings &settings ) {
                     file_is_not_valid = true;
                 }
                 else {
-                    for( unsigned int i = 0; i < amount_of_vertices; i++ ) {
-                        positions_r[i].x = reader4DVL.readI16( settings.endian );
-                        positions_r[i].y = reader4DVL.readI16( settings.endian );
-                        positions_r[i].z = reader4DVL.readI16( settings.endian );
-                        reader4DVL.readI16( settings.endian );
-                    }
+                    // Every position is stored as x, y, z and a padding value.
+                    reader4DVL.readU16Records( reinterpret_cast<uint16_t*>( positions_r ), amount_of_vertices, 3, 4, settings.endian );
                 }
             }
             else
@@ -1939,12 +1975,8 @@ bool Data::Mission::ObjResource::parse( const ParseSettings &settings ) {
                     file_is_not_valid = true;
                 }
                 else if(normals_r != nullptr) {
-                    for( unsigned int i = 0; i < amount_of_normals; i++ ) {
-                        normals_r[i].x = reader4DNL.readI16( settings.endian );
-                        normals_r[i].y = reader4DNL.readI16( settings.endian );
-                        normals_r[i].z = reader4DNL.readI16( settings.endian );
-                        reader4DNL.readI16( settings.endian );
-                    }
+                    // Every normal is stored as x, y, z and a padding value.
+                    reader4DNL.readU16Records( reinterpret_cast<uint16_t*>( normals_r ), amount_of_normals, 3, 4, settings.endian );
                 }
             }
             else
@@ -1971,11 +2003,8 @@ bool Data::Mission::ObjResource::parse( const ParseSettings &settings ) {
                     error_log.output << "3DRL: Cannot find identifier " << frame_id << " for normals.\n";
                     file_is_not_valid = true;
                 }
-                else if(length_data_r != nullptr) {
-                    for( uint32_t i = 0; i < count; i++ ) {
-                        length_data_r[i] = reader3DRL.readU16(settings.endian);
-                    }
-                }
+                else if(length_data_r != nullptr)
+                    reader3DRL.readU16Array(length_data_r, count, settings.endian);
             }
             else
             if( identifier == TAG_AnmD ) {
@@ -2196,6 +2225,8 @@ bool Data::Mission::ObjResource::parse( const ParseSettings &settings ) {
                 error_log.output << "4DGI bounding_box_frames = " << std::dec << bounding_box_frames << "\n";
         }
 
+        bakeBonePoses();
+
         for( auto &primitive : this->primitives ) {
             if( primitive.type != PrimitiveType::STAR && this->face_types.find( primitive.face_type_offset ) != this->face_types.end() ) {
                 primitive.face_type_r = &this->face_types[ primitive.face_type_offset ];
@@ -2267,10 +2298,7 @@ glm::vec3 Data::Mission::ObjResource::getPosition( unsigned position_index, unsi
     return position;
 }
 
-Data::Mission::ObjResource::DecodedBone Data::Mission::ObjResource::getBone( unsigned bone_index, unsigned frame_index ) const {
-    if(bone_index >= bones.size())
-        return DecodedBone();
-
+Data::Mission::ObjResource::DecodedBone Data::Mission::ObjResource::decodeBone( unsigned bone_index, unsigned frame_index ) const {
     DecodedBone decoded_bone = this->bones[ bone_index ].decode(this->bone_animation_data, frame_index);
 
     if(this->bones[ bone_index ].parent_r != nullptr) {
@@ -2292,6 +2320,82 @@ Data::Mission::ObjResource::DecodedBone Data::Mission::ObjResource::getBone( uns
     return decoded_bone;
 }
 
+void Data::Mission::ObjResource::bakeBonePoses() {
+    baked_bone_poses.clear();
+    baked_bone_matrices.clear();
+
+    if( bones.empty() || bone_frames == 0 || bone_animation_data == nullptr )
+        return;
+
+    const unsigned bone_amount = bones.size();
+
+    // Order the bones so every parent comes before its children.
+    std::vector<unsigned> bone_order;
+    std::vector<bool> is_ordered( bone_amount, false );
+    std::vector<unsigned> chain;
+
+    bone_order.reserve( bone_amount );
+
+    for( unsigned b = 0; b < bone_amount; b++ ) {
+        for( const Bone *bone_r = &bones[ b ]; bone_r != nullptr; bone_r = bone_r->parent_r ) {
+            const unsigned index = bone_r - bones.data();
+
+            if( index >= bone_amount || is_ordered[ index ] )
+                break;
+
+            chain.push_back( index );
+        }
+
+        for( auto index = chain.rbegin(); index != chain.rend(); index++ ) {
+            is_ordered[ *index ] = true;
+            bone_order.push_back( *index );
+        }
+
+        chain.clear();
+    }
+
+    baked_bone_poses.resize( bone_frames * bone_amount );
+    baked_bone_matrices.resize( bone_frames * bone_amount );
+
+    for( unsigned frame = 0; frame < bone_frames; frame++ ) {
+        DecodedBone *const poses_r = baked_bone_poses.data() + frame * bone_amount;
+        glm::mat4 *const matrices_r = baked_bone_matrices.data() + frame * bone_amount;
+
+        for( const unsigned b : bone_order ) {
+            const DecodedBone decoded_bone = bones[ b ].decode( bone_animation_data, frame );
+
+            if( bones[ b ].parent_r != nullptr && static_cast<unsigned>( bones[ b ].parent_r - bones.data() ) < bone_amount ) {
+                const glm::mat4 &parent_matrix = matrices_r[ bones[ b ].parent_r - bones.data() ];
+
+                poses_r[ b ]    = decoded_bone.transform( parent_matrix );
+                matrices_r[ b ] = parent_matrix * decoded_bone.toMatrix();
+            }
+            else {
+                poses_r[ b ]    = decoded_bone;
+                matrices_r[ b ] = decoded_bone.toMatrix();
+            }
+        }
+    }
+}
+
+Data::Mission::ObjResource::DecodedBone Data::Mission::ObjResource::getBone( unsigned bone_index, unsigned frame_index ) const {
+    if(bone_index >= bones.size())
+        return DecodedBone();
+
+    if( frame_index < bone_frames && !baked_bone_poses.empty() )
+        return baked_bone_poses[ frame_index * bones.size() + bone_index ];
+
+    // Frames outside of the animation are still decoded the old way.
+    return decodeBone( bone_index, frame_index );
+}
+
+const glm::mat4* Data::Mission::ObjResource::getBoneMatrices( unsigned frame_index ) const {
+    if( frame_index >= bone_frames || baked_bone_matrices.empty() )
+        return nullptr;
+
+    return baked_bone_matrices.data() + frame_index * bones.size();
+}
+
 int Data::Mission::ObjResource::write( const std::filesystem::path& file_path, const Data::Mission::IFFOptions &iff_options ) const {
     int glTF_return = 0;
 
@@ -2313,7 +2417,17 @@ int Data::Mission::ObjResource::write( const std::filesystem::path& file_path, c
                 if( !bones.empty() )
                     model_output_p->applyJointTransforms( 0 );
 
-                glTF_return = model_output_p->write( file_path, "cobj_" + std::to_string( getResourceID() ) );
+                // Models with bones or morph frames stay as floats.
+                if( iff_options.enable_quantization )
+                    model_output_p->quantize();
+
+                if( iff_options.enable_weld )
+                    model_output_p->weld();
+
+                if( iff_options.enable_glb )
+                    glTF_return = model_output_p->writeGLB( file_path, "cobj_" + std::to_string( getResourceID() ) );
+                else
+                    glTF_return = model_output_p->write( file_path, "cobj_" + std::to_string( getResourceID() ) );
             }
             else {
                 // Make it easier on the user to identify empty Obj's
@@ -2338,7 +2452,16 @@ int Data::Mission::ObjResource::write( const std::filesystem::path& file_path, c
                 std::filesystem::path full_file_path = file_path;
                 full_file_path += "_bb";
 
-                bounding_boxes_p->write( full_file_path, "cobj_" + std::to_string( getResourceID() )+ "_bb"  );
+                if( iff_options.enable_quantization )
+                    bounding_boxes_p->quantize();
+
+                if( iff_options.enable_weld )
+                    bounding_boxes_p->weld();
+
+                if( iff_options.enable_glb )
+                    bounding_boxes_p->writeGLB( full_file_path, "cobj_" + std::to_string( getResourceID() )+ "_bb"  );
+                else
+                    bounding_boxes_p->write( full_file_path, "cobj_" + std::to_string( getResourceID() )+ "_bb"  );
 
                 delete bounding_boxes_p;
             }
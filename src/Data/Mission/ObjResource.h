@@ -291,6 +291,11 @@ private:
     unsigned int              bone_frames;
     int16_t                  *bone_animation_data; // Where the animation data is stored.
     unsigned int              bone_animation_data_size;
+
+    // These are the world space poses of every bone for every frame, which getBone and getBoneMatrices return.
+    // They are frame-major, so every frame is bones.size() elements long.
+    std::vector<DecodedBone>  baked_bone_poses;
+    std::vector<glm::mat4>    baked_bone_matrices;
     
     unsigned int bounding_box_per_frame;
     unsigned int bounding_box_frames;
@@ -306,8 +311,23 @@ private:
      */
     static unsigned int getOpcodeBytesPerFrame( Bone::Opcode opcode );
 
+    /**
+     * This decodes a bone by walking through all of its parents.
+     * @param bone_index The index of the bone, which must be valid.
+     * @param frame_index The frame of the animation.
+     * @return The bone in world space.
+     */
+    DecodedBone decodeBone( unsigned bone_index, unsigned frame_index ) const;
+
+    /**
+     * This fills baked_bone_poses and baked_bone_matrices for every frame.
+     * Every bone is decoded once per frame, and its parent is always done before it.
+     */
+    void bakeBonePoses();
+
 public:
     ObjResource();
+    ObjResource( const ObjResource &obj );
     virtual ~ObjResource();
 
     virtual std::filesystem::path getFileExtension() const;
@@ -322,8 +342,29 @@ public:
 
     glm::vec3 getPosition( unsigned index, unsigned frame_index ) const;
 
+    /**
+     * @param bone_index The index of the bone.
+     * @param frame_index The frame of the animation.
+     * @return The bone in world space. This is a lookup for every frame of the animation.
+     */
     DecodedBone getBone( unsigned bone_index, unsigned frame_index ) const;
 
+    /**
+     * @return The amount of bones, which is also the amount of matrices in a frame of getBoneMatrices.
+     */
+    unsigned getNumBones() const { return bones.size(); }
+
+    /**
+     * @return The amount of frames of the bone animation.
+     */
+    unsigned getNumBoneFrames() const { return bone_frames; }
+
+    /**
+     * @param frame_index The frame of the animation.
+     * @return A pointer to the getNumBones() world space matrices of the frame, or a nullptr if the frame is out of bounds or there are no bones.
+     */
+    const glm::mat4* getBoneMatrices( unsigned frame_index ) const;
+
     const std::vector<FaceOverrideType>& getFaceOverrideTypes() const { return face_type_overrides; }
     const std::vector<glm::u8vec2>& getFaceOverrideData() const { return override_uvs; }
     const std::vector<VertexColorOverride>& getVertexColorOverrides() const { return face_color_overrides; }
@@ -2,6 +2,7 @@
 
 #include "../../Utilities/ImageFormat/Chooser.h"
 #include "../../Utilities/ModelBuilder.h"
+#include "../../Utilities/Parallel.h"
 #include <string>
 #include <algorithm>
 
@@ -136,7 +137,7 @@ Data::Mission::Resource * Data::Mission::PTCResource::duplicate() const {
 }
 
 int Data::Mission::PTCResource::write( const std::filesystem::path& file_path, const Data::Mission::IFFOptions &iff_options ) const {
-    Utilities::ImageFormat::Chooser chooser;
+    Utilities::ImageFormat::Chooser chooser( iff_options.png_compression_level, iff_options.thread_amount );
 
     if( iff_options.ptc.shouldWrite( iff_options.enable_global_dry_default ) ) {
         if( iff_options.ptc.entire_point_cloud ) {
@@ -183,7 +184,7 @@ int Data::Mission::PTCResource::write( const std::filesystem::path& file_path, c
 
         if( !iff_options.ptc.no_model ) {
             // Write the entire map.
-            return writeEntireMap( file_path, iff_options.ptc.enable_backface_culling );
+            return writeEntireMap( file_path, iff_options.ptc.enable_backface_culling, iff_options.enable_glb, iff_options.enable_quantization, iff_options.enable_weld, iff_options.thread_amount );
         }
         else
             return 1;
@@ -192,29 +193,37 @@ int Data::Mission::PTCResource::write( const std::filesystem::path& file_path, c
         return 0;
 }
 
-int Data::Mission::PTCResource::writeEntireMap( const std::filesystem::path& file_path, bool make_culled ) const {
+int Data::Mission::PTCResource::writeEntireMap( const std::filesystem::path& file_path, bool make_culled, bool is_binary, bool is_quantized, bool is_welded, unsigned thread_amount ) const {
     // Write the entire map
     std::vector<Utilities::ModelBuilder*> map_tils;
 
+    const unsigned tile_amount = getWidth() * getHeight();
+
     for( unsigned i = 0; i < 8; i++ ) {
-        // This is to combine single textured tils into one.
-        std::vector<Utilities::ModelBuilder*> texture_tils;
+        // Every til gets its own slot, so the partials keep the order of the tils no matter which thread made them.
+        std::vector<Utilities::ModelBuilder*> partial_slots( tile_amount, nullptr );
 
         // Go through every til.
-        for( unsigned w = 0; w < getWidth(); w++ ) {
+        Utilities::Parallel::forEach( tile_amount, thread_amount, [this, i, make_culled, &partial_slots]( size_t index ) {
+            const unsigned w = index / getHeight();
+            const unsigned h = index % getHeight();
+
             float x = static_cast<float>(w) - (static_cast<float>(getWidth()) / 2.0f);
+            float y = static_cast<float>(h) - (static_cast<float>(getHeight()) / 2.0f);
+            auto tile_r = getTile( w, h );
 
-            for( unsigned h = 0; h < getHeight(); h++ ) {
-                float y = static_cast<float>(h) - (static_cast<float>(getHeight()) / 2.0f);
-                auto tile_r = getTile( w, h );
+            if( tile_r != nullptr )
+                partial_slots[ index ] = tile_r->createPartial( i, make_culled, false, -y * 16.0f, -x * 16.0f );
+        } );
 
-                if( tile_r != nullptr ) {
-                    auto model_p = tile_r->createPartial( i, make_culled, false, -y * 16.0f, -x * 16.0f );
+        // This is to combine single textured tils into one.
+        std::vector<Utilities::ModelBuilder*> texture_tils;
 
-                    if( model_p != nullptr )
-                        texture_tils.push_back( model_p );
-                }
-            }
+        texture_tils.reserve( tile_amount );
+
+        for( auto model_p : partial_slots ) {
+            if( model_p != nullptr )
+                texture_tils.push_back( model_p );
         }
 
         // Combine every texture in common texture into one.
@@ -244,7 +253,20 @@ int Data::Mission::PTCResource::writeEntireMap( const std::filesystem::path& fil
     if( combine_model_p == nullptr )
         return -1; // There is no model to write.
 
-    if( combine_model_p->write( file_path ) )
+    bool is_written;
+
+    if( is_quantized )
+        combine_model_p->quantize();
+
+    if( is_welded )
+        combine_model_p->weld();
+
+    if( is_binary )
+        is_written = combine_model_p->writeGLB( file_path );
+    else
+        is_written = combine_model_p->write( file_path );
+
+    if( is_written )
         return 1; // The whole map had been written to the "disk"
     else
         return 0; // Combine model has failed to write.
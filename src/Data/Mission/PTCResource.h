@@ -81,7 +81,17 @@ public:
      */
     virtual int write( const std::filesystem::path& file_path, const Data::Mission::IFFOptions &iff_options = IFFOptions() ) const;
     
-    int writeEntireMap( const std::filesystem::path& file_path, bool make_culled = false ) const;
+    /**
+     * This writes every Til of the map as one model.
+     * @param file_path The path of the model without the extension.
+     * @param make_culled If true, the back faces of the map are culled.
+     * @param is_binary If true, the model is written as a binary glTF file.
+     * @param is_quantized If true, the model is written with the KHR_mesh_quantization extension.
+     * @param is_welded If true, the duplicate vertices of the model are welded into an index buffer.
+     * @param thread_amount The amount of threads that build the partial models of the tils. Zero means every hardware thread.
+     * @return 1 if the map is written, 0 if the write failed, and -1 if there is no model to write.
+     */
+    int writeEntireMap( const std::filesystem::path& file_path, bool make_culled = false, bool is_binary = false, bool is_quantized = false, bool is_welded = false, unsigned thread_amount = 1 ) const;
     
     float getRayCast3D( const Utilities::Collision::Ray &ray, unsigned level ) const; // TODO Implement this one.
     float getRayCast2D( float x, float y, unsigned level = 0) const;
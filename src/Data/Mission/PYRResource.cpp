@@ -406,7 +406,7 @@ Data::Mission::Resource * Data::Mission::PYRResource::duplicate() const {
 
 int Data::Mission::PYRResource::write( const std::filesystem::path& file_path, const Data::Mission::IFFOptions &iff_options ) const {
     int return_value = 0;
-    Utilities::ImageFormat::Chooser chooser;
+    Utilities::ImageFormat::Chooser chooser( iff_options.png_compression_level, iff_options.thread_amount );
 
     Utilities::Buffer buffer;
 
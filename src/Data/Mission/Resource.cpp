@@ -1,6 +1,7 @@
 #include "Resource.h"
 
 #include <cassert>
+#include <cstring>
 #include <fstream>
 
 namespace Data {
@@ -17,14 +18,15 @@ Utilities::Buffer::Reader Resource::getDataReader() const {
     return this->data->getReader( this->header_size );
 }
 
-Resource::Resource() : mis_index_number( -1 ), index_number( -1 ), offset( 0 ), resource_id( 0 ), rpns_offsets{0, 0, 0}, code_sizes{0, 0}, swvr_entry(), header_size(0), data(nullptr) {
+Resource::Resource() : mis_index_number( -1 ), index_number( -1 ), offset( 0 ), resource_id( 0 ), rpns_offsets{0, 0, 0}, code_sizes{0, 0}, swvr_entry(), is_parsed( true ), parse_status( true ), content_hash( 0 ), header_size(0), data(nullptr) {
 }
 
 Resource::Resource( const Resource &obj ) :
     mis_index_number( obj.mis_index_number ), index_number( obj.index_number ), offset( obj.offset ), resource_id( obj.resource_id ), rpns_offsets{obj.rpns_offsets[0],
     obj.rpns_offsets[1], obj.rpns_offsets[2]}, code_sizes{obj.code_sizes[0], obj.code_sizes[1]},
     swvr_entry( obj.swvr_entry ),
-    header_size(obj.header_size), data(nullptr) {
+    deferred_settings( obj.deferred_settings ), is_parsed( obj.isParsed() ), parse_status( obj.parse_status ),
+    content_hash( obj.content_hash.load( std::memory_order_relaxed ) ), header_size(obj.header_size), data(nullptr) {
 
     if(obj.data != nullptr) {
         data = std::make_unique<Utilities::Buffer>(*obj.data);
@@ -82,50 +84,70 @@ std::filesystem::path Resource::getFullName( unsigned int index ) const {
     return full_name;
 }
 
+void Resource::deferParse( const ParseSettings &settings ) {
+    std::lock_guard<std::mutex> guard( parse_lock );
+
+    deferred_settings = settings;
+    parse_status = false;
+    is_parsed.store( false, std::memory_order_release );
+}
+
+bool Resource::ensureParsed() const {
+    if( is_parsed.load( std::memory_order_acquire ) )
+        return parse_status;
+
+    std::lock_guard<std::mutex> guard( parse_lock );
+
+    // Another thread might have parsed this resource while this thread waited for the lock.
+    if( !is_parsed.load( std::memory_order_relaxed ) ) {
+        // The deferred parse only fills in the decoded data, so it is allowed to happen through a const resource.
+        parse_status = const_cast<Resource*>( this )->parse( deferred_settings );
+
+        is_parsed.store( true, std::memory_order_release );
+    }
+
+    return parse_status;
+}
+
 Resource* Resource::genResourceByType( const Utilities::Buffer::Reader &data ) const {
     return duplicate();
 }
 
 void Resource::setMemory( Utilities::Buffer *data_p ) {
     this->data = std::unique_ptr<Utilities::Buffer>(data_p);
+    this->content_hash = 0;
 }
 
-int Resource::read( const std::filesystem::path& file_path ) {
-    std::ifstream resource;
+uint64_t Resource::getContentHash() const {
+    if( data == nullptr )
+        return 0;
 
-    resource.open(file_path, std::ios::binary | std::ios::in | std::ios::ate );
+    uint64_t hash = content_hash.load( std::memory_order_relaxed );
 
-    if( resource.is_open() ) // Make sure that the file is opened.
-    {
-        size_t size = resource.tellg();
+    // Two threads could compute the hash at the same time, but they would get the same value.
+    if( hash == 0 ) {
+        hash = data->getHash();
 
-        // Return to the beginning.
-        resource.seekg( 0, std::ios::beg );
-        
-        this->data = std::make_unique<Utilities::Buffer>();
+        // Zero is taken to mean not computed.
+        if( hash == 0 )
+            hash = 1;
 
-        // TODO make these operations faster expand the raw_data, so it does not have to reallocate data.
-        this->data->reserve( size );
+        content_hash.store( hash, std::memory_order_relaxed );
+    }
 
-        // This will store the byte.
-        char byte = 0;
+    return hash;
+}
 
-        for( size_t i = 0; i < size; i++ )
-        {
-            resource.get( byte );
+int Resource::read( const std::filesystem::path& file_path ) {
+    auto data_p = std::make_unique<Utilities::Buffer>();
 
-            this->data->addI8( byte );
-        }
+    // The whole file is read into memory at once.
+    if( !data_p->read( file_path ) )
+        return 0;
 
-        // The resource is complety read into memory.
-        resource.close();
+    this->data = std::move( data_p );
 
-        return 1;
-    }
-    else
-    {
-        return 0;
-    }
+    return 1;
 }
 
 int Resource::read( Utilities::Buffer::Reader& reader ) {
@@ -139,9 +161,9 @@ int Resource::read( Utilities::Buffer::Reader& reader ) {
         this->data = std::make_unique<Utilities::Buffer>();
         
         // Add all the information that the reader has to this resource.
-        while( !reader.ended() ) {
-            this->data->addU8( reader.readU8() );
-        }
+        const size_t byte_amount = reader.getPosition( Utilities::Buffer::Direction::END );
+
+        this->data->add( reader.readSpan( byte_amount ), byte_amount );
 
         return 1; // Successfully read the resource.
     }
@@ -163,9 +185,9 @@ int Resource::writeRaw( const std::filesystem::path& file_path, const IFFOptions
     if( resource.is_open() && this->data != nullptr )
     {
         auto reader = getDataReader();
-        
-        while( !reader.ended() )
-            resource.put( reader.readI8() );
+        const size_t byte_amount = reader.totalSize();
+
+        resource.write( reinterpret_cast<const char*>( reader.readSpan( byte_amount ) ), byte_amount );
 
         resource.close();
 
@@ -181,6 +203,18 @@ bool Resource::operator() ( const Resource& l_operand, const Resource& r_operand
     return (l_operand < r_operand);
 }
 
+namespace {
+    // The buffers are taken as const, so a view would not get copied by dangerousPointer().
+    int compareBytes( const Utilities::Buffer &l_data, const Utilities::Buffer &r_data ) {
+        const size_t byte_amount = l_data.getReader().totalSize();
+
+        if( byte_amount == 0 )
+            return 0;
+
+        return std::memcmp( l_data.dangerousPointer(), r_data.dangerousPointer(), byte_amount );
+    }
+}
+
 bool operator == ( const Resource& l_operand, const Resource& r_operand ) {
     if( l_operand.getResourceTagID() != r_operand.getResourceTagID() )
         return false;
@@ -193,22 +227,11 @@ bool operator == ( const Resource& l_operand, const Resource& r_operand ) {
     else // Check the size.
     if( l_operand.data->getReader().totalSize() != r_operand.data->getReader().totalSize() ) // Then check the size
         return false;
-    else
-    {
-        // Since they are both pointers that are not null they are
-        // used as readers.
-        auto l_reader = l_operand.data->getReader();
-        auto r_reader = r_operand.data->getReader();
-        
-        // Check byte by byte to see if these files in fact match.
-        // Since they are both equal in size only one can be checked for emptyness.
-        while( !l_reader.empty() ) {
-            if( l_reader.readU8() != r_reader.readU8() )
-                return false;
-        }
-        // Thus the l_operand and r_operand are the same.
-        return true;
-    }
+    else // Different hashes mean different files, and the hashes are only computed once.
+    if( l_operand.getContentHash() != r_operand.getContentHash() )
+        return false;
+    else // The hashes could still collide, so the bytes have to match too.
+        return compareBytes( *l_operand.data, *r_operand.data ) == 0;
 }
 
 bool operator != ( const Resource& l_operand, const Resource& r_operand ) {
@@ -236,27 +259,11 @@ bool operator < ( const Resource& l_operand, const Resource& r_operand ) {
     else
     if( l_operand.data->getReader().totalSize() > r_operand.data->getReader().totalSize() )
         return false;
-    else { // l_operand.buffer_p->totalSize() == r_operand.buffer_p->totalSize()
-        auto l_reader = l_operand.data->getReader();
-        auto r_reader = r_operand.data->getReader();
-        
-        // Check byte by byte to see if l_operand is in fact less than r_operand.
-        while( !l_reader.empty() && !r_reader.empty() ) {
-            auto l_byte = l_reader.readU8();
-            auto r_byte = l_reader.readU8();
-            
-            if( l_byte < r_byte ) {
-                return true;
-            }
-            else
-            if( l_byte > r_byte )
-                return false;
-            // else continue.
-        }
-
-        // l_operand therefore must be equal to r_operand, but not less than.
-        return false;
-    }
+    else // Order by the hash, so most of the comparisons would not need to read the data.
+    if( l_operand.getContentHash() != r_operand.getContentHash() )
+        return l_operand.getContentHash() < r_operand.getContentHash();
+    else // The hashes are the same, so the bytes decide.
+        return compareBytes( *l_operand.data, *r_operand.data ) < 0;
 }
 
 bool operator > ( const Resource& l_operand, const Resource& r_operand ) {
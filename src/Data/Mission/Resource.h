@@ -6,7 +6,9 @@
 #include "../../Utilities/Buffer.h"
 #include "../../Utilities/Logger.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <vector>
 #include <string>
@@ -57,6 +59,14 @@ private:
 
     SWVREntry swvr_entry;
 
+    // These are for the deferred parse.
+    ParseSettings deferred_settings;
+    mutable std::mutex parse_lock;
+    mutable std::atomic<bool> is_parsed;
+    mutable bool parse_status;
+
+    mutable std::atomic<uint64_t> content_hash; // Zero means that the hash is not computed yet.
+
 protected:
     size_t header_size;
     std::unique_ptr<Utilities::Buffer> data;
@@ -207,6 +217,14 @@ public:
     virtual std::filesystem::path getFullName( unsigned int index ) const;
     
     void setMemory( Utilities::Buffer *data_p );
+
+    /**
+     * This gets a 64 bit hash of the data of this resource. It is computed once, and kept until setMemory() is called.
+     * @note Resources with the same hash are very likely the same, but only operator== could tell for sure.
+     * @note This method is thread safe.
+     * @return The hash of the data including the header, or zero if the resource has no data.
+     */
+    uint64_t getContentHash() const;
     
     /**
      * This is to be used when the file is finished loading everything into raw_data.
@@ -217,6 +235,24 @@ public:
      */
     virtual bool parse( const ParseSettings &settings = Data::Mission::Resource::DEFAULT_PARSE_SETTINGS ) = 0;
 
+    /**
+     * This delays the parse of the resource until ensureParsed() gets called. To be used by loaders only.
+     * @param settings The settings that would be given to parse().
+     */
+    void deferParse( const ParseSettings &settings );
+
+    /**
+     * @return False if the parse of this resource got deferred and it has not happened yet.
+     */
+    bool isParsed() const { return is_parsed.load( std::memory_order_acquire ); }
+
+    /**
+     * This does the deferred parse if it has not been done yet.
+     * @note This method is thread safe, and it would only parse the resource once.
+     * @return The return value of the deferred parse, or true if the parse was never deferred.
+     */
+    bool ensureParsed() const;
+
     /**
      * This duplicates this class.
      * @note the pointer returned needs to be deleted.
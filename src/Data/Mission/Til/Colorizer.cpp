@@ -33,9 +33,12 @@ glm::vec3 accessColor( uint8_t index, const std::vector<Utilities::PixelFormatCo
 }
 
 void Data::Mission::Til::Colorizer::setColors( std::vector<Utilities::PixelFormatColor::GenericColor> &colors, uint16_t color_amount, Utilities::Buffer::Reader &reader, Utilities::Buffer::Endian endian ) {
+    std::vector<uint16_t> words( color_amount );
+
+    reader.readU16Array( words.data(), words.size(), endian );
+
     colors.reserve( color_amount );
-    for( size_t i = 0; i < color_amount; i++ ) {
-        auto word = reader.readU16( endian );
+    for( const uint16_t word : words ) {
         
         auto blue  = ((word & 0x001F) >>  0);
         auto green = ((word & 0x03E0) >>  5);
@@ -391,13 +391,16 @@ bool Data::Mission::TilResource::parse( const ParseSettings &settings ) {
                 // setup the point_cloud_3_channel.
                 point_cloud_3_channel.setDimensions( AMOUNT_OF_TILES + 1, AMOUNT_OF_TILES + 1 );
                 
+                const uint8_t *heightmap_r = reader_sect.readSpan( 3 * point_cloud_3_channel.getWidth() * point_cloud_3_channel.getHeight() );
+
                 for( unsigned y = 0; y < point_cloud_3_channel.getHeight(); y++ ) {
                     for( unsigned x = 0; x < point_cloud_3_channel.getWidth(); x++ ) {
                         HeightmapPixel height;
                         
-                        height.channel[0] = reader_sect.readI8();
-                        height.channel[1] = reader_sect.readI8();
-                        height.channel[2] = reader_sect.readI8();
+                        height.channel[0] = static_cast<int8_t>( heightmap_r[0] );
+                        height.channel[1] = static_cast<int8_t>( heightmap_r[1] );
+                        height.channel[2] = static_cast<int8_t>( heightmap_r[2] );
+                        heightmap_r += 3;
                         
                         point_cloud_3_channel.setValue( x, y, height );
                     }
@@ -440,9 +443,13 @@ bool Data::Mission::TilResource::parse( const ParseSettings &settings ) {
                 this->mesh_library_size = reader_sect.readU16( settings.endian );
                 uint16_t actual_mesh_library_size = 0;
 
+                uint16_t floor_bitfields[ AMOUNT_OF_TILES * AMOUNT_OF_TILES ];
+
+                reader_sect.readU16Array( floor_bitfields, AMOUNT_OF_TILES * AMOUNT_OF_TILES, settings.endian );
+
                 for( unsigned x = 0; x < AMOUNT_OF_TILES; x++ ) {
                     for( unsigned y = 0; y < AMOUNT_OF_TILES; y++ ) {
-                        mesh_reference_grid[x][y].set( reader_sect.readU16( settings.endian ) );
+                        mesh_reference_grid[x][y].set( floor_bitfields[ x * AMOUNT_OF_TILES + y ] );
 
                         actual_mesh_library_size += mesh_reference_grid[x][y].tile_amount;
                     }
@@ -465,12 +472,14 @@ bool Data::Mission::TilResource::parse( const ParseSettings &settings ) {
                 // Skip 2 bytes
                 reader_sect.readU16( settings.endian );
                 
+                std::vector<uint32_t> tile_bitfields( this->mesh_library_size );
+
+                reader_sect.readU32Array( tile_bitfields.data(), tile_bitfields.size(), settings.endian );
+
                 mesh_tiles.reserve( this->mesh_library_size );
                 
-                for( size_t i = 0; i < this->mesh_library_size; i++ ) {
-
-                    mesh_tiles.push_back( { reader_sect.readU32( settings.endian ) } );
-                }
+                for( const uint32_t bitfield : tile_bitfields )
+                    mesh_tiles.push_back( { bitfield } );
 
                 // Test culling data.
                 CullingData generated_culling_data = culling_data; // Til::CullingGenerator::create(point_cloud_3_channel, mesh_tiles, mesh_reference_grid);
@@ -506,11 +515,12 @@ bool Data::Mission::TilResource::parse( const ParseSettings &settings ) {
                 Til::Colorizer::setColors( colors, color_amount, reader_sect, settings.endian );
 
                 // Read the texture_references, and shading info.
-                while( reader_sect.getPosition( Utilities::Buffer::END ) >= sizeof(uint16_t) ) {
-                    const auto data = reader_sect.readU16( settings.endian );
+                const size_t tile_graphics_amount = reader_sect.getPosition( Utilities::Buffer::END ) / sizeof(uint16_t);
+                const size_t tile_graphics_start  = tile_graphics_bitfield.size();
 
-                    tile_graphics_bitfield.push_back( data );
-                }
+                tile_graphics_bitfield.resize( tile_graphics_start + tile_graphics_amount );
+
+                reader_sect.readU16Array( tile_graphics_bitfield.data() + tile_graphics_start, tile_graphics_amount, settings.endian );
                 
                 // Create the physics cells for this Til.
                 for( unsigned int x = 0; x < AMOUNT_OF_TILES; x++ ) {
@@ -625,7 +635,7 @@ using Data::Mission::Til::Mesh::FRONT_LEFT;
 
 int Data::Mission::TilResource::write( const std::filesystem::path& file_path, const Data::Mission::IFFOptions &iff_options ) const {
     int glTF_return = 0;
-    Utilities::ImageFormat::Chooser chooser;
+    Utilities::ImageFormat::Chooser chooser( iff_options.png_compression_level, iff_options.thread_amount );
 
     Utilities::ImageFormat::ImageFormat* the_choosen_r = chooser.getWriterReference( Utilities::PixelFormatColor_R8G8B8::linear );
 
@@ -662,8 +672,18 @@ int Data::Mission::TilResource::write( const std::filesystem::path& file_path, c
         if( model_output_p == nullptr )
             model_output_p = createModel();
         
-        if( iff_options.til.shouldWrite( iff_options.enable_global_dry_default ) && model_output_p != nullptr )
-            glTF_return = model_output_p->write( file_path, "til_"+ std::to_string( getResourceID() ) );
+        if( iff_options.til.shouldWrite( iff_options.enable_global_dry_default ) && model_output_p != nullptr ) {
+            if( iff_options.enable_quantization )
+                model_output_p->quantize();
+
+            if( iff_options.enable_weld )
+                model_output_p->weld();
+
+            if( iff_options.enable_glb )
+                glTF_return = model_output_p->writeGLB( file_path, "til_"+ std::to_string( getResourceID() ) );
+            else
+                glTF_return = model_output_p->write( file_path, "til_"+ std::to_string( getResourceID() ) );
+        }
         
         delete model_output_p;
     }
@@ -324,19 +324,16 @@ bool Data::Mission::WAVResource::addAudioStream( Utilities::Buffer::Reader &read
         if(bytes_per_sample == 1) {
             audio_stream.resize( audio_stream.size() + reader.totalSize() );
 
-            while( !reader.ended() ) {
-                audio_stream[head] = reader.readU8();
-                head++;
-            }
+            reader.readU8Array( audio_stream.data() + head, reader.getPosition( Utilities::Buffer::Direction::END ) );
             return true;
         }
         else if(bytes_per_sample == 2) {
             audio_stream.resize( audio_stream.size() + reader.totalSize() );
 
-            while( !reader.ended() ) {
-                reinterpret_cast<int16_t*>(audio_stream.data())[head] = reader.readI16( endian );
-                head++;
-            }
+            // Rounding up makes a leftover byte throw, just like reading the samples one by one would.
+            const size_t SAMPLE_AMOUNT = (reader.getPosition( Utilities::Buffer::Direction::END ) + 1) / sizeof( uint16_t );
+
+            reader.readU16Array( reinterpret_cast<uint16_t*>(audio_stream.data()) + head, SAMPLE_AMOUNT, endian );
             return true;
         }
         else
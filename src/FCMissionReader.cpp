@@ -1,10 +1,14 @@
 #include "Data/Mission/IFF.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include "Config.h"
 #include "Data/Mission/BMPResource.h"
+#include "Data/Mission/ExportManifest.h"
+#include "Data/Mission/IFFIndex.h"
 #include "Data/Mission/Til/Mesh.h"
 #include "Utilities/Logger.h"
+#include "Utilities/Parallel.h"
 
 namespace {
     std::string INPUT_OPERATION = "-i";
@@ -12,6 +16,11 @@ namespace {
     std::string RAW_OUTPUT_OPERATION = "-r";
     std::string DECODE_OUTPUT_OPERATION = "-d";
     std::string COMPARE_OUTPUT_OPERATION = "-c";
+    std::string THREAD_AMOUNT_OPERATION = "-j";
+    std::string BATCH_INPUT_OPERATION = "-b";
+    std::string GLOBAL_INPUT_OPERATION = "-g";
+    std::string INCREMENTAL_OPERATION = "-u";
+    std::string INDEX_CACHE_OPERATION = "-x";
     std::string OUTPUT_HELP_OPERATION = "-h";
 
     void help_output( std::ostream& stream ) {
@@ -20,19 +29,165 @@ namespace {
         stream << "Future Cop: MIT - Mission reader (version " << FUTURE_COP_MIT_VERSION << ")\n";
         stream << "\n";
         stream << "Usage:" << "\n";
-        stream << "  FCMissionReader [-h] [-i <path>] [-o <path>] [-c] [-d] [-r] " << "\n";
+        stream << "  FCMissionReader [-h] [-i <path>] [-b <path>] [-g <path>] [-o <path>] [-j <amount>] [-u] [-x] [-c] [-d] [-r] " << "\n";
         stream << "\n";
         stream << "Options:" << "\n";
         stream << "  -h         Display this help screen" << "\n";
         stream << "  -i <path>  File path for input, up to two inputs are supported" << "\n";
+        stream << "  -b <path>  Folder or text file listing the inputs for a batch export" << "\n";
+        stream << "  -g <path>  The global file that every batch input shares" << "\n";
         stream << "  -o <path>  Path to the folder or file for the outputs" << "\n";
+        stream << "  -j <amount> The amount of threads for the parsing and the exports, 0 for every core" << "\n";
+        stream << "  -u         Only export the resources that changed since the last export" << "\n";
+        stream << "  -x         Cache the resource locations of the later inputs in index files, so the next run skips the chunk scan" << "\n";
+        stream << "             The batch inputs are always cached" << "\n";
         stream << "  -r         Export raws" << "\n";
         stream << "  -d         Export supported and decoded files" << "\n";
+        stream << "             With batch inputs, every input gets its own folder in the output" << "\n";
         stream << "  -c         Determine and write the similarities between two inputs" << "\n";
         stream << "Decoding Export [ -d ] Options:" << "\n";
         Data::Mission::IFFOptions dialog;
         stream << dialog.getOptions();
     }
+
+    /**
+     * This exports one IFF into a folder.
+     * If incremental is true, then the manifest in the folder is used to skip the resources that have not changed, and it is updated afterwards.
+     */
+    void exportFolder( const Data::Mission::IFF &iff, const std::filesystem::path &folder_path, bool raw_file_mode, const Data::Mission::IFFOptions &iff_options, unsigned thread_amount, bool incremental ) {
+        if( !incremental ) {
+            iff.exportAllResources( folder_path, raw_file_mode, iff_options, thread_amount );
+            return;
+        }
+
+        const std::filesystem::path manifest_path = Data::Mission::ExportManifest::getManifestPath( folder_path );
+        Data::Mission::ExportManifest manifest;
+
+        manifest.read( manifest_path );
+
+        if( iff.exportAllResources( folder_path, raw_file_mode, iff_options, thread_amount, &manifest ) )
+            manifest.write( manifest_path );
+    }
+
+    void exportSingle( const Data::Mission::IFF &iff, const std::filesystem::path &folder_path, bool raw_file_mode, const std::vector<std::string> &extra_commands, unsigned thread_amount, bool incremental ) {
+        Data::Mission::IFFOptions iff_options;
+
+        if( iff_options.readParams( extra_commands, &std::cout ) )
+            exportFolder( iff, folder_path, raw_file_mode, iff_options, thread_amount, incremental );
+    }
+
+    bool isGlobalPath( const std::filesystem::path &path ) {
+        // The Windows and the Macintosh versions use GlblData, and the Playstation version uses fe.mis.
+        return path.filename() == "GlblData" || path.filename() == "fe.mis";
+    }
+
+    void addBatchInputs( const std::filesystem::path &path, std::vector<std::filesystem::path> &batch_paths ) {
+        std::error_code error_code;
+
+        if( std::filesystem::is_directory( path, error_code ) ) {
+            std::vector<std::filesystem::path> directory_paths;
+            std::filesystem::path index_extension = ".";
+            index_extension += Data::Mission::IFFIndex::FILE_EXTENSION;
+
+            for( const auto &entry : std::filesystem::directory_iterator( path, error_code ) ) {
+                if( entry.is_regular_file() && entry.path().extension() != index_extension )
+                    directory_paths.push_back( entry.path() );
+            }
+
+            // The directory order is not defined, so sort it to make the order of the logs the same every run.
+            std::sort( directory_paths.begin(), directory_paths.end() );
+
+            batch_paths.insert( batch_paths.end(), directory_paths.begin(), directory_paths.end() );
+        }
+        else {
+            std::ifstream list( path );
+
+            if( !list.is_open() ) {
+                auto log = Utilities::logger.getLog( Utilities::Logger::ERROR );
+                log.output << "The batch input " << path << " could not be opened.";
+                return;
+            }
+
+            std::string line;
+
+            while( std::getline( list, line ) ) {
+                if( !line.empty() && line.back() == '\r' )
+                    line.pop_back();
+
+                if( !line.empty() )
+                    batch_paths.push_back( line );
+            }
+        }
+    }
+
+    /**
+     * This exports every batch input into its own folder.
+     * The global file is loaded once, and it is shared with every other input. Only thread_amount inputs are loaded at the same time.
+     */
+    void exportBatch( std::vector<std::filesystem::path> batch_paths, std::filesystem::path global_path, const std::filesystem::path &output_folder_path, Data::Mission::IFF::OpenSettings open_settings, bool raw_file_mode, const std::vector<std::string> &extra_commands, unsigned thread_amount, bool incremental ) {
+        Data::Mission::IFFOptions iff_options;
+
+        if( !iff_options.readParams( extra_commands, &std::cout ) )
+            return;
+
+        // Batches tend to be exported again, so the next run can read the resource locations from the index files.
+        open_settings.use_index_cache = true;
+
+        auto global_it = std::find_if( batch_paths.begin(), batch_paths.end(), isGlobalPath );
+
+        if( global_it != batch_paths.end() ) {
+            if( global_path.empty() )
+                global_path = *global_it;
+
+            batch_paths.erase( global_it );
+        }
+
+        Data::Mission::IFF global_file;
+
+        if( !global_path.empty() ) {
+            open_settings.parse_thread_amount = thread_amount;
+
+            if( global_file.open( global_path, open_settings ) < 0 ) {
+                auto log = Utilities::logger.getLog( Utilities::Logger::ERROR );
+                log.output << "The global file " << global_path << " could not be opened. The batch inputs will not share it.";
+            }
+            else {
+                const std::filesystem::path folder_path = output_folder_path / global_path.filename();
+
+                std::filesystem::create_directories( folder_path );
+                exportFolder( global_file, folder_path, raw_file_mode, iff_options, thread_amount, incremental );
+
+                open_settings.shared_iff_r = &global_file;
+            }
+        }
+
+        // Each input is loaded and exported by one thread, so the threads are not split among the inputs.
+        open_settings.parse_thread_amount = 1;
+
+        Utilities::Parallel::forEach( batch_paths.size(), thread_amount, [&]( size_t index ) {
+            const std::filesystem::path &input_path = batch_paths[ index ];
+
+            try {
+                Data::Mission::IFF mission_file;
+
+                if( mission_file.open( input_path, open_settings ) < 0 ) {
+                    auto log = Utilities::logger.getLog( Utilities::Logger::ERROR );
+                    log.output << "The batch input " << input_path << " could not be opened.";
+                    return;
+                }
+
+                const std::filesystem::path folder_path = output_folder_path / input_path.filename();
+
+                std::filesystem::create_directories( folder_path );
+                exportFolder( mission_file, folder_path, raw_file_mode, iff_options, 1, incremental );
+            }
+            catch( const std::exception &exception ) {
+                // One broken input should not stop the export of the others.
+                auto log = Utilities::logger.getLog( Utilities::Logger::ERROR );
+                log.output << "The batch input " << input_path << " failed to export: " << exception.what();
+            }
+        } );
+    }
 }
 
 int main( int argc, char *argv[] ) {
@@ -45,9 +200,15 @@ int main( int argc, char *argv[] ) {
     Utilities::logger.setTimeStampMode( true );
 
     Data::Mission::IFF mission_file[2]; // Two mission files at a time for now.
+    Data::Mission::IFF::OpenSettings open_settings;
+    open_settings.lazy_parse = true; // The resources only get parsed if the export needs them.
     std::string output_folder_path = "./output/";
     bool custom_output = false;
+    unsigned thread_amount = 1;
+    bool incremental = false;
     int number_of_inputs = 0;
+    std::vector<std::filesystem::path> batch_paths;
+    std::filesystem::path global_path;
     std::vector<std::string> extra_commands;
 
     if( argc == 1 )
@@ -62,7 +223,7 @@ int main( int argc, char *argv[] ) {
 
             if( INPUT_OPERATION.compare( input ) == 0 )
                 if( number_of_inputs < 2 )
-                    mission_file[ number_of_inputs++ ].open( argv[++i] );
+                    mission_file[ number_of_inputs++ ].open( argv[++i], open_settings );
                 else
                 {
                     auto log = Utilities::logger.getLog( Utilities::Logger::CRITICAL );
@@ -70,14 +231,43 @@ int main( int argc, char *argv[] ) {
                     i = argc;
                 }
             else
+            if( BATCH_INPUT_OPERATION.compare( input ) == 0 && i + 1 < argc )
+                addBatchInputs( argv[ ++i ], batch_paths );
+            else
+            if( GLOBAL_INPUT_OPERATION.compare( input ) == 0 && i + 1 < argc )
+                global_path = argv[ ++i ];
+            else
+            if( INCREMENTAL_OPERATION.compare( input ) == 0 )
+                incremental = true;
+            else
+            if( INDEX_CACHE_OPERATION.compare( input ) == 0 )
+                open_settings.use_index_cache = true;
+            else
             if( OUTPUT_OPERATION.compare( input ) == 0 ) {
                 output_folder_path = argv[ ++i ];
                 custom_output = true;
             }
             else
+            if( THREAD_AMOUNT_OPERATION.compare( input ) == 0 && i + 1 < argc ) {
+                try {
+                    thread_amount = std::stoul( argv[ ++i ] );
+
+                    // The inputs after this option are parsed with these threads too.
+                    open_settings.parse_thread_amount = thread_amount;
+                }
+                catch( const std::logic_error & ) {
+                    auto log = Utilities::logger.getLog( Utilities::Logger::ERROR );
+                    log.output << "The amount of threads \"" << argv[ i ] << "\" is not a number.";
+                }
+            }
+            else
             if( input.find(RAW_OUTPUT_OPERATION) == 0 ) {
-                if( input.length() == 2 )
-                    mission_file[0].exportAllResources( output_folder_path, false, extra_commands );
+                if( input.length() == 2 ) {
+                    if( !batch_paths.empty() )
+                        exportBatch( batch_paths, global_path, output_folder_path, open_settings, false, extra_commands, thread_amount, incremental );
+                    else
+                        exportSingle( mission_file[0], output_folder_path, false, extra_commands, thread_amount, incremental );
+                }
                 else
                 {
                     // int resource_index = std::stoi( input.substr( 3, input.length() - 3 ) );
@@ -87,8 +277,12 @@ int main( int argc, char *argv[] ) {
             }
             else
             if( input.find(DECODE_OUTPUT_OPERATION) == 0 ) {
-                if( input.length() == 2 )
-                    mission_file[0].exportAllResources( output_folder_path, true, extra_commands );
+                if( input.length() == 2 ) {
+                    if( !batch_paths.empty() )
+                        exportBatch( batch_paths, global_path, output_folder_path, open_settings, true, extra_commands, thread_amount, incremental );
+                    else
+                        exportSingle( mission_file[0], output_folder_path, true, extra_commands, thread_amount, incremental );
+                }
                 else
                 {
                     // int resource_index = std::stoi( input.substr( 3, input.length() - 3 ) );
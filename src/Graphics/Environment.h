@@ -193,6 +193,18 @@ public:
      */
     virtual void setBoundingBoxDraw(bool draw) = 0;
 
+    /**
+     * @return If the map is stored in the compact vertex layout then this is true.
+     */
+    virtual bool getWorldQuantization() const = 0;
+
+    /**
+     * This sets whether the map gets stored in the compact vertex layout, which uses less video memory.
+     * @note This only affects the maps loaded by loadResources after this call.
+     * @param quantize If true then the map sections are quantized.
+     */
+    virtual void setWorldQuantization(bool quantize) = 0;
+
     /**
      * Setup the draw graph for the renderer.
      */
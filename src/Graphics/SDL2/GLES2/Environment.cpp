@@ -20,6 +20,7 @@ Environment::Environment() : window_p( nullptr ) {
     this->display_world = false;
     this->has_initialized_routines = false;
     this->draw_bounding_boxes = false;
+    this->quantize_world = false;
 
     this->force_gl2 = false;
     this->semi_transparent_limit = 256;
@@ -212,7 +213,7 @@ int Environment::loadResources( const Data::Accessor &accessor ) {
         this->map_section_height = ptc_r->getHeight();
 
         // Turn the map into a world.
-        this->world_p->setWorld( *ptc_r, map_sections, this->textures );
+        this->world_p->setWorld( *ptc_r, map_sections, this->textures, this->quantize_world );
     }
 
     auto err = glGetError();
@@ -372,6 +373,14 @@ void Environment::setBoundingBoxDraw(bool draw) {
     this->draw_bounding_boxes = draw;
 }
 
+bool Environment::getWorldQuantization() const {
+    return this->quantize_world;
+}
+
+void Environment::setWorldQuantization(bool quantize) {
+    this->quantize_world = quantize;
+}
+
 void Environment::setupFrame() {
     for( unsigned int i = 0; i < window_p->getCameras()->size(); i++ )
     {
@@ -37,6 +37,7 @@ public:
     Internal::DynamicTriangleDraw dynamic_triangle_draw_routine;
 
     bool draw_bounding_boxes;
+    bool quantize_world;
 
     // Configuration
     bool force_gl2;
@@ -69,6 +70,8 @@ public:
     virtual int setTilPolygonBlink( unsigned polygon_type, float rate = 1.0f);
     virtual bool getBoundingBoxDraw() const;
     virtual void setBoundingBoxDraw(bool draw);
+    virtual bool getWorldQuantization() const;
+    virtual void setWorldQuantization(bool quantize);
     virtual void setupFrame();
     virtual void drawFrame();
     virtual bool screenshot( Utilities::Image2D &image ) const;
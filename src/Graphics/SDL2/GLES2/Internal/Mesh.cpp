@@ -1,6 +1,8 @@
 #include "Mesh.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 
 Graphics::SDL2::GLES2::Internal::Mesh::DynamicTriangleTransform::~DynamicTriangleTransform() {
 }
@@ -19,10 +21,15 @@ Graphics::SDL2::GLES2::Internal::Mesh::Mesh( Program *program_r ) {
     this->program_r = program_r;
     draw_command_array_mode = GL_TRIANGLES;
     morph_frame_amount = 0;
+    index_buffer_object = 0;
+    is_indexed = false;
 }
 
 Graphics::SDL2::GLES2::Internal::Mesh::~Mesh() {
     glDeleteBuffers( 1, &vertex_buffer_object );
+
+    if( is_indexed )
+        glDeleteBuffers( 1, &index_buffer_object );
 }
 
 void Graphics::SDL2::GLES2::Internal::Mesh::addCommand( GLint first, GLsizei opaque_count, GLsizei count, const Texture2D *texture_r ) {
@@ -33,6 +40,13 @@ void Graphics::SDL2::GLES2::Internal::Mesh::addCommand( GLint first, GLsizei opa
     draw_command.back().texture_r = texture_r;
 }
 
+void Graphics::SDL2::GLES2::Internal::Mesh::drawCommand( GLint first, GLsizei count ) const {
+    if( is_indexed )
+        glDrawElements( draw_command_array_mode, count, GL_UNSIGNED_SHORT, reinterpret_cast<const void*>( sizeof( GLushort ) * first ) );
+    else
+        glDrawArrays( draw_command_array_mode, first, count );
+}
+
 void Graphics::SDL2::GLES2::Internal::Mesh::setup( Utilities::ModelBuilder &model, const std::map<uint32_t, Internal::Texture2D*>& textures, const VertexAttributeArray *const default_vertex_array_r ) {
     switch(model.getPrimativeMode()) {
         case Utilities::ModelBuilder::MeshPrimativeMode::POINTS:
@@ -58,7 +72,14 @@ void Graphics::SDL2::GLES2::Internal::Mesh::setup( Utilities::ModelBuilder &mode
             break;
     }
 
-    void * vertex_buffer_data = model.getBuffer( vertex_buffer_size );
+    // Only the unique vertices get uploaded. The model itself is not welded, since the draw routines still read its transparent triangles
+    // in the order of the primitives. OpenGL ES 2 only guarantees 16 bit indices, so bigger meshes are drawn without indices.
+    std::vector<uint32_t> unique_vertices;
+    std::vector<uint32_t> welded_indices;
+
+    is_indexed = model.getWeldMapping( unique_vertices, welded_indices ) && unique_vertices.size() <= static_cast<size_t>( std::numeric_limits<GLushort>::max() ) + 1;
+
+    const uint8_t *vertex_buffer_data = reinterpret_cast<const uint8_t*>( model.getBuffer( vertex_buffer_size ) );
     
     if(!model.getBoundingSphere( this->culling_sphere_position, this->culling_sphere_radius )) {
         this->culling_sphere_position = glm::vec3(0);
@@ -68,45 +89,73 @@ void Graphics::SDL2::GLES2::Internal::Mesh::setup( Utilities::ModelBuilder &mode
     morph_buffer_size = 0;
     model.getMorphBuffer( 0, morph_buffer_size );
 
+    morph_frame_amount = model.getNumMorphFrames();
+
+    // This copies the unique vertices of a buffer next to each other.
+    auto gatherVertices = [&unique_vertices]( const uint8_t *source_r, unsigned source_size, unsigned vertex_amount, uint8_t *destination_r ) {
+        const size_t vertex_size = source_size / vertex_amount;
+
+        for( size_t v = 0; v < unique_vertices.size(); v++ )
+            std::copy_n( source_r + unique_vertices[ v ] * vertex_size, vertex_size, destination_r + v * vertex_size );
+
+        return static_cast<unsigned>( unique_vertices.size() * vertex_size );
+    };
+
     // Create a Vertex Buffer Object
     glGenBuffers(1, &vertex_buffer_object);
     glBindBuffer( GL_ARRAY_BUFFER, vertex_buffer_object);
     
-    morph_frame_amount = model.getNumMorphFrames();
-    
-    if( morph_frame_amount == 0 )
+    if( morph_frame_amount == 0 && !is_indexed )
     {
         // Generate the buffer
         glBufferData( GL_ARRAY_BUFFER, vertex_buffer_size, vertex_buffer_data, GL_STATIC_DRAW );
     }
     else
     {
-        frame_amount = morph_frame_amount + 1;
-        
-        size_t buffer_size = vertex_buffer_size + morph_buffer_size * morph_frame_amount;
-        uint8_t *buffer = new uint8_t[ buffer_size ];
-        
-        for( size_t i = 0; i < vertex_buffer_size; i++ ) {
-            buffer[ i ] = reinterpret_cast<uint8_t*>( vertex_buffer_data )[ i ];
+        if( morph_frame_amount != 0 )
+            frame_amount = morph_frame_amount + 1;
+
+        std::vector<uint8_t> buffer( vertex_buffer_size + morph_buffer_size * morph_frame_amount );
+        const unsigned vertex_amount = model.getNumVertices();
+        const unsigned model_morph_buffer_size = morph_buffer_size;
+
+        if( is_indexed ) {
+            vertex_buffer_size = gatherVertices( vertex_buffer_data, vertex_buffer_size, vertex_amount, buffer.data() );
+
+            if( morph_frame_amount != 0 )
+                morph_buffer_size = model_morph_buffer_size / vertex_amount * unique_vertices.size();
         }
-        
+        else
+            std::copy_n( vertex_buffer_data, vertex_buffer_size, buffer.data() );
+
         size_t buffer_offset = vertex_buffer_size;
         
         for( unsigned int i = 0; i < morph_frame_amount; i++ ) {
             unsigned int morph_size;
             
-            uint8_t *morph_buff = reinterpret_cast<uint8_t*>( model.getMorphBuffer( i, morph_size ) );
-            for( size_t f = 0; f < morph_buffer_size; f++ ) {
-                buffer[ buffer_offset++ ] = morph_buff[ f ];
-            }
+            const uint8_t *morph_buff = reinterpret_cast<const uint8_t*>( model.getMorphBuffer( i, morph_size ) );
+
+            if( is_indexed )
+                gatherVertices( morph_buff, model_morph_buffer_size, vertex_amount, buffer.data() + buffer_offset );
+            else
+                std::copy_n( morph_buff, morph_buffer_size, buffer.data() + buffer_offset );
+
+            buffer_offset += morph_buffer_size;
         }
         
-        glBufferData( GL_ARRAY_BUFFER, buffer_size, buffer, GL_STATIC_DRAW );
+        glBufferData( GL_ARRAY_BUFFER, buffer_offset, buffer.data(), GL_STATIC_DRAW );
         
         // Wait until the buffer is done uploading.
         glFinish();
-        
-        delete [] buffer;
+    }
+
+    if( is_indexed ) {
+        // The welded indices are already relative to the vertex buffer, and they are in the order of the primitives.
+        const std::vector<GLushort> indices( welded_indices.begin(), welded_indices.end() );
+
+        glGenBuffers( 1, &index_buffer_object );
+        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, index_buffer_object );
+        glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof( GLushort ) * indices.size(), indices.data(), GL_STATIC_DRAW );
     }
 
     vertex_array.getAttributesFrom( *program_r, model );
@@ -121,6 +170,7 @@ void Graphics::SDL2::GLES2::Internal::Mesh::setup( Utilities::ModelBuilder &mode
     vertex_array.cullUnfound();
 
     Utilities::ModelBuilder::TextureMaterial material;
+    GLint first_index = 0;
 
     for( unsigned int a = 0; a < model.getNumMaterials(); a++ ) {
         model.getMaterial( a, material );
@@ -137,7 +187,13 @@ void Graphics::SDL2::GLES2::Internal::Mesh::setup( Utilities::ModelBuilder &mode
         GLsizei mix_index = std::min( material.count, material.mix_index );
         GLsizei opaque_count = std::min(addition_index, mix_index);
 
-        addCommand( material.starting_vertex_index, opaque_count, material.count, texture_2d_r );
+        // The welded indices of the materials follow each other, so the first index of a material is the amount of indices before it.
+        if( is_indexed )
+            addCommand( first_index, opaque_count, material.count, texture_2d_r );
+        else
+            addCommand( material.starting_vertex_index, opaque_count, material.count, texture_2d_r );
+
+        first_index += material.count;
     }
 }
 
@@ -158,6 +214,10 @@ void Graphics::SDL2::GLES2::Internal::Mesh::drawTransparent( GLuint active_switc
 
 void Graphics::SDL2::GLES2::Internal::Mesh::bindArray() const {
     glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_object);
+
+    if( is_indexed )
+        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, index_buffer_object );
+
     vertex_array.bind();
 
    auto err = glGetError();
@@ -172,7 +232,7 @@ void Graphics::SDL2::GLES2::Internal::Mesh::noPreBindDraw( GLuint active_switch_
         if( (*i).texture_r != nullptr )
             (*i).texture_r->bind( active_switch_texture, texture_switch_uniform );
 
-        glDrawArrays( draw_command_array_mode, (*i).first, (*i).count );
+        drawCommand( (*i).first, (*i).count );
         auto err = glGetError();
 
         if( err != GL_NO_ERROR )
@@ -186,7 +246,7 @@ void Graphics::SDL2::GLES2::Internal::Mesh::noPreBindDrawOpaque( GLuint active_s
         if( (*i).texture_r != nullptr )
             (*i).texture_r->bind( active_switch_texture, texture_switch_uniform );
 
-        glDrawArrays( draw_command_array_mode, (*i).first, (*i).opaque_count );
+        drawCommand( (*i).first, (*i).opaque_count );
         auto err = glGetError();
         assert( (*i).texture_r != nullptr );
 
@@ -201,7 +261,7 @@ void Graphics::SDL2::GLES2::Internal::Mesh::noPreBindDrawTransparent( GLuint act
         if( (*i).texture_r != nullptr )
             (*i).texture_r->bind( active_switch_texture, texture_switch_uniform );
 
-        glDrawArrays( draw_command_array_mode, (*i).first + (*i).opaque_count, (*i).count - (*i).opaque_count );
+        drawCommand( (*i).first + (*i).opaque_count, (*i).count - (*i).opaque_count );
         auto err = glGetError();
 
         if( err != GL_NO_ERROR )
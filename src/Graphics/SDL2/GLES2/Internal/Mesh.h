@@ -16,7 +16,7 @@ namespace Internal {
 class Mesh {
 public:
     struct DrawCommand {
-        GLint first;
+        GLint first; // If the mesh is indexed, then this is the first index rather than the first vertex.
         GLsizei opaque_count;
         GLsizei count;
         const Texture2D *texture_r;
@@ -38,6 +38,8 @@ public:
 protected:
     Program *program_r;
     GLuint vertex_buffer_object;
+    GLuint index_buffer_object;
+    bool is_indexed; // If true, the mesh is drawn with the index_buffer_object.
     VertexAttributeArray vertex_array;
 
     std::vector<DrawCommand> draw_command;
@@ -52,6 +54,7 @@ protected:
     float culling_sphere_radius;
 
     void addCommand( GLint first, GLsizei opaque_count, GLsizei count, const Texture2D *texture_r );
+    void drawCommand( GLint first, GLsizei count ) const;
 public:
     Mesh( Program *program_r );
     virtual ~Mesh();
@@ -146,25 +146,30 @@ Graphics::SDL2::GLES2::Internal::MorphModelDraw::Animation::Animation( Utilities
             unsigned mix_index = std::min( material.count, material.mix_index );
             unsigned transparent_index = std::min( mix_index, addition_index );
             
-            glm::vec4 decoded_position = glm::vec4(0, 0, 0, 1);
-            glm::vec4 decoded_normal   = glm::vec4(0, 1, 0, 0);
+            std::vector<glm::vec3> decoded_positions;
+            std::vector<glm::vec3> decoded_normals;
+
+            // Read every transparent vertex of the material for this frame at once.
+            const unsigned transparent_count = material.count - transparent_index;
+
+            model_type_r->getMorphAttributes( decoded_positions, position_compenent_index, f, material_count + transparent_index, transparent_count, glm::vec3(0, 0, 0) );
+            model_type_r->getMorphAttributes(   decoded_normals,   normal_compenent_index, f, material_count + transparent_index, transparent_count, glm::vec3(0, 1, 0) );
             
             const unsigned vertex_per_triangle = 3;
             
-            for( unsigned m = transparent_index; m < material.count; m += vertex_per_triangle ) {
+            for( unsigned m = transparent_index; m + vertex_per_triangle <= material.count; m += vertex_per_triangle ) {
                 DeltaTriangle triangle;
                 
                 for( unsigned t = 0; t < vertex_per_triangle; t++ ) {
-                    model_type_r->getTransformation( decoded_position, position_compenent_index, material_count + m + t, f );
-                    model_type_r->getTransformation( decoded_normal,     normal_compenent_index, material_count + m + t, f );
-                    
-                    triangle.vertices[t].position.x = decoded_position.x;
-                    triangle.vertices[t].position.y = decoded_position.y;
-                    triangle.vertices[t].position.z = decoded_position.z;
-
-                    triangle.vertices[t].normal.x = decoded_normal.x;
-                    triangle.vertices[t].normal.y = decoded_normal.y;
-                    triangle.vertices[t].normal.z = decoded_normal.z;
+                    const unsigned vertex_index = m - transparent_index + t;
+
+                    triangle.vertices[t].position.x = decoded_positions[ vertex_index ].x;
+                    triangle.vertices[t].position.y = decoded_positions[ vertex_index ].y;
+                    triangle.vertices[t].position.z = decoded_positions[ vertex_index ].z;
+
+                    triangle.vertices[t].normal.x = decoded_normals[ vertex_index ].x;
+                    triangle.vertices[t].normal.y = decoded_normals[ vertex_index ].y;
+                    triangle.vertices[t].normal.z = decoded_normals[ vertex_index ].z;
                 }
                 
                 this->frame_data.push_back( triangle );
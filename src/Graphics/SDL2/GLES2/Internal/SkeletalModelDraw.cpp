@@ -1,6 +1,7 @@
 #include "SkeletalModelDraw.h"
 #include "../ModelInstance.h"
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <cassert>
 #include "SDL.h"
 #include <iostream>
@@ -237,10 +238,16 @@ int Graphics::SDL2::GLES2::Internal::SkeletalModelDraw::inputModel( Utilities::M
         for( unsigned int frame_index = 0; frame_index < model_type_r->getNumJointFrames(); frame_index++ )
         {
             glm::mat4* frame_r = model_animation_p[ obj_identifier ]->getFrames( frame_index );
-
-            for( unsigned int bone_index = 0; bone_index < model_type_r->getNumJoints(); bone_index++ )
-            {
-                frame_r[ bone_index ] = model_type_r->getJointFrame( frame_index, bone_index );
+            const glm::mat4* baked_frame_r = obj.getBoneMatrices( frame_index );
+
+            // The Cobj already has the world space matrices of its bones.
+            if( baked_frame_r != nullptr && obj.getNumBones() == model_type_r->getNumJoints() )
+                std::copy( baked_frame_r, baked_frame_r + model_type_r->getNumJoints(), frame_r );
+            else {
+                for( unsigned int bone_index = 0; bone_index < model_type_r->getNumJoints(); bone_index++ )
+                {
+                    frame_r[ bone_index ] = model_type_r->getJointFrame( frame_index, bone_index );
+                }
             }
         }
 
@@ -275,17 +282,18 @@ int Graphics::SDL2::GLES2::Internal::SkeletalModelDraw::inputModel( Utilities::M
             GLsizei mix_index = std::min( material.count, material.mix_index );
             GLsizei transparent_index = std::min( mix_index, addition_index );
 
-            glm::vec4 joints = glm::vec4(0, 0, 0, 1);
+            std::vector<glm::vec4> joints;
+
+            // Read every transparent vertex of the material at once.
+            model_type_r->getAttributes( joints, joint_compenent_index, material_count + transparent_index, material.count - transparent_index );
 
             const unsigned vertex_per_triangle = 3;
 
-            for( unsigned m = transparent_index; m < material.count; m += vertex_per_triangle ) {
+            for( unsigned m = transparent_index; m + vertex_per_triangle <= static_cast<unsigned>( material.count ); m += vertex_per_triangle ) {
                 SkeletalAnimation::TriangleIndex triangle;
 
                 for( unsigned t = 0; t < vertex_per_triangle; t++ ) {
-                    model_type_r->getTransformation( joints, joint_compenent_index, material_count + m + t );
-
-                    triangle.vertices[t] = joints.x;
+                    triangle.vertices[t] = joints[ m - transparent_index + t ].x;
                 }
 
                 model_animation_p[ obj_identifier ]->triangle_weights.push_back( triangle );
@@ -409,29 +409,34 @@ int Graphics::SDL2::GLES2::Internal::StaticModelDraw::inputModel( Utilities::Mod
 
         Graphics::RenderMode polygon_type;
 
-        glm::vec4   position = glm::vec4(0, 0, 0, 1);
-        glm::vec4     normal = glm::vec4(0, 0, 0, 1);
-        glm::vec4      color = glm::vec4(1, 1, 1, 1);
-        glm::vec4 coordinate = glm::vec4(0, 0, 0, 1);
-        glm::vec4   metadata = glm::vec4(0, 0, 0, 0);
+        std::vector<glm::vec4>   positions;
+        std::vector<glm::vec4>     normals;
+        std::vector<glm::vec4>      colors;
+        std::vector<glm::vec4> coordinates;
+        std::vector<glm::vec4>   metadatas;
+
+        // Read every transparent vertex of the material at once.
+        const unsigned transparent_count = material.count - transparent_index;
+
+        model_type_r->getAttributes(   positions,   position_compenent_index, material_count + transparent_index, transparent_count, glm::vec4(0, 0, 0, 1) );
+        model_type_r->getAttributes(     normals,     normal_compenent_index, material_count + transparent_index, transparent_count, glm::vec4(0, 0, 0, 1) );
+        model_type_r->getAttributes(      colors,      color_compenent_index, material_count + transparent_index, transparent_count, glm::vec4(1, 1, 1, 1) );
+        model_type_r->getAttributes( coordinates, coordinate_compenent_index, material_count + transparent_index, transparent_count, glm::vec4(0, 0, 0, 1) );
+        model_type_r->getAttributes(   metadatas,   metadata_compenent_index, material_count + transparent_index, transparent_count, glm::vec4(0, 0, 0, 0) );
 
         const unsigned vertex_per_triangle = 3;
 
-        for( unsigned m = transparent_index; m < material.count; m += vertex_per_triangle ) {
+        for( unsigned m = transparent_index; m + vertex_per_triangle <= material.count; m += vertex_per_triangle ) {
             DynamicTriangleDraw::Triangle triangle;
 
             for(unsigned t = 0; t < 3; t++) {
-                model_type_r->getTransformation(   position,   position_compenent_index, material_count + m + t );
-                model_type_r->getTransformation(     normal,     normal_compenent_index, material_count + m + t );
-                model_type_r->getTransformation(      color,      color_compenent_index, material_count + m + t );
-                model_type_r->getTransformation( coordinate, coordinate_compenent_index, material_count + m + t );
-                model_type_r->getTransformation(   metadata,   metadata_compenent_index, material_count + m + t );
-
-                triangle.vertices[t].position = { position.x, position.y, position.z };
-                triangle.vertices[t].normal = normal;
-                triangle.vertices[t].color = color;
-                triangle.vertices[t].coordinate = coordinate;
-                triangle.vertices[t].vertex_metadata = metadata;
+                const unsigned vertex_index = m - transparent_index + t;
+
+                triangle.vertices[t].position = { positions[ vertex_index ].x, positions[ vertex_index ].y, positions[ vertex_index ].z };
+                triangle.vertices[t].normal = normals[ vertex_index ];
+                triangle.vertices[t].color = colors[ vertex_index ];
+                triangle.vertices[t].coordinate = coordinates[ vertex_index ];
+                triangle.vertices[t].vertex_metadata = metadatas[ vertex_index ];
 
                 if(face_override_amount != 0 && static_cast<uint16_t>(triangle.vertices[t].vertex_metadata[1]) > face_override_amount) {
                     for(unsigned a = 0; a < t + 1; a++)
@@ -236,7 +236,7 @@ int Graphics::SDL2::GLES2::Internal::World::compileProgram() {
     }
 }
 
-void Graphics::SDL2::GLES2::Internal::World::setWorld( const Data::Mission::PTCResource &pointer_tile_cluster, const std::vector<const Data::Mission::TilResource*> &til_resources, const std::map<uint32_t, Internal::Texture2D*>& textures ) {
+void Graphics::SDL2::GLES2::Internal::World::setWorld( const Data::Mission::PTCResource &pointer_tile_cluster, const std::vector<const Data::Mission::TilResource*> &til_resources, const std::map<uint32_t, Internal::Texture2D*>& textures, bool is_quantized ) {
     tiles.resize( til_resources.size() );
 
     std::map<uint32_t, uint32_t> resource_id_index;
@@ -252,7 +252,12 @@ void Graphics::SDL2::GLES2::Internal::World::setWorld( const Data::Mission::PTCR
 
         assert( model_p != nullptr );
 
+        // The compact layout roughly halves the vertex memory of the map.
+        if( is_quantized )
+            model_p->quantize();
+
         (*i).mesh_p = new Graphics::SDL2::GLES2::Internal::Mesh( &program );
+        (*i).position_scale = model_p->getPositionScale();
         (*i).til_resource_r = data_p;
         (*i).change_rate = -1.0;
         (*i).current = 0.0;
@@ -338,29 +343,38 @@ void Graphics::SDL2::GLES2::Internal::World::setWorld( const Data::Mission::PTCR
 
             unsigned mix_index = std::min( material.count, material.mix_index );
 
-            glm::vec4   positions = glm::vec4(0, 0, 0, 1);
-            glm::vec4     normals = glm::vec4(0, 0, 0, 1);
-            glm::vec4      colors = glm::vec4(0.5, 0.5, 0.5, 0.5); // Just in case if the mesh does not have vertex color information.
-            glm::vec4 coordinates = glm::vec4(0, 0, 0, 1);
-            glm::vec4   tile_type = glm::vec4(0, 0, 0, 1);
+            std::vector<glm::vec4>   positions;
+            std::vector<glm::vec4>     normals;
+            std::vector<glm::vec4>      colors;
+            std::vector<glm::vec4> coordinates;
+            std::vector<glm::vec4>   tile_types;
+
+            // Read every transparent vertex of the material at once.
+            const unsigned transparent_count = material.count - mix_index;
+
+            model_p->getAttributes(   positions,   position_compenent_index, material_count + mix_index, transparent_count, glm::vec4(0, 0, 0, 1) );
+            model_p->getAttributes(     normals,     normal_compenent_index, material_count + mix_index, transparent_count, glm::vec4(0, 0, 0, 1) );
+            model_p->getAttributes(      colors,      color_compenent_index, material_count + mix_index, transparent_count, glm::vec4(0.5, 0.5, 0.5, 0.5) ); // Just in case if the mesh does not have vertex color information.
+            model_p->getAttributes( coordinates, coordinate_compenent_index, material_count + mix_index, transparent_count, glm::vec4(0, 0, 0, 1) );
+            model_p->getAttributes(  tile_types,  tile_type_compenent_index, material_count + mix_index, transparent_count, glm::vec4(0, 0, 0, 1) );
 
             const unsigned vertex_per_triangle = 3;
 
-            for( unsigned m = mix_index; m < material.count; m += vertex_per_triangle ) {
+            for( unsigned m = 0; m + vertex_per_triangle <= transparent_count; m += vertex_per_triangle ) {
                 DynamicTriangleDraw::Triangle triangle;
 
                 for( unsigned t = 0; t < 3; t++ ) {
-                    model_p->getTransformation(   positions,   position_compenent_index, material_count + m + t );
-                    model_p->getTransformation(     normals,     normal_compenent_index, material_count + m + t );
-                    model_p->getTransformation(      colors,      color_compenent_index, material_count + m + t );
-                    model_p->getTransformation( coordinates, coordinate_compenent_index, material_count + m + t );
-                    model_p->getTransformation(   tile_type,  tile_type_compenent_index, material_count + m + t );
-
-                    triangle.vertices[t].position = { positions.x, positions.y, positions.z };
-                    triangle.vertices[t].normal   = {   normals.x,   normals.y,   normals.z };
-                    triangle.vertices[t].color    = 2.0f * colors;
+                    const glm::vec4   &position =   positions[ m + t ];
+                    const glm::vec4     &normal =     normals[ m + t ];
+                    const glm::vec4      &color =      colors[ m + t ];
+                    const glm::vec4 &coordinate = coordinates[ m + t ];
+                    const glm::vec4  &tile_type =  tile_types[ m + t ];
+
+                    triangle.vertices[t].position = { position.x, position.y, position.z };
+                    triangle.vertices[t].normal   = {   normal.x,   normal.y,   normal.z };
+                    triangle.vertices[t].color    = 2.0f * color;
                     triangle.vertices[t].color.w  = 1;
-                    triangle.vertices[t].coordinate = coordinates;
+                    triangle.vertices[t].coordinate = coordinate;
                     triangle.vertices[t].vertex_metadata = { 0, 0 };
 
                     if( t == 0 ) {
@@ -544,7 +558,7 @@ void Graphics::SDL2::GLES2::Internal::World::draw( Graphics::SDL2::GLES2::Camera
                     0,
                     ((section.position.y * Data::Mission::TilResource::AMOUNT_OF_TILES + Data::Mission::TilResource::SPAN_OF_TIL) + TILE_SPAN) );
 
-                final_position = glm::translate( projection_view, position );
+                final_position = glm::scale( glm::translate( projection_view, position ), glm::vec3( (*i).position_scale ) );
 
                 position_mat = glm::translate( glm::mat4(1), position );
 
@@ -44,6 +44,7 @@ public:
         };
 
         Mesh *mesh_p;
+        float position_scale; // If the mesh is quantized, this turns its positions back into model space. Otherwise it is one.
         std::vector<DynamicTriangleDraw::Triangle> transparent_triangles;
         std::vector<Info> transparent_triangle_info;
         const Data::Mission::TilResource *til_resource_r;
@@ -142,9 +143,10 @@ public:
      * @param pointer_tile_cluster This is the pointerTileCluster.
      * @param resources_til This caries the til resources in which the world will use.
      * @param textures The default textures also color the map.
+     * @param is_quantized If true then the sections are stored in the compact vertex layout of ModelBuilder::quantize.
      * @return If ptc does not exist in the parameter resource it will return false and do nothing.
      */
-    void setWorld( const Data::Mission::PTCResource &pointer_tile_cluster, const std::vector<const Data::Mission::TilResource*> &til_resources, const std::map<uint32_t, Internal::Texture2D*>& textures );
+    void setWorld( const Data::Mission::PTCResource &pointer_tile_cluster, const std::vector<const Data::Mission::TilResource*> &til_resources, const std::map<uint32_t, Internal::Texture2D*>& textures, bool is_quantized = false );
 
     /**
      * Update the culling meta data for the camera.
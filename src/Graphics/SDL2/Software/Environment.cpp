@@ -6,8 +6,27 @@
 #include <execution>
 #include <thread>
 
+namespace {
+
+std::array<uint16_t, Graphics::SDL2::Software::Environment::TEXTURE_SIZE> makeMortonTable() {
+    std::array<uint16_t, Graphics::SDL2::Software::Environment::TEXTURE_SIZE> table;
+
+    for(unsigned i = 0; i < table.size(); i++) {
+        table[i] = 0;
+
+        for(unsigned bit = 0; bit < 8; bit++)
+            table[i] |= ((i >> bit) & 1) << (2 * bit);
+    }
+
+    return table;
+}
+
+}
+
 namespace Graphics::SDL2::Software {
 
+const std::array<uint16_t, Environment::TEXTURE_SIZE> Environment::MORTON_TABLE = makeMortonTable();
+
 Environment::Environment() : window_p( nullptr ) {
     this->display_world = false;
     this->pixel_size = 1;
@@ -64,20 +83,45 @@ int Environment::loadResources( const Data::Accessor &accessor ) {
         this->textures.back().resource_id = resource_r->getResourceID();
         this->textures.back().texture_p   = new CBMP_TEXTURE;
 
-        this->textures.back().texture_p->setDimensions( image_r->getWidth(), image_r->getHeight() );
+        this->textures.back().texture_p->setDimensions( TEXTURE_SIZE, TEXTURE_SIZE );
+
+        const size_t WIDTH  = image_r->getWidth();
+        const size_t HEIGHT = image_r->getHeight();
 
-        for(auto y = image_r->getHeight(); y != 0; y--) {
-            for(auto x = image_r->getWidth(); x != 0; x--) {
-                auto source_pixel = image_r->readPixel( (x - 1), (y - 1) );
+        std::vector<TexturePixel> rows( WIDTH * HEIGHT );
 
-                TexturePixel destination_pixel;
+        // TexturePixel has the same layout as R8G8B8A8, so the rows can be converted directly.
+        auto converter_r = Utilities::PixelFormatConverter::get( *image_r->getPixelFormat(), Utilities::PixelFormatColor_R8G8B8A8::linear );
 
-                destination_pixel.data[0] = 255.0 * source_pixel.red;
-                destination_pixel.data[1] = 255.0 * source_pixel.green;
-                destination_pixel.data[2] = 255.0 * source_pixel.blue;
-                destination_pixel.data[3] = 255.0 * source_pixel.alpha;
+        if( converter_r != nullptr ) {
+            converter_r->convert(
+                image_r->getDirectGridData(), image_r->getEndian(),
+                reinterpret_cast<uint8_t*>( rows.data() ), Utilities::Buffer::Endian::NO_SWAP,
+                rows.size() );
+        }
+        else {
+            for(auto y = image_r->getHeight(); y != 0; y--) {
+                for(auto x = image_r->getWidth(); x != 0; x--) {
+                    auto source_pixel = image_r->readPixel( (x - 1), (y - 1) );
 
-                this->textures.back().texture_p->setValue( (x - 1), (y - 1), destination_pixel);
+                    TexturePixel &destination_pixel = rows[ (y - 1) * WIDTH + (x - 1) ];
+
+                    destination_pixel.data[0] = 255.0 * source_pixel.red;
+                    destination_pixel.data[1] = 255.0 * source_pixel.green;
+                    destination_pixel.data[2] = 255.0 * source_pixel.blue;
+                    destination_pixel.data[3] = 255.0 * source_pixel.alpha;
+                }
+            }
+        }
+
+        // Scatter the rows into Morton order.
+        // Coordinates outside of the image get the first pixel, which is what GridBase2D::getValue gave before.
+        TexturePixel *cells_r = this->textures.back().texture_p->getDirectGridData();
+        const TexturePixel outside_pixel = rows.empty() ? TexturePixel() : rows[0];
+
+        for(size_t y = 0; y < TEXTURE_SIZE; y++) {
+            for(size_t x = 0; x < TEXTURE_SIZE; x++) {
+                cells_r[ MORTON_TABLE[x] | (MORTON_TABLE[y] << 1) ] = (x < WIDTH && y < HEIGHT) ? rows[ y * WIDTH + x ] : outside_pixel;
             }
         }
     }
@@ -118,6 +162,13 @@ bool Environment::getBoundingBoxDraw() const {
 void Environment::setBoundingBoxDraw(bool draw) {
 }
 
+bool Environment::getWorldQuantization() const {
+    return false;
+}
+
+void Environment::setWorldQuantization(bool quantize) {
+}
+
 void Environment::setupFrame() {
 }
 
@@ -134,10 +185,10 @@ void Environment::drawFrameThread(Window::RenderingRect &rendering_rect) {
         // Convert remaining differred textures to color.
         std::for_each(
             rendering_rect.differred_buffer.getGridData().begin(), rendering_rect.differred_buffer.getGridData().end(),
-            [lambda_textures](Window::DifferredPixel &source_pixel) {
+            [&lambda_textures](Window::DifferredPixel &source_pixel) {
                 if(source_pixel.colors[3] != 0) {
-                    auto slot = lambda_textures[source_pixel.colors[3]];
-                    auto texture_pixel = slot.texture_p->getValue( source_pixel.texture_coordinates[0], source_pixel.texture_coordinates[1] );
+                    const auto &slot = lambda_textures[source_pixel.colors[3]];
+                    const auto &texture_pixel = sampleTexture( *slot.texture_p, source_pixel.texture_coordinates[0], source_pixel.texture_coordinates[1] );
 
                     source_pixel.colors[0] = (static_cast<unsigned>(source_pixel.colors[0]) * static_cast<unsigned>(texture_pixel.data[0])) >> 8;
                     source_pixel.colors[1] = (static_cast<unsigned>(source_pixel.colors[1]) * static_cast<unsigned>(texture_pixel.data[1])) >> 8;
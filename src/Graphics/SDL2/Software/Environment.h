@@ -11,9 +11,10 @@
 #include "Internal/FontDraw2D.h"
 #include "Internal/ImageDraw2D.h"
 
+#include <array>
 #include <set>
 
-#define CBMP_TEXTURE Utilities::GridBase2D<TexturePixel>
+#define CBMP_TEXTURE Utilities::GridBase2D<TexturePixel, Utilities::Grid2DPlacementMorbin>
 
 namespace Graphics::SDL2::Software {
 
@@ -33,6 +34,23 @@ public:
 
     std::vector<CBMPTexture> textures;
 
+    // The texture coordinates are 8 bits, so every CBMP texture is stored as a 256 by 256 Morton ordered grid.
+    constexpr static Utilities::grid_2d_unit TEXTURE_SIZE = 256;
+
+    // This spreads the 8 bits of a coordinate onto the even bits, so the y coordinate only needs a shift.
+    static const std::array<uint16_t, TEXTURE_SIZE> MORTON_TABLE;
+
+    /**
+     * This reads a pixel of a CBMP texture without any bounds checking.
+     * @param texture The texture which must be TEXTURE_SIZE by TEXTURE_SIZE.
+     * @param x The x texture coordinate.
+     * @param y The y texture coordinate.
+     * @return The texture pixel.
+     */
+    static const TexturePixel& sampleTexture( const CBMP_TEXTURE &texture, uint8_t x, uint8_t y ) {
+        return texture.getDirectGridData()[ MORTON_TABLE[ x ] | (MORTON_TABLE[ y ] << 1) ];
+    }
+
     Internal::Draw3D draw_3d;
     Internal::ExternalImageDraw2D external_image_draw_2d;
     Internal::FontDraw2D font_draw_2d;
@@ -76,6 +94,8 @@ public:
     virtual int setTilPolygonBlink( unsigned polygon_type, float rate = 1.0f);
     virtual bool getBoundingBoxDraw() const;
     virtual void setBoundingBoxDraw(bool draw);
+    virtual bool getWorldQuantization() const;
+    virtual void setWorldQuantization(bool quantize);
 };
 
 }
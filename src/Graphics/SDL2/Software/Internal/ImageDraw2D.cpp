@@ -58,8 +58,8 @@ void ImageDraw2D::draw(Window::RenderingRect &rendering_rect) const {
                 alpha = i->internal.color.a;
 
                 if(i->internal.cbmp_index != 0) {
-                    auto slot = rendering_rect.env_r->textures[i->internal.cbmp_index];
-                    auto texture_pixel = slot.texture_p->getValue( default_pixel.texture_coordinates[0], default_pixel.texture_coordinates[1] );
+                    const auto &slot = rendering_rect.env_r->textures[i->internal.cbmp_index];
+                    const auto &texture_pixel = Environment::sampleTexture( *slot.texture_p, default_pixel.texture_coordinates[0], default_pixel.texture_coordinates[1] );
 
                     if(static_cast<unsigned>(texture_pixel.data[3]) == 0)
                         continue;
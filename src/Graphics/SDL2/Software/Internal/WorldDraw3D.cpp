@@ -31,7 +31,6 @@ bool WorldDraw3D::load( const Data::Accessor &accessor ) {
         unsigned   position_compenent_index = model_p->getNumVertexComponents();
         unsigned      color_compenent_index = position_compenent_index;
         unsigned coordinate_compenent_index = position_compenent_index;
-        unsigned  tile_type_compenent_index = position_compenent_index;
 
         Utilities::ModelBuilder::VertexComponent element("EMPTY");
 
@@ -44,37 +43,33 @@ bool WorldDraw3D::load( const Data::Accessor &accessor ) {
                 color_compenent_index = i;
             if( name == Utilities::ModelBuilder::TEX_COORD_0_COMPONENT_NAME )
                 coordinate_compenent_index = i;
-            if( name == Data::Mission::TilResource::TILE_TYPE_COMPONENT_NAME )
-                tile_type_compenent_index = i;
         }
 
         size_t material_count = 0;
 
         this->sections.push_back( {} );
 
+        std::vector<glm::vec3>   positions;
+        std::vector<glm::vec4>      colors;
+        std::vector<glm::vec2> coordinates;
+
         for( unsigned int a = 0; a < model_p->getNumMaterials(); a++ ) {
             model_p->getMaterial( a, material );
 
-            glm::vec4   positions = glm::vec4(0, 0, 0, 1);
-            glm::vec4     normals = glm::vec4(0, 0, 0, 1);
-            glm::vec4      colors = glm::vec4(0.5, 0.5, 0.5, 0.5); // Just in case if the mesh does not have vertex color information.
-            glm::vec4 coordinates = glm::vec4(0, 0, 0, 1);
-            glm::vec4   tile_type = glm::vec4(0, 0, 0, 1);
+            // Read every vertex of the material at once.
+            model_p->getAttributes(   positions,   position_compenent_index, material_count, material.count );
+            model_p->getAttributes(      colors,      color_compenent_index, material_count, material.count, glm::vec4(0.5, 0.5, 0.5, 0.5) ); // Just in case if the mesh does not have vertex color information.
+            model_p->getAttributes( coordinates, coordinate_compenent_index, material_count, material.count );
 
             const unsigned vertex_per_triangle = 3;
 
-            for( unsigned m = 0; m < material.count; m += vertex_per_triangle ) {
+            for( unsigned m = 0; m + vertex_per_triangle <= material.count; m += vertex_per_triangle ) {
                 Vertex vertex;
 
                 for( unsigned t = 0; t < 3; t++ ) {
-                    model_p->getTransformation(   positions,   position_compenent_index, material_count + m + t );
-                    model_p->getTransformation(      colors,      color_compenent_index, material_count + m + t );
-                    model_p->getTransformation( coordinates, coordinate_compenent_index, material_count + m + t );
-                    model_p->getTransformation(   tile_type,  tile_type_compenent_index, material_count + m + t );
-
-                    vertex.position = { positions.x, positions.y, positions.z };
-                    vertex.color    = {255.0 * colors.x, 255.0 * colors.y, 255.0 * colors.z};
-                    vertex.uv       = {255.0 * coordinates.x, 255.0 * coordinates.y};
+                    vertex.position = positions[ m + t ];
+                    vertex.color    = {255.0 * colors[ m + t ].x, 255.0 * colors[ m + t ].y, 255.0 * colors[ m + t ].z};
+                    vertex.uv       = {255.0 * coordinates[ m + t ].x, 255.0 * coordinates[ m + t ].y};
 
                     this->sections.back().vertices.push_back( vertex );
                 }
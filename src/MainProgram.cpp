@@ -138,7 +138,8 @@ bool MainProgram::switchToResource( std::string switch_resource_identifier, Data
         return false;
     }
 
-    this->manager.setLoad( this->importance_level );
+    // If the mission was prefetched by the manager then setLoad takes it instead of opening it again.
+    this->manager.setLoad( this->importance_level, 0 );
 
     // Check if the given resource successfully loaded if not return false.
     auto switch_resource_r = manager.getIFFEntry( switch_resource_identifier ).getIFF( switch_platform );
@@ -163,7 +164,7 @@ bool MainProgram::switchToResource( std::string switch_resource_identifier, Data
         this->manager.togglePlatform( this->platform, false );
     }
 
-    this->manager.setLoad( this->importance_level );
+    this->manager.setLoad( this->importance_level, 0 );
 
     if( switch_platform != this->platform ) {
         auto switch_global_resource_r = manager.getIFFEntry( Data::Manager::global ).getIFF( switch_platform );
@@ -345,6 +346,10 @@ void MainProgram::setupSound() {
 void MainProgram::initialLoadResources() {
     this->accessor.clear();
 
+    Data::Mission::IFF::OpenSettings open_settings = manager.getOpenSettings();
+    open_settings.use_index_cache = options.getUseIndexCache();
+    manager.setOpenSettings( open_settings );
+
     manager.autoSetEntries( options.getWindowsDataDirectory(),     Data::Manager::Platform::WINDOWS );
     manager.autoSetEntries( options.getMacintoshDataDirectory(),   Data::Manager::Platform::MACINTOSH );
     manager.autoSetEntries( options.getPlaystationDataDirectory(), Data::Manager::Platform::PLAYSTATION );
@@ -375,7 +380,7 @@ void MainProgram::initialLoadResources() {
 
     manager.togglePlatform( this->platform, true );
 
-    manager.setLoad( this->importance_level );
+    manager.setLoad( this->importance_level, 0 );
 
     this->accessor.load( this->embedded );
 
@@ -407,6 +412,8 @@ void MainProgram::initialLoadResources() {
 
 void MainProgram::loadGraphics( bool show_map ) {
     if(!this->is_graphics_already_loaded) {
+        this->environment_p->setWorldQuantization( this->options.getVideoQuantizeWorld() );
+
         auto result = this->environment_p->loadResources( this->accessor );
 
         auto log = Utilities::logger.getLog( Utilities::Logger::ERROR );
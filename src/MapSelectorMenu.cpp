@@ -25,6 +25,9 @@ public:
                 menu_select_r->missing_global = main_program.text_2d_buffer_r->splitText( menu_select_r->error_font, entry.getPath( main_program.platform ).string(), menu_select_r->missing_line_length );
         }
         else if(dynamic_cast<MapSelectorMenu*>(menu_r)->game_r != &PrimaryGame::primary_game) {
+            // The manager takes the prefetch of this map when it gets loaded, so unload must not drop it.
+            dynamic_cast<MapSelectorMenu*>(menu_r)->prefetch_name.clear();
+
             MediaPlayer::media_player.clearMediaPaths();
 
             main_program.switchMenu( nullptr );
@@ -33,6 +36,8 @@ public:
             main_program.transitionToResource( item_r->name, main_program.platform );
         }
         else {
+            dynamic_cast<MapSelectorMenu*>(menu_r)->prefetch_name.clear();
+
             MediaPlayer::media_player.next_menu_r  = nullptr;
             MediaPlayer::media_player.next_state_r = dynamic_cast<MapSelectorMenu*>(menu_r)->game_r;
 
@@ -132,18 +137,51 @@ void MapSelectorMenu::load( MainProgram &main_program ) {
     this->missing_resource = {};
     this->missing_global   = {};
 
+    this->highlighted_name.clear();
+    this->highlighted_time = std::chrono::microseconds( 0 );
+    this->prefetch_name.clear();
+
     this->title_position = glm::vec2( center, 0 );
 
     this->current_item_index = 0;
 }
 
 void MapSelectorMenu::unload( MainProgram &main_program ) {
+    // No map got picked, so the prefetch is not needed.
+    if( !this->prefetch_name.empty() ) {
+        main_program.manager.dropPrefetch( this->prefetch_name, main_program.platform );
 
+        this->prefetch_name.clear();
+    }
 }
 
 void MapSelectorMenu::update( MainProgram &main_program, std::chrono::microseconds delta ) {
     Menu::update( main_program, delta );
 
+    // Open the highlighted map in the background, so picking it does not wait for all of the loading.
+    // The delay keeps scrolling through the list from starting a prefetch for every map that gets passed.
+    if( this->current_item_index < Data::Manager::AMOUNT_OF_IFF_IDS ) {
+        const std::string &map_name = *Data::Manager::map_iffs[ this->current_item_index ];
+
+        if( this->highlighted_name != map_name ) {
+            this->highlighted_name = map_name;
+            this->highlighted_time = std::chrono::microseconds( 0 );
+        }
+        else if( this->prefetch_name != map_name ) {
+            this->highlighted_time += delta;
+
+            if( this->highlighted_time >= std::chrono::milliseconds( 250 ) ) {
+                if( !this->prefetch_name.empty() )
+                    main_program.manager.dropPrefetch( this->prefetch_name, main_program.platform );
+
+                this->prefetch_name = map_name;
+
+                if( Utilities::Options::Tools::isFile( main_program.manager.getIFFEntry( map_name ).getPath( main_program.platform ) ) )
+                    main_program.manager.prefetch( map_name, main_program.platform );
+            }
+        }
+    }
+
     const auto text_2d_buffer_r = main_program.text_2d_buffer_r;
 
     text_2d_buffer_r->setColor( glm::vec4( 1 ) );
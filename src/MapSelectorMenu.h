@@ -23,6 +23,13 @@ public:
     std::vector<std::string> missing_resource;
     std::vector<std::string> missing_global;
 
+    // The map that has been highlighted, and for how long. It gets prefetched once it has been highlighted long enough.
+    std::string highlighted_name;
+    std::chrono::microseconds highlighted_time;
+
+    // The map that is being prefetched by this menu. It is cleared once the map is picked, so unload does not drop it.
+    std::string prefetch_name;
+
     virtual ~MapSelectorMenu();
 
     virtual void load( MainProgram &main_program );
@@ -313,6 +313,9 @@ void PrimaryGame::update( MainProgram &main_program, std::chrono::microseconds d
             this->platform_index = (this->platform_index + 1) % Data::Manager::Platform::ALL;
 
         this->map_index = (this->map_index + 1) % Data::Manager::AMOUNT_OF_IFF_IDS;
+
+        // Open the map after this one while the current map is being shown.
+        main_program.manager.prefetch( *Data::Manager::map_iffs[ this->map_index ], platforms[ this->platform_index ] );
     }
     #endif
 
@@ -0,0 +1,235 @@
+#include "../../Data/Accessor.h"
+#include "../../Data/Mission/BMPResource.h"
+#include "../../Data/Mission/DCSResource.h"
+#include "../../Data/Mission/FUNResource.h"
+#include "../../Data/Mission/NetResource.h"
+#include "../../Data/Mission/PYRResource.h"
+#include "../../Data/Mission/RPNSResource.h"
+#include "../../Data/Mission/SHDResource.h"
+#include "../../Data/Mission/WAVResource.h"
+#include <iostream>
+#include <map>
+#include <utility>
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    // The tags are not constant expressions, so the types are told apart with if statements.
+    const uint32_t TYPES[] = {
+        Data::Mission::BMPResource::IDENTIFIER_TAG,
+        Data::Mission::DCSResource::IDENTIFIER_TAG,
+        Data::Mission::FUNResource::IDENTIFIER_TAG,
+        Data::Mission::NetResource::IDENTIFIER_TAG,
+        Data::Mission::PYRResource::IDENTIFIER_TAG,
+        Data::Mission::RPNSResource::IDENTIFIER_TAG,
+        Data::Mission::SHDResource::IDENTIFIER_TAG,
+        Data::Mission::WAVResource::IDENTIFIER_TAG };
+
+    // The resources get ids up to this one. Only some of them are given to each type, so the others are missing.
+    const uint32_t MAX_RESOURCE_ID = 80;
+
+    Data::Mission::Resource* makeResource( uint32_t type ) {
+        if( type == Data::Mission::BMPResource::IDENTIFIER_TAG )
+            return new Data::Mission::BMPResource;
+        else if( type == Data::Mission::DCSResource::IDENTIFIER_TAG )
+            return new Data::Mission::DCSResource;
+        else if( type == Data::Mission::FUNResource::IDENTIFIER_TAG )
+            return new Data::Mission::FUNResource;
+        else if( type == Data::Mission::NetResource::IDENTIFIER_TAG )
+            return new Data::Mission::NetResource;
+        else if( type == Data::Mission::PYRResource::IDENTIFIER_TAG )
+            return new Data::Mission::PYRResource;
+        else if( type == Data::Mission::RPNSResource::IDENTIFIER_TAG )
+            return new Data::Mission::RPNSResource;
+        else if( type == Data::Mission::SHDResource::IDENTIFIER_TAG )
+            return new Data::Mission::SHDResource;
+        else
+            return new Data::Mission::WAVResource;
+    }
+
+    /**
+     * This fills the IFF with resources of every type in TYPES. The ids are given out of order, and some of them are given twice.
+     * @param seed This changes which ids each type gets.
+     */
+    void fillIFF( Data::Mission::IFF &iff, uint32_t seed ) {
+        for( unsigned t = 0; t < sizeof( TYPES ) / sizeof( TYPES[0] ); t++ ) {
+            for( uint32_t i = 0; i < 24; i++ ) {
+                // 37 is coprime with MAX_RESOURCE_ID, so the ids are scattered. Zero means that a resource has no id, so it is skipped.
+                const uint32_t resource_id = 1 + ( seed + 7 * t + 37 * i ) % MAX_RESOURCE_ID;
+
+                Data::Mission::Resource *resource_p = makeResource( TYPES[ t ] );
+                resource_p->setResourceID( resource_id );
+                iff.addResource( resource_p );
+
+                // The later resource with the same type and id must replace the earlier one.
+                if( i % 5 == 0 ) {
+                    resource_p = makeResource( TYPES[ t ] );
+                    resource_p->setResourceID( resource_id );
+                    iff.addResource( resource_p );
+                }
+            }
+        }
+    }
+
+    const Data::Mission::Resource* getHashed( const Data::Accessor &accessor, uint32_t type, uint32_t resource_id ) {
+        if( type == Data::Mission::BMPResource::IDENTIFIER_TAG )
+            return accessor.getConstBMP( resource_id );
+        else if( type == Data::Mission::DCSResource::IDENTIFIER_TAG )
+            return accessor.getConstDCS( resource_id );
+        else if( type == Data::Mission::FUNResource::IDENTIFIER_TAG )
+            return accessor.getConstFUN( resource_id );
+        else if( type == Data::Mission::NetResource::IDENTIFIER_TAG )
+            return accessor.getConstNET( resource_id );
+        else if( type == Data::Mission::PYRResource::IDENTIFIER_TAG )
+            return accessor.getConstPYR( resource_id );
+        else if( type == Data::Mission::RPNSResource::IDENTIFIER_TAG )
+            return accessor.getConstRPNS( resource_id );
+        else if( type == Data::Mission::SHDResource::IDENTIFIER_TAG )
+            return accessor.getConstSHD( resource_id );
+        else
+            return accessor.getConstWAV( resource_id );
+    }
+
+    const Data::Mission::Resource* getHashed( Data::Accessor &accessor, uint32_t type, uint32_t resource_id ) {
+        if( type == Data::Mission::BMPResource::IDENTIFIER_TAG )
+            return accessor.getBMP( resource_id );
+        else if( type == Data::Mission::DCSResource::IDENTIFIER_TAG )
+            return accessor.getDCS( resource_id );
+        else if( type == Data::Mission::FUNResource::IDENTIFIER_TAG )
+            return accessor.getFUN( resource_id );
+        else if( type == Data::Mission::NetResource::IDENTIFIER_TAG )
+            return accessor.getNET( resource_id );
+        else if( type == Data::Mission::PYRResource::IDENTIFIER_TAG )
+            return accessor.getPYR( resource_id );
+        else if( type == Data::Mission::RPNSResource::IDENTIFIER_TAG )
+            return accessor.getRPNS( resource_id );
+        else if( type == Data::Mission::SHDResource::IDENTIFIER_TAG )
+            return accessor.getSHD( resource_id );
+        else
+            return accessor.getWAV( resource_id );
+    }
+
+    size_t getAllAmount( const Data::Accessor &accessor, uint32_t type ) {
+        if( type == Data::Mission::BMPResource::IDENTIFIER_TAG )
+            return accessor.getAllConstBMP().size();
+        else if( type == Data::Mission::DCSResource::IDENTIFIER_TAG )
+            return accessor.getAllConstDCS().size();
+        else if( type == Data::Mission::FUNResource::IDENTIFIER_TAG )
+            return accessor.getAllConstFUN().size();
+        else if( type == Data::Mission::NetResource::IDENTIFIER_TAG )
+            return accessor.getAllConstNET().size();
+        else if( type == Data::Mission::PYRResource::IDENTIFIER_TAG )
+            return accessor.getAllConstPYR().size();
+        else if( type == Data::Mission::RPNSResource::IDENTIFIER_TAG )
+            return accessor.getAllConstRPNS().size();
+        else if( type == Data::Mission::SHDResource::IDENTIFIER_TAG )
+            return accessor.getAllConstSHD().size();
+        else
+            return accessor.getAllConstWAV().size();
+    }
+
+    /**
+     * This is the linear search that the hashed lookups must match. The last loaded resource with the type and the id wins.
+     */
+    std::map<std::pair<uint32_t, uint32_t>, const Data::Mission::Resource*> getLinearResults( const std::vector<const Data::Mission::IFF*> &iffs ) {
+        std::map<std::pair<uint32_t, uint32_t>, const Data::Mission::Resource*> results;
+
+        for( uint32_t type : TYPES ) {
+            for( uint32_t resource_id = 0; resource_id <= MAX_RESOURCE_ID + 1; resource_id++ ) {
+                const Data::Mission::Resource *found_r = nullptr;
+
+                for( const Data::Mission::IFF *iff_r : iffs ) {
+                    for( const Data::Mission::Resource *resource_r : iff_r->getAllResources() ) {
+                        if( resource_r->getResourceTagID() == type && resource_r->getResourceID() == resource_id )
+                            found_r = resource_r;
+                    }
+                }
+
+                results[ { type, resource_id } ] = found_r;
+            }
+        }
+
+        return results;
+    }
+
+    template<class A>
+    int compareLookups( const std::string &name, A &accessor, const std::vector<const Data::Mission::IFF*> &iffs ) {
+        const auto linear_results = getLinearResults( iffs );
+        std::map<uint32_t, size_t> type_amounts;
+        int is_not_success = SUCCESS;
+
+        for( const auto &result : linear_results ) {
+            const uint32_t type = result.first.first;
+            const uint32_t resource_id = result.first.second;
+            const Data::Mission::Resource *hashed_r = getHashed( accessor, type, resource_id );
+
+            if( hashed_r != result.second ) {
+                std::cout << name << ": the hashed lookup of type 0x" << std::hex << type << std::dec << " and id " << resource_id
+                    << ( result.second == nullptr ? " should be missing" : " gives the wrong resource" ) << std::endl;
+                is_not_success = FAILURE;
+            }
+
+            if( result.second != nullptr )
+                type_amounts[ type ]++;
+        }
+
+        for( uint32_t type : TYPES ) {
+            if( getAllAmount( accessor, type ) != type_amounts[ type ] ) {
+                std::cout << name << ": type 0x" << std::hex << type << std::dec << " has " << getAllAmount( accessor, type )
+                    << " resources instead of " << type_amounts[ type ] << std::endl;
+                is_not_success = FAILURE;
+            }
+        }
+
+        return is_not_success;
+    }
+
+    int testHashedLookups() {
+        int is_not_success = SUCCESS;
+        Data::Mission::IFF first_iff;
+        Data::Mission::IFF second_iff;
+
+        fillIFF( first_iff, 0 );
+        fillIFF( second_iff, 11 );
+
+        Data::Accessor accessor;
+
+        accessor.load( first_iff );
+
+        is_not_success |= compareLookups( "One IFF", accessor, { &first_iff } );
+
+        // The second IFF replaces the resources that the first one has in common with it.
+        accessor.load( second_iff );
+
+        is_not_success |= compareLookups( "Two IFFs", accessor, { &first_iff, &second_iff } );
+
+        const Data::Accessor &constant_accessor = accessor;
+
+        is_not_success |= compareLookups( "Two IFFs constant", constant_accessor, { &first_iff, &second_iff } );
+
+        Data::Accessor loaded_constant;
+
+        loaded_constant.loadConstant( first_iff );
+        loaded_constant.loadConstant( second_iff );
+
+        is_not_success |= compareLookups( "Two constant IFFs", static_cast<const Data::Accessor&>( loaded_constant ), { &first_iff, &second_iff } );
+
+        const uint32_t constant_id = loaded_constant.getAllConstDCS().front()->getResourceID();
+
+        if( loaded_constant.getDCS( constant_id ) != nullptr ) {
+            std::cout << "Two constant IFFs: a changable resource is given for a constant load" << std::endl;
+            is_not_success = FAILURE;
+        }
+
+        return is_not_success;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    is_not_success |= testHashedLookups();
+
+    return is_not_success;
+}
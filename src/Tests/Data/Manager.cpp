@@ -0,0 +1,105 @@
+#include "../../Data/Manager.h"
+#include <iostream>
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    const std::string NAME = "prefetch-test";
+
+    // The prefetched file does not exist, so the background threads finish quickly.
+    void setEntry( Data::Manager &manager, Data::Manager::Importance importance ) {
+        Data::Manager::IFFEntry entry;
+
+        entry.setPath( Data::Manager::WINDOWS,   "missing_prefetch_test.iff" );
+        entry.setPath( Data::Manager::MACINTOSH, "missing_prefetch_test.iff" );
+        entry.importance = importance;
+
+        manager.setIFFEntry( NAME, entry );
+    }
+
+    int checkImportance( Data::Manager &manager, Data::Manager::Importance expected, const std::string &when ) {
+        const Data::Manager::Importance importance = manager.getIFFEntry( NAME ).importance;
+
+        if( importance != expected ) {
+            std::cout << "Error: the importance is " << importance << " instead of " << expected << " " << when << "." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+
+    int testDropRestoresImportance() {
+        Data::Manager manager;
+        int is_not_success = SUCCESS;
+
+        setEntry( manager, Data::Manager::NOT_NEEDED );
+
+        if( !manager.prefetch( NAME, Data::Manager::WINDOWS ) ) {
+            std::cout << "Error: the prefetch did not start." << std::endl;
+            return FAILURE;
+        }
+
+        is_not_success |= checkImportance( manager, Data::Manager::CACHE_NEXT, "after the prefetch" );
+
+        if( !manager.dropPrefetch( NAME, Data::Manager::WINDOWS ) ) {
+            std::cout << "Error: the prefetch could not be dropped." << std::endl;
+            return FAILURE;
+        }
+
+        is_not_success |= checkImportance( manager, Data::Manager::NOT_NEEDED, "after the prefetch got dropped" );
+
+        return is_not_success;
+    }
+
+    int testDropKeepsImportance() {
+        Data::Manager manager;
+        int is_not_success = SUCCESS;
+
+        // The prefetch did not raise this importance, so it must not change it.
+        setEntry( manager, Data::Manager::NEEDED );
+
+        manager.prefetch( NAME, Data::Manager::WINDOWS );
+        manager.dropPrefetch( NAME, Data::Manager::WINDOWS );
+
+        is_not_success |= checkImportance( manager, Data::Manager::NEEDED, "after the prefetch of a needed entry got dropped" );
+
+        return is_not_success;
+    }
+
+    int testDropOfEveryPlatform() {
+        Data::Manager manager;
+        int is_not_success = SUCCESS;
+
+        setEntry( manager, Data::Manager::NOT_NEEDED );
+
+        manager.prefetch( NAME, Data::Manager::WINDOWS );
+        manager.prefetch( NAME, Data::Manager::MACINTOSH );
+
+        // The other platform is still being prefetched.
+        manager.dropPrefetch( NAME, Data::Manager::WINDOWS );
+
+        is_not_success |= checkImportance( manager, Data::Manager::CACHE_NEXT, "while another platform is being prefetched" );
+
+        manager.dropPrefetch( NAME, Data::Manager::MACINTOSH );
+
+        is_not_success |= checkImportance( manager, Data::Manager::NOT_NEEDED, "after every platform got dropped" );
+
+        manager.prefetch( NAME, Data::Manager::WINDOWS );
+        manager.cancelPrefetches();
+
+        is_not_success |= checkImportance( manager, Data::Manager::NOT_NEEDED, "after the prefetches got cancelled" );
+
+        return is_not_success;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    is_not_success |= testDropRestoresImportance();
+    is_not_success |= testDropKeepsImportance();
+    is_not_success |= testDropOfEveryPlatform();
+
+    return is_not_success;
+}
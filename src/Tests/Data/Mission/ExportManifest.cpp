@@ -0,0 +1,123 @@
+#include "../../../Data/Mission/ExportManifest.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using Data::Mission::ExportManifest;
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    void writeFile( const std::filesystem::path &path ) {
+        std::ofstream file( path, std::ios::binary | std::ios::out | std::ios::trunc );
+
+        file.put( 'x' );
+    }
+
+    ExportManifest makeManifest() {
+        ExportManifest manifest;
+        ExportManifest::Entry entry;
+
+        entry.content_hash = 0x0123456789abcdef;
+        entry.options_digest = 0xfedcba9876543210;
+        entry.output_names.push_back( "cbmp_1.png" );
+        entry.output_names.push_back( "cbmp_1_paletted.png" );
+
+        manifest.entries[ "cbmp_1" ] = entry;
+
+        entry.content_hash = 7;
+        entry.output_names.clear();
+
+        manifest.entries[ "cfun_2" ] = entry;
+
+        return manifest;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    const std::filesystem::path folder_path = std::filesystem::temp_directory_path() / "fc_export_manifest_test";
+    const std::filesystem::path manifest_path = ExportManifest::getManifestPath( folder_path );
+
+    std::filesystem::create_directories( folder_path );
+
+    const ExportManifest expected = makeManifest();
+
+    if( !expected.write( manifest_path ) ) {
+        std::cout << "Error: the manifest could not be written." << std::endl;
+        std::filesystem::remove_all( folder_path );
+        return FAILURE;
+    }
+
+    ExportManifest result;
+
+    if( !result.read( manifest_path ) ) {
+        std::cout << "Error: the manifest that got just written could not be read." << std::endl;
+        is_not_success = FAILURE;
+    }
+    else if( result.entries.size() != expected.entries.size() ) {
+        std::cout << "Error: expected " << expected.entries.size() << " entries, but got " << result.entries.size() << "." << std::endl;
+        is_not_success = FAILURE;
+    }
+    else {
+        for( const auto &entry : expected.entries ) {
+            auto result_entry = result.entries.find( entry.first );
+
+            if( result_entry == result.entries.end() ) {
+                std::cout << "Error: the entry " << entry.first << " is missing." << std::endl;
+                is_not_success = FAILURE;
+            }
+            else if( result_entry->second.content_hash != entry.second.content_hash || result_entry->second.options_digest != entry.second.options_digest || result_entry->second.output_names != entry.second.output_names ) {
+                std::cout << "Error: the entry " << entry.first << " does not match." << std::endl;
+                is_not_success = FAILURE;
+            }
+        }
+    }
+
+    const uint64_t HASH   = 0x0123456789abcdef;
+    const uint64_t DIGEST = 0xfedcba9876543210;
+
+    // Only one of the two files is there.
+    writeFile( folder_path / "cbmp_1.png" );
+
+    if( result.isUpToDate( folder_path, "cbmp_1", HASH, DIGEST ) ) {
+        std::cout << "Error: the resource is up to date even though one of its files is missing." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    writeFile( folder_path / "cbmp_1_paletted.png" );
+
+    if( !result.isUpToDate( folder_path, "cbmp_1", HASH, DIGEST ) ) {
+        std::cout << "Error: the resource is not up to date even though nothing changed." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    if( result.isUpToDate( folder_path, "cbmp_1", HASH + 1, DIGEST ) ) {
+        std::cout << "Error: the resource is up to date even though its content changed." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    if( result.isUpToDate( folder_path, "cbmp_1", HASH, DIGEST + 1 ) ) {
+        std::cout << "Error: the resource is up to date even though the options changed." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    if( result.isUpToDate( folder_path, "cbmp_2", HASH, DIGEST ) ) {
+        std::cout << "Error: a resource that was never exported is up to date." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    // A truncated manifest must give an empty manifest.
+    std::filesystem::resize_file( manifest_path, std::filesystem::file_size( manifest_path ) - 3 );
+
+    if( result.read( manifest_path ) || !result.entries.empty() ) {
+        std::cout << "Error: the truncated manifest got read." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    std::filesystem::remove_all( folder_path );
+
+    return is_not_success;
+}
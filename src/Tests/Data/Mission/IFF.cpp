@@ -0,0 +1,400 @@
+#include "../../../Data/Mission/IFF.h"
+#include "../../../Data/Mission/BMPResource.h"
+#include "../../../Data/Mission/DCSResource.h"
+#include "../../../Data/Mission/IFFIndex.h"
+#include "../../../Data/Mission/ObjResource.h"
+#include "../../../Utilities/Logger.h"
+#include "../../../Utilities/Parallel.h"
+#include "Embedded/CBMP.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    const size_t BLOCK_SIZE = 0x6000;
+
+    const uint32_t CTRL_TAG = 0x4354524C;
+    const uint32_t FILL_TAG = 0x46494C4C;
+    const uint32_t SHOC_TAG = 0x53484F43;
+    const uint32_t SHDR_TAG = 0x53484452;
+    const uint32_t SDAT_TAG = 0x53444154;
+
+    const unsigned DCS_AMOUNT = 4;
+    const unsigned RESOURCE_AMOUNT = DCS_AMOUNT + 2;
+
+    // IFF::open writes this to the debug log if the resources came from the index file.
+    const std::string INDEX_MESSAGE = "Resources are read from the index";
+
+    std::stringstream debug_log;
+
+    void writeU8( std::vector<uint8_t> &bytes, uint8_t value ) {
+        bytes.push_back( value );
+    }
+
+    void writeU16( std::vector<uint8_t> &bytes, uint16_t value ) {
+        writeU8( bytes, value & 0xFF );
+        writeU8( bytes, value >> 8 );
+    }
+
+    void writeU32( std::vector<uint8_t> &bytes, uint32_t value ) {
+        writeU16( bytes, value & 0xFFFF );
+        writeU16( bytes, value >> 16 );
+    }
+
+    /**
+     * This pads the rest of the block with a FILL chunk.
+     */
+    void fillBlock( std::vector<uint8_t> &bytes ) {
+        const size_t left = BLOCK_SIZE - bytes.size() % BLOCK_SIZE;
+
+        if( left == BLOCK_SIZE )
+            return;
+
+        if( left >= 8 ) {
+            writeU32( bytes, FILL_TAG );
+            writeU32( bytes, left );
+            bytes.resize( bytes.size() + left - 8, 0 );
+        }
+        else
+            bytes.resize( bytes.size() + left, 0 );
+    }
+
+    /**
+     * @return The amount of payload bytes that a chunk could still hold in the current block.
+     */
+    size_t getChunkSpace( const std::vector<uint8_t> &bytes ) {
+        const size_t used = bytes.size() % BLOCK_SIZE + 8;
+
+        // There must be room for a FILL chunk after every chunk of the block.
+        return used + 8 < BLOCK_SIZE ? BLOCK_SIZE - used - 8 : 0;
+    }
+
+    void writeChunk( std::vector<uint8_t> &bytes, uint32_t tag, const std::vector<uint8_t> &payload ) {
+        if( getChunkSpace( bytes ) < payload.size() )
+            fillBlock( bytes );
+
+        writeU32( bytes, tag );
+        writeU32( bytes, 8 + payload.size() );
+        bytes.insert( bytes.end(), payload.begin(), payload.end() );
+    }
+
+    /**
+     * This writes a resource as a SHDR chunk followed by SDAT chunks, which get split across the blocks like in the game files.
+     */
+    void writeResource( std::vector<uint8_t> &bytes, uint32_t type, uint32_t enum_number, uint32_t resource_id, const uint8_t *data_r, size_t size ) {
+        std::vector<uint8_t> payload;
+
+        writeU32( payload, 0 );
+        writeU32( payload, 0 );
+        writeU32( payload, SHDR_TAG );
+        writeU32( payload, enum_number );
+        writeU32( payload, type );
+        writeU32( payload, resource_id );
+        writeU32( payload, size );
+        for( int i = 0; i < 5; i++ )
+            writeU32( payload, 0 ); // The RPNS offsets and the code sizes.
+
+        writeChunk( bytes, SHOC_TAG, payload );
+
+        size_t position = 0;
+
+        while( position < size ) {
+            if( getChunkSpace( bytes ) < 0x100 )
+                fillBlock( bytes );
+
+            const size_t amount = std::min( size - position, getChunkSpace( bytes ) - 12 );
+
+            payload.clear();
+            writeU32( payload, 0 );
+            writeU32( payload, 0 );
+            writeU32( payload, SDAT_TAG );
+            payload.insert( payload.end(), data_r + position, data_r + position + amount );
+
+            writeChunk( bytes, SHOC_TAG, payload );
+
+            position += amount;
+        }
+    }
+
+    void writeBone( std::vector<uint8_t> &bytes, uint8_t parent_amount, int16_t position_y, int16_t rotation_x_index ) {
+        writeU8( bytes, parent_amount );
+        writeU8( bytes, 0 ); // normal_start
+        writeU8( bytes, 0 ); // normal_stride
+        writeU8( bytes, 0 ); // vertex_start
+        writeU8( bytes, 0 ); // vertex_stride
+        writeU8( bytes, 0 );
+        writeU8( bytes, 0 );
+        writeU8( bytes, 0b00111011 ); // Only the x rotation is animated.
+        writeU16( bytes, 0 );
+        writeU16( bytes, position_y );
+        writeU16( bytes, 0 );
+        writeU16( bytes, rotation_x_index );
+        writeU16( bytes, 0 );
+        writeU16( bytes, 0 );
+    }
+
+    /**
+     * This makes a little endian Obj resource of two bones with two frames.
+     */
+    std::vector<uint8_t> makeBonedObj() {
+        std::vector<uint8_t> bytes;
+
+        writeU32( bytes, 0x34444749 ); // 4DGI
+        writeU32( bytes, 0x3C );
+        writeU32( bytes, 1 );
+        writeU16( bytes, 2 );
+        writeU8( bytes, 0x01 );
+        writeU8( bytes, 0x02 ); // has_skeleton
+        for( int i = 0; i < 3; i++ )
+            writeU32( bytes, 0 );
+        writeU32( bytes, 1 );
+        writeU32( bytes, 2 );
+        writeU32( bytes, 1 );
+        writeU32( bytes, 1 );
+        writeU32( bytes, 3 );
+        writeU32( bytes, 0 ); // position_indexes
+        writeU32( bytes, 4 );
+        writeU32( bytes, 5 );
+
+        writeU32( bytes, 0x33444859 ); // 3DHY
+        writeU32( bytes, 8 + 4 + 0x14 * 2 );
+        writeU32( bytes, 1 );
+        writeBone( bytes, 0,   0, 0 );
+        writeBone( bytes, 1, 512, 2 );
+
+        writeU32( bytes, 0x33444D49 ); // 3DMI
+        writeU32( bytes, 8 + 4 + 4 * sizeof( int16_t ) );
+        writeU32( bytes, 1 );
+        for( int16_t rotation : { 256, 512, 1024, -128 } )
+            writeU16( bytes, rotation );
+
+        return bytes;
+    }
+
+    /**
+     * This makes a Windows IFF file of a texture, a model and some resources that nothing links to.
+     */
+    std::vector<uint8_t> makeIFF() {
+        std::vector<uint8_t> bytes;
+
+        writeU32( bytes, CTRL_TAG );
+        writeU32( bytes, 0x18 );
+        for( int i = 0; i < 4; i++ )
+            writeU32( bytes, 0 );
+
+        for( unsigned i = 0; i < DCS_AMOUNT; i++ ) {
+            const uint32_t entry_amount = 1 + 0x400 * i;
+            std::vector<uint8_t> data;
+
+            writeU32( data, Data::Mission::DCSResource::IDENTIFIER_TAG );
+            writeU32( data, 12 + 8 * entry_amount );
+            writeU32( data, entry_amount );
+
+            for( uint32_t e = 0; e < entry_amount; e++ ) {
+                writeU32( data, e * 0x01020304 + i );
+                writeU32( data, (e & 0xFF) << 24 ); // Only the id is set, so the pads are zero.
+            }
+
+            writeResource( bytes, Data::Mission::DCSResource::IDENTIFIER_TAG, 2, i + 1, data.data(), data.size() );
+        }
+
+        // The texture spans several blocks.
+        writeResource( bytes, Data::Mission::BMPResource::IDENTIFIER_TAG, 2, 1, windows_colors_cbmp, windows_colors_cbmp_len );
+
+        const std::vector<uint8_t> obj = makeBonedObj();
+
+        writeResource( bytes, Data::Mission::ObjResource::IDENTIFIER_TAG, 2, 1, obj.data(), obj.size() );
+
+        fillBlock( bytes );
+
+        return bytes;
+    }
+
+    bool isLinkedResource( const Data::Mission::Resource &resource ) {
+        return resource.getResourceTagID() == Data::Mission::BMPResource::IDENTIFIER_TAG || resource.getResourceTagID() == Data::Mission::ObjResource::IDENTIFIER_TAG;
+    }
+
+    int testDefaultSettings() {
+        if( Data::Mission::IFF::DEFAULT_OPEN_SETTINGS.parse_thread_amount != 1 ) {
+            std::cout << "Error: the default open settings parse with " << Data::Mission::IFF::DEFAULT_OPEN_SETTINGS.parse_thread_amount << " threads instead of one." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+
+    /**
+     * This opens the file with the deferred parse, then it checks that only the linked resources got parsed by the open,
+     * and that the rest parse on their first access to the same result as the open that parses everything.
+     */
+    int testTwoPhaseParse( const std::filesystem::path &iff_path, unsigned thread_amount ) {
+        const std::string name = "Two phase parse with " + std::to_string( thread_amount ) + " threads";
+
+        Data::Mission::IFF::OpenSettings eager_settings;
+        eager_settings.parse_thread_amount = thread_amount;
+
+        Data::Mission::IFF::OpenSettings lazy_settings = eager_settings;
+        lazy_settings.lazy_parse = true;
+
+        Data::Mission::IFF eager, lazy;
+
+        if( eager.open( iff_path, eager_settings ) != 1 || lazy.open( iff_path, lazy_settings ) != 1 ) {
+            std::cout << name << ": the IFF did not open." << std::endl;
+            return FAILURE;
+        }
+
+        std::vector<Data::Mission::Resource*> resources_r = lazy.getAllResources();
+
+        if( resources_r.size() != RESOURCE_AMOUNT || eager.getAllResources().size() != RESOURCE_AMOUNT ) {
+            std::cout << name << ": expected " << RESOURCE_AMOUNT << " resources, but got " << resources_r.size() << " and " << eager.getAllResources().size() << "." << std::endl;
+            return FAILURE;
+        }
+
+        for( const Data::Mission::Resource *resource_r : eager.getAllResources() ) {
+            if( !resource_r->isParsed() ) {
+                std::cout << name << ": the open without lazy_parse left resource " << resource_r->getResourceID() << " of " << resource_r->getFileExtension() << " unparsed." << std::endl;
+                return FAILURE;
+            }
+        }
+
+        for( const Data::Mission::Resource *resource_r : resources_r ) {
+            if( resource_r->isParsed() != isLinkedResource( *resource_r ) ) {
+                std::cout << name << ": resource " << resource_r->getResourceID() << " of " << resource_r->getFileExtension() << " has isParsed() = " << resource_r->isParsed() << " after the open." << std::endl;
+                return FAILURE;
+            }
+        }
+
+        // The link stage needs the texture and the model parsed.
+        auto lazy_bmp_r  = dynamic_cast<const Data::Mission::BMPResource*>( lazy.getResource( Data::Mission::BMPResource::IDENTIFIER_TAG ) );
+        auto eager_bmp_r = dynamic_cast<const Data::Mission::BMPResource*>( eager.getResource( Data::Mission::BMPResource::IDENTIFIER_TAG ) );
+
+        if( lazy_bmp_r == nullptr || eager_bmp_r == nullptr || lazy_bmp_r->getImage() == nullptr || eager_bmp_r->getImage() == nullptr ||
+            lazy_bmp_r->getImage()->getWidth() != eager_bmp_r->getImage()->getWidth() || lazy_bmp_r->getImage()->getHeight() != eager_bmp_r->getImage()->getHeight() ) {
+            std::cout << name << ": the texture is not the same as the one of the full parse." << std::endl;
+            return FAILURE;
+        }
+
+        auto lazy_obj_r = dynamic_cast<const Data::Mission::ObjResource*>( lazy.getResource( Data::Mission::ObjResource::IDENTIFIER_TAG ) );
+
+        if( lazy_obj_r == nullptr || lazy_obj_r->getNumBones() != 2 || lazy_obj_r->getNumBoneFrames() != 2 ) {
+            std::cout << name << ": the model did not get its bones." << std::endl;
+            return FAILURE;
+        }
+
+        // The deferred resources parse once on their first access, even if the threads race for it.
+        std::atomic<unsigned> failed_parses( 0 );
+
+        Utilities::Parallel::forEach( resources_r.size() * 2, thread_amount, [&]( size_t index ) {
+            if( !resources_r[ index % resources_r.size() ]->ensureParsed() )
+                failed_parses++;
+        } );
+
+        if( failed_parses != 0 ) {
+            std::cout << name << ": " << failed_parses << " ensureParsed calls failed." << std::endl;
+            return FAILURE;
+        }
+
+        std::stringstream compare_output;
+
+        if( lazy.compare( eager, compare_output ) != static_cast<int>( RESOURCE_AMOUNT ) ) {
+            std::cout << name << ": the resources do not match the full parse." << std::endl;
+            std::cout << compare_output.str() << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+
+    /**
+     * This opens the file twice with the index cache, and checks that only the second open reads the resources from the index file.
+     */
+    int testIndexCache( const std::filesystem::path &iff_path, bool memory_map ) {
+        const std::string name = std::string( "Index cache with" ) + (memory_map ? "" : "out") + " memory_map";
+
+        Data::Mission::IFF::OpenSettings settings;
+        settings.memory_map = memory_map;
+        settings.use_index_cache = true;
+
+        const std::filesystem::path index_path = Data::Mission::IFFIndex::getIndexPath( iff_path, settings.index_cache_directory );
+
+        std::filesystem::remove( index_path );
+
+        Data::Mission::IFF scanned, indexed;
+
+        debug_log.str( "" );
+
+        if( scanned.open( iff_path, settings ) != 1 ) {
+            std::cout << name << ": the first open failed." << std::endl;
+            return FAILURE;
+        }
+
+        if( debug_log.str().find( INDEX_MESSAGE ) != std::string::npos || !std::filesystem::exists( index_path ) ) {
+            std::cout << name << ": the first open did not scan the chunks and write the index file." << std::endl;
+            return FAILURE;
+        }
+
+        debug_log.str( "" );
+
+        if( indexed.open( iff_path, settings ) != 1 ) {
+            std::cout << name << ": the second open failed." << std::endl;
+            std::filesystem::remove( index_path );
+            return FAILURE;
+        }
+
+        std::filesystem::remove( index_path );
+
+        if( debug_log.str().find( INDEX_MESSAGE ) == std::string::npos ) {
+            std::cout << name << ": the second open did not read the resources from the index file." << std::endl;
+            return FAILURE;
+        }
+
+        std::stringstream compare_output;
+
+        if( indexed.compare( scanned, compare_output ) != static_cast<int>( RESOURCE_AMOUNT ) ) {
+            std::cout << name << ": the resources from the index do not match the ones from the chunk scan." << std::endl;
+            std::cout << compare_output.str() << std::endl;
+            return FAILURE;
+        }
+
+        auto obj_r = dynamic_cast<const Data::Mission::ObjResource*>( indexed.getResource( Data::Mission::ObjResource::IDENTIFIER_TAG ) );
+
+        if( obj_r == nullptr || !obj_r->isParsed() || obj_r->getNumBones() != 2 ) {
+            std::cout << name << ": the model from the index did not parse." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    Utilities::logger.setOutputLog( &debug_log, 0, Utilities::Logger::DEBUG, Utilities::Logger::DEBUG );
+
+    const std::filesystem::path iff_path = std::filesystem::temp_directory_path() / "fc_iff_test.iff";
+
+    {
+        const std::vector<uint8_t> bytes = makeIFF();
+        std::ofstream file( iff_path, std::ios::binary | std::ios::out | std::ios::trunc );
+
+        file.write( reinterpret_cast<const char*>( bytes.data() ), bytes.size() );
+    }
+
+    is_not_success |= testDefaultSettings();
+    is_not_success |= testTwoPhaseParse( iff_path, 1 );
+    is_not_success |= testTwoPhaseParse( iff_path, 4 );
+    is_not_success |= testIndexCache( iff_path, false );
+    is_not_success |= testIndexCache( iff_path, true );
+
+    std::filesystem::remove( iff_path );
+
+    return is_not_success;
+}
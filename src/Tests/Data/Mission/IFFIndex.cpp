@@ -0,0 +1,275 @@
+#include "../../../Data/Mission/IFFIndex.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using Data::Mission::IFFIndex;
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    void writeFile( const std::filesystem::path &path, size_t size ) {
+        std::ofstream file( path, std::ios::binary | std::ios::out | std::ios::trunc );
+
+        for( size_t i = 0; i < size; i++ )
+            file.put( static_cast<char>( i ) );
+    }
+
+    IFFIndex makeIndex() {
+        IFFIndex index;
+
+        index.endian = Utilities::Buffer::Endian::LITTLE;
+
+        IFFIndex::Record record;
+
+        record.kind = IFFIndex::SHOC;
+        record.tag = 0x4374696c;
+        record.resource_id = 7;
+        record.offset = 0x20;
+        record.mis_index_number = 3;
+        record.index_number = 2;
+
+        for( size_t i = 0; i < Data::Mission::Resource::RPNS_OFFSET_AMOUNT; i++ )
+            record.rpns_offsets[ i ] = 10 + i;
+
+        for( size_t i = 0; i < Data::Mission::Resource::CODE_AMOUNT; i++ )
+            record.code_sizes[ i ] = 20 + i;
+
+        record.swvr_entry.offset = 0;
+        record.swvr_entry.tos_offset = 0;
+        record.swvr_entry.name = "";
+        record.header_span = { 0x30, 4 };
+        record.spans.push_back( { 0x40, 0x80 } );
+        record.spans.push_back( { 0x100, 0x10 } );
+
+        index.records.push_back( record );
+
+        record.kind = IFFIndex::VAGM;
+        record.tag = 0x5641474D;
+        record.resource_id = 2;
+        record.swvr_entry.offset = 0x200;
+        record.swvr_entry.tos_offset = 0x100;
+        record.swvr_entry.name = "voice_1";
+        record.header_span = { 0, 0 };
+        record.spans.clear();
+        record.spans.push_back( { 0x180, 0x20 } );
+
+        index.records.push_back( record );
+
+        return index;
+    }
+
+    int compareRecords( const IFFIndex::Record &e, const IFFIndex::Record &r ) {
+        if( e.kind != r.kind || e.tag != r.tag || e.resource_id != r.resource_id || e.offset != r.offset || e.mis_index_number != r.mis_index_number || e.index_number != r.index_number ) {
+            std::cout << "Error: the header values of the record do not match." << std::endl;
+            return FAILURE;
+        }
+
+        for( size_t i = 0; i < Data::Mission::Resource::RPNS_OFFSET_AMOUNT; i++ ) {
+            if( e.rpns_offsets[ i ] != r.rpns_offsets[ i ] ) {
+                std::cout << "Error: rpns_offsets[" << i << "] does not match." << std::endl;
+                return FAILURE;
+            }
+        }
+
+        for( size_t i = 0; i < Data::Mission::Resource::CODE_AMOUNT; i++ ) {
+            if( e.code_sizes[ i ] != r.code_sizes[ i ] ) {
+                std::cout << "Error: code_sizes[" << i << "] does not match." << std::endl;
+                return FAILURE;
+            }
+        }
+
+        if( e.swvr_entry.offset != r.swvr_entry.offset || e.swvr_entry.tos_offset != r.swvr_entry.tos_offset || e.swvr_entry.name != r.swvr_entry.name ) {
+            std::cout << "Error: the SWVR entry of the record does not match." << std::endl;
+            return FAILURE;
+        }
+
+        if( e.header_span.offset != r.header_span.offset || e.header_span.size != r.header_span.size ) {
+            std::cout << "Error: the header span does not match." << std::endl;
+            return FAILURE;
+        }
+
+        if( e.spans.size() != r.spans.size() ) {
+            std::cout << "Error: expected " << e.spans.size() << " spans, but got " << r.spans.size() << "." << std::endl;
+            return FAILURE;
+        }
+
+        for( size_t i = 0; i < e.spans.size(); i++ ) {
+            if( e.spans[ i ].offset != r.spans[ i ].offset || e.spans[ i ].size != r.spans[ i ].size ) {
+                std::cout << "Error: span " << i << " does not match." << std::endl;
+                return FAILURE;
+            }
+        }
+
+        return SUCCESS;
+    }
+
+    void writeU32( std::vector<char> &bytes, size_t offset, uint32_t value ) {
+        for( size_t i = 0; i < sizeof( uint32_t ); i++ )
+            bytes[ offset + i ] = static_cast<char>( (value >> (8 * i)) & 0xFF );
+    }
+
+    std::vector<char> readBytes( const std::filesystem::path &path ) {
+        std::ifstream file( path, std::ios::binary | std::ios::in );
+
+        return std::vector<char>( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+    }
+
+    void writeBytes( const std::filesystem::path &path, const std::vector<char> &bytes ) {
+        std::ofstream file( path, std::ios::binary | std::ios::out | std::ios::trunc );
+
+        file.write( bytes.data(), bytes.size() );
+    }
+
+    /**
+     * This checks that a corrupt index file is refused without throwing.
+     */
+    int checkCorruptIndex( const std::string &name, const std::filesystem::path &index_path, const std::filesystem::path &iff_path, const std::vector<char> &bytes ) {
+        writeBytes( index_path, bytes );
+
+        IFFIndex result;
+
+        try {
+            if( result.read( index_path, iff_path ) ) {
+                std::cout << "Error: the index with " << name << " got read." << std::endl;
+                return FAILURE;
+            }
+        }
+        catch( const std::exception &exception ) {
+            std::cout << "Error: the index with " << name << " threw " << exception.what() << "." << std::endl;
+            return FAILURE;
+        }
+
+        if( !result.records.empty() ) {
+            std::cout << "Error: the index with " << name << " left records behind." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    const std::filesystem::path iff_path = std::filesystem::temp_directory_path() / "fc_iff_index_test.iff";
+    const std::filesystem::path index_path = IFFIndex::getIndexPath( iff_path, "" );
+
+    if( index_path.parent_path() != iff_path.parent_path() || index_path.filename() != "fc_iff_index_test.iff.fcindex" ) {
+        std::cout << "Error: getIndexPath gave " << index_path << "." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    writeFile( iff_path, 0x400 );
+
+    const IFFIndex expected = makeIndex();
+
+    if( !expected.write( index_path, iff_path ) ) {
+        std::cout << "Error: the index could not be written." << std::endl;
+        std::filesystem::remove( iff_path );
+        return FAILURE;
+    }
+
+    IFFIndex result;
+
+    if( !result.read( index_path, iff_path ) ) {
+        std::cout << "Error: the index that got just written could not be read." << std::endl;
+        is_not_success = FAILURE;
+    }
+    else {
+        if( result.endian != expected.endian ) {
+            std::cout << "Error: the endian does not match." << std::endl;
+            is_not_success = FAILURE;
+        }
+
+        if( result.records.size() != expected.records.size() ) {
+            std::cout << "Error: expected " << expected.records.size() << " records, but got " << result.records.size() << "." << std::endl;
+            is_not_success = FAILURE;
+        }
+        else {
+            for( size_t i = 0; i < expected.records.size(); i++ ) {
+                if( compareRecords( expected.records[ i ], result.records[ i ] ) != SUCCESS )
+                    is_not_success = FAILURE;
+            }
+        }
+    }
+
+    // A different file size must make the index stale.
+    writeFile( iff_path, 0x800 );
+
+    if( result.read( index_path, iff_path ) ) {
+        std::cout << "Error: the index got read even though the IFF file changed size." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    // A different modification time must also make the index stale.
+    writeFile( iff_path, 0x400 );
+    std::filesystem::last_write_time( iff_path, std::filesystem::last_write_time( iff_path ) + std::chrono::hours( 1 ) );
+
+    if( result.read( index_path, iff_path ) ) {
+        std::cout << "Error: the index got read even though the IFF file got modified." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    // Spans outside of the IFF file must not be trusted.
+    IFFIndex out_of_bounds = makeIndex();
+
+    out_of_bounds.records[0].spans.push_back( { 0x3f0, 0x20 } );
+
+    if( out_of_bounds.write( index_path, iff_path ) && result.read( index_path, iff_path ) ) {
+        std::cout << "Error: the index got read even though a span is outside the IFF file." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    // Spans that only fit because the offset plus the size wraps around must not be trusted.
+    IFFIndex wrap_around = makeIndex();
+
+    wrap_around.records[0].spans.push_back( { 0xFFFFFFFFFFFFFFF0, 0x20 } );
+
+    if( wrap_around.write( index_path, iff_path ) && result.read( index_path, iff_path ) ) {
+        std::cout << "Error: the index got read even though a span wraps around." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    // Corrupt index files must be refused, so IFF::open falls back to the chunk scan.
+    if( !expected.write( index_path, iff_path ) ) {
+        std::cout << "Error: the index could not be written again." << std::endl;
+        is_not_success = FAILURE;
+    }
+    else {
+        const std::vector<char> bytes = readBytes( index_path );
+
+        // The tag, the version, the path, the size, the modification time and the endian come before the record amount.
+        const size_t RECORD_AMOUNT_OFFSET = 4 + 4 + 4 + std::filesystem::absolute( iff_path ).string().size() + 8 + 8 + 1;
+
+        // The fixed values, the empty SWVR name and the header span come before the span amount of the first record.
+        const size_t SPAN_AMOUNT_OFFSET = RECORD_AMOUNT_OFFSET + 4 + 1 + 5 * 4 +
+            (Data::Mission::Resource::RPNS_OFFSET_AMOUNT + Data::Mission::Resource::CODE_AMOUNT) * 4 + 3 * 4 + 16;
+
+        for( size_t size : { bytes.size() / 2, bytes.size() - 1, RECORD_AMOUNT_OFFSET + 2 } ) {
+            std::vector<char> truncated( bytes.begin(), bytes.begin() + size );
+
+            is_not_success |= checkCorruptIndex( "a size of " + std::to_string( size ) + " bytes", index_path, iff_path, truncated );
+        }
+
+        std::vector<char> huge_record_amount = bytes;
+        writeU32( huge_record_amount, RECORD_AMOUNT_OFFSET, 0xFFFFFFFF );
+
+        is_not_success |= checkCorruptIndex( "a huge record amount", index_path, iff_path, huge_record_amount );
+
+        std::vector<char> huge_span_amount = bytes;
+        writeU32( huge_span_amount, SPAN_AMOUNT_OFFSET, 0xFFFFFFFF );
+
+        is_not_success |= checkCorruptIndex( "a huge span amount", index_path, iff_path, huge_span_amount );
+    }
+
+    std::filesystem::remove( index_path );
+    std::filesystem::remove( iff_path );
+
+    return is_not_success;
+}
@@ -15,11 +15,30 @@ bool compareBooleans( bool e, bool r, std::string field_name, std::ostream *info
     return true;
 }
 
+bool compareIntegers( int e, int r, std::string field_name, std::ostream *information_r ) {
+    if( e != r ) {
+        if( information_r != nullptr ) {
+            *information_r << "  expected." << field_name << " (" << e << ") != result." << field_name << " (" << r << ")" << std::endl;
+        }
+
+        return false;
+    }
+    return true;
+}
+
 bool IFFOptionCompare( const Data::Mission::IFFOptions a, const Data::Mission::IFFOptions b, std::ostream *information_r = nullptr ) {
     bool status = true;
 
     if( !compareBooleans( a.enable_global_dry_default, b.enable_global_dry_default, "enable_global_dry_default",information_r ) )
         status = false;
+    if( !compareBooleans( a.enable_glb, b.enable_glb, "enable_glb", information_r ) )
+        status = false;
+    if( !compareBooleans( a.enable_quantization, b.enable_quantization, "enable_quantization", information_r ) )
+        status = false;
+    if( !compareBooleans( a.enable_weld, b.enable_weld, "enable_weld", information_r ) )
+        status = false;
+    if( !compareIntegers( a.png_compression_level, b.png_compression_level, "png_compression_level", information_r ) )
+        status = false;
     if( !compareBooleans( a.act.override_dry, b.act.override_dry, "act.override_dry", information_r ) )
         status = false;
     if( !compareBooleans( a.anm.override_dry, b.anm.override_dry, "anm.override_dry", information_r ) )
@@ -177,6 +196,45 @@ int main() {
         }
     }
 
+    { // Test the digest.
+        Data::Mission::IFFOptions enabled_nothing;
+        Data::Mission::IFFOptions bmp_palette;
+
+        bmp_palette.bmp.export_palette = true;
+
+        if( enabled_nothing.getDigest() != Data::Mission::IFFOptions().getDigest() || enabled_nothing.getDigest() == bmp_palette.getDigest() ) {
+            std::cout << "Error: the digest does not follow the options!" << std::endl;
+            is_not_success = true;
+        }
+
+        Data::Mission::IFFOptions png_level;
+
+        png_level.png_compression_level = 9;
+
+        if( enabled_nothing.getDigest() == png_level.getDigest() ) {
+            std::cout << "Error: the PNG level should change the digest!" << std::endl;
+            is_not_success = true;
+        }
+
+        Data::Mission::IFFOptions welded;
+
+        welded.enable_weld = true;
+
+        if( enabled_nothing.enable_weld || enabled_nothing.getDigest() == welded.getDigest() ) {
+            std::cout << "Error: welding should be off by default, and it should change the digest!" << std::endl;
+            is_not_success = true;
+        }
+
+        Data::Mission::IFFOptions many_threads;
+
+        many_threads.thread_amount = 4;
+
+        if( enabled_nothing.thread_amount != 1 || enabled_nothing.getDigest() != many_threads.getDigest() ) {
+            std::cout << "Error: the thread amount should default to one, and it should not change the digest!" << std::endl;
+            is_not_success = true;
+        }
+    }
+
     { // Test empty parameter cause.
         Data::Mission::IFFOptions enabled_nothing;
 
@@ -190,6 +248,9 @@ int main() {
     }
 
     const std::string DRY         =  "--DRY";
+    const std::string GLB         =  "--GLB";
+    const std::string QUANTIZE    =  "--QUANTIZE";
+    const std::string WELD        =  "--WELD";
     const std::string ACT_ENABLE  =  "--ACT_ENABLE";
     const std::string ANM_ENABLE  =  "--ANM_ENABLE";
     const std::string ANM_PALETTE =  "--ANM_PALETTE";
@@ -223,6 +284,48 @@ int main() {
         testSingleCommand( expected, DRY, is_not_success, std::cout );
     }
 
+    { // Test expected.enable_glb
+        Data::Mission::IFFOptions expected;
+        expected.enable_glb = true;
+        testSingleCommand( expected, GLB, is_not_success, std::cout );
+    }
+
+    { // Test expected.enable_quantization
+        Data::Mission::IFFOptions expected;
+        expected.enable_quantization = true;
+        testSingleCommand( expected, QUANTIZE, is_not_success, std::cout );
+    }
+
+    { // Test expected.enable_weld
+        Data::Mission::IFFOptions expected;
+        expected.enable_weld = true;
+        testSingleCommand( expected, WELD, is_not_success, std::cout );
+    }
+
+    { // Test expected.png_compression_level
+        Data::Mission::IFFOptions expected;
+        expected.png_compression_level = 9;
+        testMultipleCommands( expected, { "--PNG_LEVEL", "9" }, is_not_success, std::cout );
+
+        expected.png_compression_level = 0;
+        expected.anm.export_palette = true;
+        expected.bmp.export_palette = true;
+        testMultipleCommands( expected, { BMP_PALETTE, "--PNG_LEVEL", "0", ANM_PALETTE }, is_not_success, std::cout );
+    }
+
+    { // The PNG level must be one number from 0 to 9.
+        const std::vector<std::vector<std::string>> invalid_levels = { { "--PNG_LEVEL" }, { "--PNG_LEVEL", "10" }, { "--PNG_LEVEL", "kelp" }, { "--PNG_LEVEL", "1", "2" } };
+
+        for( const auto &parameters : invalid_levels ) {
+            Data::Mission::IFFOptions enabled_nothing;
+
+            if( enabled_nothing.readParams( parameters, nullptr ) ) {
+                std::cout << "Error: --PNG_LEVEL with " << (parameters.size() - 1) << " bad arguments did not fail." << std::endl;
+                is_not_success = true;
+            }
+        }
+    }
+
     { // Test act.override_dry
         Data::Mission::IFFOptions expected;
         expected.enable_global_dry_default = true;
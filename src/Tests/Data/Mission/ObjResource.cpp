@@ -0,0 +1,166 @@
+#include "../../../Data/Mission/ObjResource.h"
+#include "../../../Utilities/ModelBuilder.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    const unsigned BONE_AMOUNT  = 2;
+    const unsigned FRAME_AMOUNT = 2;
+
+    void writeU8( std::vector<uint8_t> &bytes, uint8_t value ) {
+        bytes.push_back( value );
+    }
+
+    void writeU16( std::vector<uint8_t> &bytes, uint16_t value ) {
+        writeU8( bytes, value & 0xFF );
+        writeU8( bytes, value >> 8 );
+    }
+
+    void writeU32( std::vector<uint8_t> &bytes, uint32_t value ) {
+        writeU16( bytes, value & 0xFFFF );
+        writeU16( bytes, value >> 16 );
+    }
+
+    void writeBone( std::vector<uint8_t> &bytes, uint8_t parent_amount, int16_t position_y, int16_t rotation_x_index ) {
+        writeU8( bytes, parent_amount );
+        writeU8( bytes, 0 ); // normal_start
+        writeU8( bytes, 0 ); // normal_stride
+        writeU8( bytes, 0 ); // vertex_start
+        writeU8( bytes, 0 ); // vertex_stride
+        writeU8( bytes, 0 );
+        writeU8( bytes, 0 );
+        writeU8( bytes, 0b00111011 ); // Only the x rotation is animated.
+        writeU16( bytes, 0 );
+        writeU16( bytes, position_y );
+        writeU16( bytes, 0 );
+        writeU16( bytes, rotation_x_index );
+        writeU16( bytes, 0 );
+        writeU16( bytes, 0 );
+    }
+
+    /**
+     * This makes a little endian Obj resource of two bones with two frames, where the second bone is the child of the first.
+     */
+    std::vector<uint8_t> makeBonedObj() {
+        std::vector<uint8_t> bytes;
+
+        writeU32( bytes, 0x34444749 ); // 4DGI
+        writeU32( bytes, 0x3C );
+        writeU32( bytes, 1 );
+        writeU16( bytes, FRAME_AMOUNT );
+        writeU8( bytes, 0x01 );
+        writeU8( bytes, 0x02 ); // has_skeleton
+        for( int i = 0; i < 3; i++ )
+            writeU32( bytes, 0 );
+        writeU32( bytes, 1 );
+        writeU32( bytes, 2 );
+        writeU32( bytes, 1 );
+        writeU32( bytes, 1 );
+        writeU32( bytes, 3 );
+        writeU32( bytes, 0 ); // position_indexes
+        writeU32( bytes, 4 );
+        writeU32( bytes, 5 );
+
+        writeU32( bytes, 0x33444859 ); // 3DHY
+        writeU32( bytes, 8 + 4 + 0x14 * BONE_AMOUNT );
+        writeU32( bytes, 1 );
+        writeBone( bytes, 0,   0, 0 );
+        writeBone( bytes, 1, 512, FRAME_AMOUNT );
+
+        const int16_t rotations[ BONE_AMOUNT * FRAME_AMOUNT ] = { 256, 512, 1024, -128 };
+
+        writeU32( bytes, 0x33444D49 ); // 3DMI
+        writeU32( bytes, 8 + 4 + sizeof( rotations ) );
+        writeU32( bytes, 1 );
+        for( int16_t rotation : rotations )
+            writeU16( bytes, rotation );
+
+        return bytes;
+    }
+
+    std::vector<glm::mat4> getJointFrames( const Data::Mission::ObjResource &obj ) {
+        std::vector<glm::mat4> joint_frames;
+        std::unique_ptr<Utilities::ModelBuilder> model_p( obj.createModel() );
+
+        if( model_p == nullptr )
+            return joint_frames;
+
+        for( unsigned frame = 0; frame < model_p->getNumJointFrames(); frame++ ) {
+            for( unsigned joint = 0; joint < model_p->getNumJoints(); joint++ )
+                joint_frames.push_back( model_p->getJointFrame( frame, joint ) );
+        }
+
+        return joint_frames;
+    }
+
+    int testDuplicateBones() {
+        const std::string name = "ObjResource duplicate bones";
+        const std::vector<uint8_t> bytes = makeBonedObj();
+
+        auto original_p = std::make_unique<Data::Mission::ObjResource>();
+        auto loading = Utilities::Buffer::Reader( bytes.data(), bytes.size() );
+
+        if( original_p->read( loading ) < 1 || !original_p->parse() ) {
+            std::cout << name << ": the boned obj did not parse" << std::endl;
+            return FAILURE;
+        }
+
+        if( original_p->getNumBones() != BONE_AMOUNT || original_p->getNumBoneFrames() != FRAME_AMOUNT ) {
+            std::cout << name << ": expected " << BONE_AMOUNT << " bones and " << FRAME_AMOUNT << " frames not "
+                << original_p->getNumBones() << " bones and " << original_p->getNumBoneFrames() << " frames" << std::endl;
+            return FAILURE;
+        }
+
+        const std::vector<glm::mat4> expected_joint_frames = getJointFrames( *original_p );
+
+        if( expected_joint_frames.size() != BONE_AMOUNT * FRAME_AMOUNT ) {
+            std::cout << name << ": the original has " << expected_joint_frames.size() << " joint frames" << std::endl;
+            return FAILURE;
+        }
+
+        std::vector<glm::vec3> expected_positions;
+
+        for( unsigned frame = 0; frame < FRAME_AMOUNT; frame++ ) {
+            for( unsigned bone = 0; bone < BONE_AMOUNT; bone++ )
+                expected_positions.push_back( original_p->getBone( bone, frame ).position );
+        }
+
+        // The copy must not depend on anything owned by the original.
+        std::unique_ptr<Data::Mission::Resource> copy_p( original_p->duplicate() );
+        original_p.reset();
+
+        auto copy_r = dynamic_cast<Data::Mission::ObjResource*>( copy_p.get() );
+        int is_not_success = SUCCESS;
+
+        for( unsigned frame = 0; frame < FRAME_AMOUNT; frame++ ) {
+            for( unsigned bone = 0; bone < BONE_AMOUNT; bone++ ) {
+                if( copy_r->getBone( bone, frame ).position != expected_positions[ frame * BONE_AMOUNT + bone ] ) {
+                    std::cout << name << ": bone " << bone << " of frame " << frame << " has the wrong position" << std::endl;
+                    is_not_success = FAILURE;
+                }
+            }
+        }
+
+        // createModel reads the parents and the animation data of the copy.
+        const std::vector<glm::mat4> joint_frames = getJointFrames( *copy_r );
+
+        if( joint_frames != expected_joint_frames ) {
+            std::cout << name << ": the joint frames of the copy do not match the original" << std::endl;
+            is_not_success = FAILURE;
+        }
+
+        return is_not_success;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    is_not_success |= testDuplicateBones();
+
+    return is_not_success;
+}
@@ -0,0 +1,153 @@
+#include "../../../Data/Mission/Resource.h"
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    class CountingResource : public Data::Mission::Resource {
+    public:
+        std::atomic<unsigned> parse_count;
+        bool parse_result;
+
+        CountingResource( bool result ) : parse_count( 0 ), parse_result( result ) {}
+        CountingResource( const CountingResource &obj ) : Resource( obj ), parse_count( 0 ), parse_result( obj.parse_result ) {}
+
+        std::filesystem::path getFileExtension() const { return "count"; }
+        uint32_t getResourceTagID() const { return 0x436e7474; }
+
+        bool parse( const ParseSettings & ) {
+            parse_count++;
+
+            // Give the other threads a chance to race this parse.
+            std::this_thread::yield();
+
+            return parse_result;
+        }
+
+        Resource* duplicate() const { return new CountingResource( *this ); }
+    };
+
+    int testEnsureParsed( bool parse_result, unsigned thread_amount ) {
+        CountingResource resource( parse_result );
+
+        if( !resource.isParsed() || !resource.ensureParsed() || resource.parse_count != 0 ) {
+            std::cout << "Error: a resource without a deferred parse got parsed by ensureParsed." << std::endl;
+            return FAILURE;
+        }
+
+        resource.deferParse( Data::Mission::Resource::DEFAULT_PARSE_SETTINGS );
+
+        if( resource.isParsed() ) {
+            std::cout << "Error: isParsed is true right after deferParse." << std::endl;
+            return FAILURE;
+        }
+
+        std::vector<std::thread> threads;
+        std::atomic<unsigned> wrong_results( 0 );
+
+        for( unsigned i = 0; i < thread_amount; i++ ) {
+            threads.push_back( std::thread( [&]() {
+                const Data::Mission::Resource &constant_resource = resource;
+
+                if( constant_resource.ensureParsed() != parse_result )
+                    wrong_results++;
+            } ) );
+        }
+
+        for( auto &thread : threads )
+            thread.join();
+
+        if( resource.parse_count != 1 ) {
+            std::cout << "Error: " << thread_amount << " threads parsed the resource " << resource.parse_count << " times instead of once." << std::endl;
+            return FAILURE;
+        }
+
+        if( wrong_results != 0 ) {
+            std::cout << "Error: ensureParsed did not return " << parse_result << " for " << wrong_results << " threads." << std::endl;
+            return FAILURE;
+        }
+
+        if( !resource.isParsed() ) {
+            std::cout << "Error: isParsed is false after ensureParsed." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+
+    Utilities::Buffer* makeData( size_t size, size_t changed_index ) {
+        Utilities::Buffer *data_p = new Utilities::Buffer();
+
+        for( size_t i = 0; i < size; i++ )
+            data_p->addU8( i == changed_index ? 0xFF : static_cast<uint8_t>( i * 13 ) );
+
+        return data_p;
+    }
+
+    int testContentHash() {
+        // 77 bytes are not a multiple of the 32 byte blocks nor the 8 byte words of the hash.
+        const size_t SIZE = 77;
+
+        CountingResource original( true ), same( true ), different( true );
+
+        original.setMemory( makeData( SIZE, SIZE ) );
+        same.setMemory( makeData( SIZE, SIZE ) );
+        different.setMemory( makeData( SIZE, SIZE - 1 ) );
+
+        if( original.getContentHash() != same.getContentHash() || original.getContentHash() == 0 ) {
+            std::cout << "Error: resources with the same data have different hashes." << std::endl;
+            return FAILURE;
+        }
+
+        if( original.getContentHash() == different.getContentHash() ) {
+            std::cout << "Error: resources that differ by the last byte have the same hash." << std::endl;
+            return FAILURE;
+        }
+
+        if( !(original == same) || original != same || original < same || same < original ) {
+            std::cout << "Error: resources with the same data are not equal." << std::endl;
+            return FAILURE;
+        }
+
+        if( original == different || (original < different) == (different < original) ) {
+            std::cout << "Error: resources with different data are not ordered." << std::endl;
+            return FAILURE;
+        }
+
+        // The copy must keep the hash, and setMemory must forget it.
+        CountingResource copy( original );
+
+        if( copy.getContentHash() != original.getContentHash() ) {
+            std::cout << "Error: the copy of a resource has a different hash." << std::endl;
+            return FAILURE;
+        }
+
+        copy.setMemory( makeData( SIZE, SIZE - 1 ) );
+
+        if( copy.getContentHash() != different.getContentHash() ) {
+            std::cout << "Error: setMemory did not reset the hash." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    if( testEnsureParsed( true, 1 ) != SUCCESS )
+        is_not_success = FAILURE;
+    if( testEnsureParsed( true, 8 ) != SUCCESS )
+        is_not_success = FAILURE;
+    if( testEnsureParsed( false, 8 ) != SUCCESS )
+        is_not_success = FAILURE;
+    if( testContentHash() != SUCCESS )
+        is_not_success = FAILURE;
+
+    return is_not_success;
+}
@@ -0,0 +1,284 @@
+#include "../../Utilities/Buffer.h"
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Utilities::Buffer;
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    bool compareBytes( const Buffer &buffer, const std::vector<uint8_t> &expected, std::string name ) {
+        auto reader = buffer.getReader();
+
+        if( reader.totalSize() != expected.size() ) {
+            std::cout << "Error: " << name << " does not have the correct length. Expected: " << expected.size() << " Result: " << reader.totalSize() << std::endl;
+            return false;
+        }
+
+        for( size_t i = 0; i < expected.size(); i++ ) {
+            const auto value = reader.readU8();
+
+            if( value != expected[i] ) {
+                std::cout << "Error: " << name << " at index " << i << ". Expected: 0x" << std::hex << static_cast<unsigned>( expected[i] ) << " Result: 0x" << static_cast<unsigned>( value ) << std::dec << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    int testView() {
+        auto owner_p = std::make_shared<std::vector<uint8_t>>( std::vector<uint8_t>{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 } );
+        const std::vector<uint8_t> original = *owner_p;
+
+        Buffer buffer;
+        buffer.setView( owner_p, owner_p->data() + 1, 4 );
+
+        if( !buffer.isView() ) {
+            std::cout << "Error: setView did not make a view." << std::endl;
+            return FAILURE;
+        }
+
+        if( buffer.dangerousPointer() == nullptr || static_cast<const Buffer&>( buffer ).getReader().totalSize() != 4 ) {
+            std::cout << "Error: view does not have the correct size." << std::endl;
+            return FAILURE;
+        }
+
+        // The non-const dangerousPointer call above must have detached the buffer.
+        if( buffer.isView() ) {
+            std::cout << "Error: dangerousPointer did not copy the view." << std::endl;
+            return FAILURE;
+        }
+
+        buffer.setView( owner_p, owner_p->data() + 1, 4 );
+
+        if( !compareBytes( buffer, { 0x02, 0x03, 0x04, 0x05 }, "view" ) )
+            return FAILURE;
+
+        // Copies share the view.
+        Buffer copy( buffer );
+
+        if( !copy.isView() || !compareBytes( copy, { 0x02, 0x03, 0x04, 0x05 }, "view copy" ) ) {
+            std::cout << "Error: the copy of the view is wrong." << std::endl;
+            return FAILURE;
+        }
+
+        // Modification copies the bytes first and leaves the viewed memory alone.
+        buffer.addU8( 0x07 );
+
+        if( buffer.isView() || !compareBytes( buffer, { 0x02, 0x03, 0x04, 0x05, 0x07 }, "detached view" ) )
+            return FAILURE;
+
+        auto writer = copy.getWriter();
+        writer.writeU8( 0xFF );
+
+        if( !compareBytes( copy, { 0xFF, 0x03, 0x04, 0x05 }, "written view copy" ) )
+            return FAILURE;
+
+        if( *owner_p != original ) {
+            std::cout << "Error: the viewed memory got modified." << std::endl;
+            return FAILURE;
+        }
+
+        // The view must keep its owner alive.
+        Buffer last_view;
+        last_view.setView( owner_p, owner_p->data(), owner_p->size() );
+        owner_p = nullptr;
+
+        if( !compareBytes( last_view, original, "owned view" ) )
+            return FAILURE;
+
+        // A set call replaces the view.
+        const uint8_t replacement[] = { 0x0A, 0x0B };
+        last_view.set( replacement, sizeof( replacement ) );
+
+        if( last_view.isView() || !compareBytes( last_view, { 0x0A, 0x0B }, "set view" ) )
+            return FAILURE;
+
+        return SUCCESS;
+    }
+
+    int testArrays() {
+        Buffer buffer;
+
+        const uint8_t bytes[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D };
+        buffer.add( bytes, sizeof( bytes ) );
+
+        if( !compareBytes( buffer, std::vector<uint8_t>( bytes, bytes + sizeof( bytes ) ), "add" ) )
+            return FAILURE;
+
+        auto reader = buffer.getReader();
+
+        uint8_t first[ 1 ];
+        reader.readU8Array( first, 1 );
+
+        uint16_t little[ 2 ];
+        reader.readU16Array( little, 2, Buffer::Endian::LITTLE );
+
+        if( first[0] != 0x01 || little[0] != 0x0302 || little[1] != 0x0504 ) {
+            std::cout << "Error: readU16Array little endian got 0x" << std::hex << little[0] << " 0x" << little[1] << std::dec << std::endl;
+            return FAILURE;
+        }
+
+        uint32_t big[ 2 ];
+        reader.readU32Array( big, 2, Buffer::Endian::BIG );
+
+        if( big[0] != 0x06070809 || big[1] != 0x0A0B0C0D ) {
+            std::cout << "Error: readU32Array big endian got 0x" << std::hex << big[0] << " 0x" << big[1] << std::dec << std::endl;
+            return FAILURE;
+        }
+
+        if( !reader.ended() ) {
+            std::cout << "Error: the array reads did not reach the end of the reader." << std::endl;
+            return FAILURE;
+        }
+
+        reader.setPosition( 4 );
+
+        const uint8_t *const span_r = reader.readSpan( 3 );
+
+        if( span_r != buffer.dangerousPointer() + 4 || reader.getPosition() != 7 ) {
+            std::cout << "Error: readSpan did not return the bytes in place." << std::endl;
+            return FAILURE;
+        }
+
+        // Reading past the end must throw without moving the reader.
+        bool caught = false;
+
+        try {
+            uint32_t too_much[ 2 ];
+            reader.readU32Array( too_much, 2, Buffer::Endian::NO_SWAP );
+        }
+        catch( const Buffer::BufferOutOfBounds & ) {
+            caught = true;
+        }
+
+        if( !caught || reader.getPosition() != 7 ) {
+            std::cout << "Error: readU32Array past the end did not throw or moved the reader." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+
+    int testLongArrays( Buffer::Endian endian ) {
+        Buffer buffer;
+
+        // The lengths are chosen so the vector loops and the value by value tails both get used.
+        for( unsigned i = 0; i < 200 * 4; i++ )
+            buffer.addU16( i * 0x0301 + 7, endian );
+
+        for( size_t amount = 0; amount < 70; amount++ ) {
+            auto reader = buffer.getReader();
+            auto expected_reader = buffer.getReader();
+
+            std::vector<uint16_t> values_16( amount );
+            reader.readU16Array( values_16.data(), amount, endian );
+
+            for( size_t i = 0; i < amount; i++ ) {
+                const uint16_t expected = expected_reader.readU16( endian );
+
+                if( values_16[ i ] != expected ) {
+                    std::cout << "Error: readU16Array of " << amount << " values got 0x" << std::hex << values_16[ i ] << " instead of 0x" << expected << std::dec << " at " << i << std::endl;
+                    return FAILURE;
+                }
+            }
+
+            std::vector<uint32_t> values_32( amount );
+            reader.readU32Array( values_32.data(), amount, endian );
+
+            for( size_t i = 0; i < amount; i++ ) {
+                const uint32_t expected = expected_reader.readU32( endian );
+
+                if( values_32[ i ] != expected ) {
+                    std::cout << "Error: readU32Array of " << amount << " values got 0x" << std::hex << values_32[ i ] << " instead of 0x" << expected << std::dec << " at " << i << std::endl;
+                    return FAILURE;
+                }
+            }
+        }
+
+        // Read vertices that have a padding value. 200 records do not fit in one block.
+        auto reader = buffer.getReader();
+        auto expected_reader = buffer.getReader();
+
+        std::vector<uint16_t> vertices( 200 * 3 );
+        reader.readU16Records( vertices.data(), 200, 3, 4, endian );
+
+        for( size_t i = 0; i < 200; i++ ) {
+            for( size_t c = 0; c < 3; c++ ) {
+                const uint16_t expected = expected_reader.readU16( endian );
+
+                if( vertices[ 3 * i + c ] != expected ) {
+                    std::cout << "Error: readU16Records got 0x" << std::hex << vertices[ 3 * i + c ] << " instead of 0x" << expected << std::dec << " at record " << i << std::endl;
+                    return FAILURE;
+                }
+            }
+            expected_reader.readU16( endian );
+        }
+
+        if( !reader.ended() ) {
+            std::cout << "Error: readU16Records did not skip the padding values." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+
+    int testFile() {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "fc_buffer_test.bin";
+
+        Buffer buffer;
+
+        for( unsigned i = 0; i < 0x1234; i++ )
+            buffer.addU8( i * 7 );
+
+        if( !buffer.write( path ) ) {
+            std::cout << "Error: the buffer could not be written to " << path << "." << std::endl;
+            return FAILURE;
+        }
+
+        Buffer result;
+        result.addU8( 0xAB );
+
+        const bool is_read = result.read( path );
+
+        std::filesystem::remove( path );
+
+        if( !is_read ) {
+            std::cout << "Error: the buffer could not be read from " << path << "." << std::endl;
+            return FAILURE;
+        }
+
+        // Reading appends to the buffer.
+        std::vector<uint8_t> expected = { 0xAB };
+
+        for( unsigned i = 0; i < 0x1234; i++ )
+            expected.push_back( i * 7 );
+
+        if( !compareBytes( result, expected, "read" ) )
+            return FAILURE;
+
+        return SUCCESS;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    if( testView() != SUCCESS )
+        is_not_success = FAILURE;
+    if( testArrays() != SUCCESS )
+        is_not_success = FAILURE;
+    if( testLongArrays( Buffer::Endian::LITTLE ) != SUCCESS )
+        is_not_success = FAILURE;
+    if( testLongArrays( Buffer::Endian::BIG ) != SUCCESS )
+        is_not_success = FAILURE;
+    if( testFile() != SUCCESS )
+        is_not_success = FAILURE;
+
+    return is_not_success;
+}
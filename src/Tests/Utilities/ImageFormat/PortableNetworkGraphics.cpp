@@ -1,12 +1,20 @@
 #include "../../../Utilities/Image2D.h"
+#include "../../../Utilities/ImagePalette2D.h"
+#include "../../../Utilities/ImageFormat/Chooser.h"
 #include "../../../Utilities/ImageFormat/PortableNetworkGraphics.h"
 
 #include "Config.h"
 
 #include <glm/vec2.hpp>
+#include <cstring>
 #include <iostream>
 
+#ifdef BUILD_WITH_LIBPNG
+#include <libpng16/png.h>
+#endif
+
 #include "../TestImage2D.h"
+#include "../TestPalette.h"
 
 const Utilities::Image2D generateFractalImage( const unsigned WIDTH, const unsigned HEIGHT, const Utilities::PixelFormatColor &color_r ) {
     Utilities::Image2D source( WIDTH, HEIGHT, color_r );
@@ -44,6 +52,120 @@ int checkPNG( const std::string name, const Utilities::Image2D &original ) {
     return error_state;
 }
 
+#ifdef BUILD_WITH_LIBPNG
+int checkDecode( const std::string name, const Utilities::ImageBase2D<Utilities::Grid2DPlacementNormal> &written, const Utilities::Image2D &original, int compression_level, unsigned thread_amount, uint32_t png_format ) {
+    Utilities::Buffer buffer;
+    Utilities::ImageFormat::PortableNetworkGraphics png_format_writer( compression_level, thread_amount );
+    
+    if( png_format_writer.write( written, buffer ) != 1 ) {
+        std::cout << name << ": has failed to write image to buffer" << std::endl;
+        return 1;
+    }
+    
+    if( png_format_writer.getSpace( written ) != buffer.getReader().totalSize() ) {
+        std::cout << name << ": getSpace does not match the written size" << std::endl;
+        return 1;
+    }
+    
+    // libpng is used to read the image back, since PortableNetworkGraphics cannot read.
+    png_image image_read;
+    std::memset( &image_read, 0, sizeof( image_read ) );
+    image_read.version = PNG_IMAGE_VERSION;
+    
+    if( !png_image_begin_read_from_memory( &image_read, buffer.dangerousPointer(), buffer.getReader().totalSize() ) ) {
+        std::cout << name << ": libpng could not read the header. " << image_read.message << std::endl;
+        return 1;
+    }
+    
+    image_read.format = png_format;
+    
+    std::vector<uint8_t> pixels( PNG_IMAGE_SIZE( image_read ) );
+    
+    if( !png_image_finish_read( &image_read, nullptr, pixels.data(), 0, nullptr ) ) {
+        std::cout << name << ": libpng could not read the image. " << image_read.message << std::endl;
+        return 1;
+    }
+    
+    if( image_read.width != original.getWidth() || image_read.height != original.getHeight() ) {
+        std::cout << name << ": the dimensions " << image_read.width << "x" << image_read.height << " are wrong" << std::endl;
+        return 1;
+    }
+    
+    if( std::memcmp( pixels.data(), original.getDirectGridData(), pixels.size() ) != 0 ) {
+        std::cout << name << ": the decoded pixels do not match" << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
+
+int testDecode( const Utilities::PixelFormatColor &color_r, uint32_t png_format ) {
+    int error_state = 0;
+    
+    // The big image is split into multiple deflate groups.
+    auto small = generateFractalImage( 24, 64, color_r );
+    auto big   = generateFractalImage( 300, 600, color_r );
+    
+    for( int compression_level : { 0, Utilities::ImageFormat::PortableNetworkGraphics::DEFAULT_COMPRESSION_LEVEL, 9 } ) {
+        for( unsigned thread_amount : { 1, 4 } ) {
+            const std::string level_name = " (compression level " + std::to_string( compression_level ) + ", " + std::to_string( thread_amount ) + " threads)";
+            
+            error_state |= checkDecode( color_r.getName() + " small" + level_name, small, small, compression_level, thread_amount, png_format );
+            error_state |= checkDecode( color_r.getName() + " big"   + level_name, big,   big,   compression_level, thread_amount, png_format );
+        }
+    }
+    
+    return error_state;
+}
+
+int testPaletteDecode() {
+    auto colors = generateColorPalette();
+    Utilities::ColorPalette color_palette( Utilities::PixelFormatColor_R8G8B8A8::linear );
+    
+    color_palette.setAmount( colors.size() );
+    
+    for( size_t i = 0; i < colors.size(); i++ )
+        color_palette.setIndex( i, colors[ i ] );
+    
+    Utilities::ImagePalette2D palette_image( 40, 30, color_palette );
+    
+    for( Utilities::grid_2d_unit y = 0; y < palette_image.getHeight(); y++ ) {
+        for( Utilities::grid_2d_unit x = 0; x < palette_image.getWidth(); x++ )
+            palette_image.writePixel( x, y, (7 * x + 3 * y) & 0xFF );
+    }
+    
+    // The palette image is written as its color image.
+    return checkDecode( "ImagePalette2D", palette_image, palette_image.toColorImage(), Utilities::ImageFormat::PortableNetworkGraphics::DEFAULT_COMPRESSION_LEVEL, 1, PNG_FORMAT_RGBA );
+}
+#endif
+
+int testChooser() {
+    int error_state = 0;
+    
+    Utilities::ImageFormat::Chooser default_chooser;
+    Utilities::ImageFormat::Chooser chooser( 9, 4 );
+    
+    auto default_png_r = dynamic_cast<Utilities::ImageFormat::PortableNetworkGraphics*>( default_chooser.getWriterReference( Utilities::PixelFormatColor_R8G8B8A8::linear ) );
+    auto png_r         = dynamic_cast<Utilities::ImageFormat::PortableNetworkGraphics*>( chooser.getWriterReference( Utilities::PixelFormatColor_R8G8B8A8::linear ) );
+    
+    if( default_png_r == nullptr || png_r == nullptr ) {
+        std::cout << "Chooser: PortableNetworkGraphics is not the writer of R8G8B8A8" << std::endl;
+        return 1;
+    }
+    
+    if( default_png_r->getCompressionLevel() != Utilities::ImageFormat::PortableNetworkGraphics::DEFAULT_COMPRESSION_LEVEL || default_png_r->getThreadAmount() != 1 ) {
+        std::cout << "Chooser: the default PortableNetworkGraphics should have the default level and one thread" << std::endl;
+        error_state = 1;
+    }
+    
+    if( png_r->getCompressionLevel() != 9 || png_r->getThreadAmount() != 4 ) {
+        std::cout << "Chooser: the PortableNetworkGraphics settings were not passed on" << std::endl;
+        error_state = 1;
+    }
+    
+    return error_state;
+}
+
 int testColorSpace( const Utilities::PixelFormatColor &color_r ) {
     int error_state = 0;
     auto equal = generateFractalImage( 64, 64, color_r );
@@ -64,6 +186,14 @@ int main() {
     error_state |= testColorSpace( Utilities::PixelFormatColor_W8A8::linear );
     error_state |= testColorSpace( Utilities::PixelFormatColor_R8G8B8A8::linear );
     
+    error_state |= testDecode( Utilities::PixelFormatColor_W8::linear,       PNG_FORMAT_GRAY );
+    error_state |= testDecode( Utilities::PixelFormatColor_W8A8::linear,     PNG_FORMAT_GA );
+    error_state |= testDecode( Utilities::PixelFormatColor_R8G8B8::linear,   PNG_FORMAT_RGB );
+    error_state |= testDecode( Utilities::PixelFormatColor_R8G8B8A8::linear, PNG_FORMAT_RGBA );
+    error_state |= testPaletteDecode();
+    
+    error_state |= testChooser();
+    
     return error_state;
 #else
     std::cout << "Error LIBPNG is required for this test." << std::endl;
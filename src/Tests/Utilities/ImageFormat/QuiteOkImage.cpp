@@ -1,7 +1,9 @@
 #include "../../../Utilities/Image2D.h"
 #include "../../../Utilities/ImageFormat/QuiteOkImage.h"
+#include "../../../Utilities/Random.h"
 
 #include <glm/vec2.hpp>
+#include <cstring>
 #include <iostream>
 
 #include "../TestImage2D.h"
@@ -95,6 +97,145 @@ int testColorSpace( const Utilities::PixelFormatColor &color_r, const Utilities:
     return error_state;
 }
 
+int testRGBA( const Utilities::PixelFormatColor &color_r ) {
+    int error_state = 0;
+    const std::string name = color_r.getName() + " raw pixels";
+    
+    const auto original = generateFractalImage( 48, 40, color_r );
+    const Utilities::Image2D rgba_image( original, Utilities::PixelFormatColor_R8G8B8A8::linear );
+    const bool has_alpha = (color_r.byteSize() == 4);
+    
+    Utilities::Buffer image_buffer;
+    Utilities::Buffer rgba_buffer;
+    Utilities::ImageFormat::QuiteOkImage qoi_format;
+    
+    qoi_format.write( original, image_buffer );
+    
+    if( qoi_format.writeRGBA( rgba_image.getDirectGridData(), rgba_image.getWidth(), rgba_image.getHeight(), has_alpha, rgba_buffer ) != 1 ) {
+        std::cout << name << ": has failed to write the pixels to buffer" << std::endl;
+        error_state = 1;
+    }
+    
+    // Both ways of writing have to make the same file.
+    const auto image_size = image_buffer.getReader().totalSize();
+    
+    if( image_size != rgba_buffer.getReader().totalSize() ||
+        std::memcmp( image_buffer.dangerousPointer(), rgba_buffer.dangerousPointer(), image_size ) != 0 ) {
+        std::cout << name << ": writeRGBA does not make the same file as write" << std::endl;
+        error_state = 1;
+    }
+    
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    
+    if( qoi_format.readRGBA( rgba_buffer, pixels, width, height ) != 1 ) {
+        std::cout << name << ": has failed to read the pixels from buffer" << std::endl;
+        error_state = 1;
+    }
+    else
+    if( width != rgba_image.getWidth() || height != rgba_image.getHeight() ) {
+        std::cout << name << ": the dimensions (" << width << ", " << height << ") are wrong" << std::endl;
+        error_state = 1;
+    }
+    else {
+        for( size_t i = 0; i < pixels.size(); i++ ) {
+            // Without alpha the decoded alpha is always opaque.
+            const uint8_t expected = (!has_alpha && i % 4 == 3) ? 0xFF : rgba_image.getDirectGridData()[ i ];
+            
+            if( pixels[ i ] != expected ) {
+                std::cout << name << ": byte " << i << " is " << static_cast<unsigned>( pixels[ i ] ) << " instead of " << static_cast<unsigned>( expected ) << std::endl;
+                error_state = 1;
+                break;
+            }
+        }
+    }
+    
+    return error_state;
+}
+
+int testRGBAOpcodes() {
+    int error_state = 0;
+    const std::string name = "Raw pixels with every opcode";
+    const uint32_t WIDTH  = 61;
+    const uint32_t HEIGHT = 37;
+    const uint8_t PALETTE[4][4] = { {0x10, 0x80, 0xF0, 0xFF}, {0xFF, 0xFF, 0x00, 0x80}, {0x00, 0x00, 0x00, 0x00}, {0x7F, 0x20, 0x45, 0xFF} };
+    
+    Utilities::Random::Generator generator( 0x51F15EED );
+    std::vector<uint8_t> original( WIDTH * HEIGHT * 4 );
+    uint8_t previous[4] = { 0, 0, 0, 0xFF };
+    
+    // Every kind of step between two pixels is made, so the encoder has to use every opcode.
+    for( size_t p = 0; p < WIDTH * HEIGHT; p++ ) {
+        uint8_t *const pixel_r = original.data() + 4 * p;
+        
+        std::memcpy( pixel_r, previous, 4 );
+        
+        switch( generator.nextUnsignedInt() % 6 ) {
+            case 0: // Run
+                break;
+            case 1: // Diff
+                pixel_r[0] += 1;
+                pixel_r[2] -= 1;
+                break;
+            case 2: // Luma
+                pixel_r[0] += 14;
+                pixel_r[1] += 10;
+                pixel_r[2] += 6;
+                break;
+            case 3: // RGB
+                pixel_r[0] = generator.nextUnsignedInt();
+                pixel_r[1] = generator.nextUnsignedInt();
+                pixel_r[2] = generator.nextUnsignedInt();
+                break;
+            case 4: // RGBA
+                for( unsigned c = 0; c < 4; c++ )
+                    pixel_r[c] = generator.nextUnsignedInt();
+                break;
+            default: // Index
+                std::memcpy( pixel_r, PALETTE[ generator.nextUnsignedInt() % 4 ], 4 );
+        }
+        
+        std::memcpy( previous, pixel_r, 4 );
+    }
+    
+    Utilities::Buffer buffer;
+    Utilities::ImageFormat::QuiteOkImage qoi_format;
+    
+    if( qoi_format.writeRGBA( original.data(), WIDTH, HEIGHT, true, buffer ) != 1 ) {
+        std::cout << name << ": has failed to write the pixels to buffer" << std::endl;
+        return 1;
+    }
+    
+    Utilities::ImageFormat::QuiteOkImage::QOIStatus every_status;
+    every_status.used_RGBA  = true;
+    every_status.used_RGB   = true;
+    every_status.used_index = true;
+    every_status.used_diff  = true;
+    every_status.used_luma  = true;
+    every_status.used_run   = true;
+    
+    error_state |= checkCorrectStates( name + " write mode", qoi_format.getStatus(), every_status );
+    
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    
+    if( qoi_format.readRGBA( buffer, pixels, width, height ) != 1 ) {
+        std::cout << name << ": has failed to read the pixels from buffer" << std::endl;
+        return 1;
+    }
+    
+    error_state |= checkCorrectStates( name + " read mode", qoi_format.getStatus(), every_status );
+    
+    if( width != WIDTH || height != HEIGHT || pixels != original ) {
+        std::cout << name << ": readRGBA does not give back the pixels given to writeRGBA" << std::endl;
+        error_state = 1;
+    }
+    
+    return error_state;
+}
+
 int main() {
     int error_state = 0;
     Utilities::ImageFormat::QuiteOkImage::QOIStatus equal_status;
@@ -134,5 +275,10 @@ int main() {
     error_state |= testColorSpace( Utilities::PixelFormatColor_R5G5B5A1::linear, equal_status, unequal_status );
     error_state |= testColorSpace( Utilities::PixelFormatColor_B5G5R5A1::linear, equal_status, unequal_status );
     
+    // The raw pixel methods must match the image methods.
+    error_state |= testRGBA( Utilities::PixelFormatColor_R8G8B8::linear );
+    error_state |= testRGBA( Utilities::PixelFormatColor_R8G8B8A8::linear );
+    error_state |= testRGBAOpcodes();
+    
     return error_state;
 }
@@ -152,6 +152,22 @@ int testPalette2D( const Utilities::ColorPalette &color_palette, std::string nam
         
         problem |= compareImage2D<T, Utilities::Image2D>( image, image_copy, unpaletted_image );
     }
+    { // Test ImageMorbin2D generation.
+        auto image_copy = image.toColorMorbinImage();
+        const std::string unpaletted_image = "Unpaletted Morbin Image " + name + " ";
+
+        problem |= testScale<Utilities::ImageMorbin2D>( image_copy, image.getWidth(), image.getHeight(), unpaletted_image );
+
+        problem |= compareImage2D<T, Utilities::ImageMorbin2D>( image, image_copy, unpaletted_image );
+    }
+    { // Test the expansion into an image that has another pixel format.
+        Utilities::Image2D image_copy( image.getWidth(), image.getHeight(), Utilities::PixelFormatColor_R8G8B8A8::linear );
+        const std::string inscribed_image = "Inscribed Color Image " + name + " ";
+
+        image.inscribeColorImage( image_copy );
+
+        problem |= compareImage2D<T, Utilities::Image2D>( image, image_copy, inscribed_image );
+    }
     {
         T image_copy( test_julia_set.getWidth() * 2, test_julia_set.getHeight() * 2, color_palette );
         
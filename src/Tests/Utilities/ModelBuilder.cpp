@@ -1,10 +1,350 @@
 #include "../../Utilities/ModelBuilder.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
 #include <iostream>
 
 const uint8_t ORIGINAL_MODEL_BUFFER[] = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x20,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x20,0x00,0x00};
 
 const size_t ORIGINAL_MODEL_BUFFER_SIZE = sizeof( ORIGINAL_MODEL_BUFFER ) / sizeof( ORIGINAL_MODEL_BUFFER[0] );
 
+namespace {
+
+int testAttributes( const Utilities::ModelBuilder &model ) {
+    const unsigned VERTEX_AMOUNT = model.getNumVertices();
+
+    // The bulk readback must give the same values as getTransformation for every component.
+    for( unsigned c = 0; c < model.getNumVertexComponents(); c++ ) {
+        std::vector<glm::vec4> attributes;
+
+        if( !model.getAttributes( attributes, c, 0, VERTEX_AMOUNT, glm::vec4( 0, 0, 0, 1 ) ) ) {
+            std::cout << "The bulk readback of vertex component " << c << " has failed." << std::endl;
+            return 1;
+        }
+
+        for( unsigned v = 0; v < VERTEX_AMOUNT; v++ ) {
+            glm::vec4 expected( 0, 0, 0, 1 );
+
+            model.getTransformation( expected, c, v );
+
+            if( attributes[ v ] != expected ) {
+                std::cout << "The bulk readback of vertex component " << c << " does not match at vertex " << v << "." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::vector<glm::vec3> morph_attributes;
+
+    if( !model.getMorphAttributes( morph_attributes, 0, 0, 1, VERTEX_AMOUNT - 1 ) || morph_attributes.size() != VERTEX_AMOUNT - 1 ) {
+        std::cout << "The bulk readback of the morph frame has failed." << std::endl;
+        return 1;
+    }
+
+    for( unsigned v = 1; v < VERTEX_AMOUNT; v++ ) {
+        glm::vec4 expected( 0 );
+
+        model.getTransformation( expected, 0, v, 0 );
+
+        if( morph_attributes[ v - 1 ] != glm::vec3( expected ) ) {
+            std::cout << "The bulk readback of the morph frame does not match at vertex " << v << "." << std::endl;
+            return 1;
+        }
+    }
+
+    // Out of range requests must fail.
+    if( model.getAttributes( morph_attributes, 0, 1, VERTEX_AMOUNT ) ) {
+        std::cout << "The bulk readback past the last vertex did not fail." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int testCombine() {
+    const unsigned MODEL_AMOUNT = 3;
+    const unsigned CORNER_AMOUNT = 6;
+
+    std::vector<Utilities::ModelBuilder> models( MODEL_AMOUNT );
+    std::vector<Utilities::ModelBuilder*> model_rs;
+
+    for( unsigned m = 0; m < MODEL_AMOUNT; m++ ) {
+        auto position_component_index = models[ m ].addVertexComponent( Utilities::ModelBuilder::POSITION_COMPONENT_NAME, Utilities::DataTypes::FLOAT, Utilities::DataTypes::VEC3, false );
+
+        models[ m ].setupVertexComponents();
+
+        // The last two models share a texture, so they must end up in one material.
+        models[ m ].setMaterial( m == 0 ? "first" : "second", m == 0 ? 1 : 2 );
+
+        for( unsigned i = 0; i < CORNER_AMOUNT; i++ ) {
+            models[ m ].startVertex();
+            models[ m ].setVertexData( position_component_index, Utilities::DataTypes::Vec3Type( glm::vec3( m, i, 0 ) ) );
+        }
+
+        models[ m ].finish();
+        model_rs.push_back( &models[ m ] );
+    }
+
+    int status;
+    Utilities::ModelBuilder *combined_model_p = Utilities::ModelBuilder::combine( model_rs, status );
+
+    if( combined_model_p == nullptr || status != 1 ) {
+        delete combined_model_p;
+        std::cout << "The combine has failed with status " << status << "." << std::endl;
+        return 1;
+    }
+
+    int is_not_success = 0;
+
+    if( combined_model_p->getNumVertices() != MODEL_AMOUNT * CORNER_AMOUNT || combined_model_p->getNumMaterials() != 2 ) {
+        std::cout << "The combined model has " << combined_model_p->getNumVertices() << " vertices and " << combined_model_p->getNumMaterials() << " materials instead of " << (MODEL_AMOUNT * CORNER_AMOUNT) << " and 2." << std::endl;
+        is_not_success = 1;
+    }
+    else {
+        std::vector<glm::vec3> positions;
+
+        combined_model_p->getAttributes( positions, 0, 0, MODEL_AMOUNT * CORNER_AMOUNT );
+
+        // The vertices of every model must be copied in order.
+        for( unsigned v = 0; v < positions.size(); v++ ) {
+            if( positions[ v ] != glm::vec3( v / CORNER_AMOUNT, v % CORNER_AMOUNT, 0 ) ) {
+                std::cout << "The combined model has the wrong position at vertex " << v << "." << std::endl;
+                is_not_success = 1;
+                break;
+            }
+        }
+
+        Utilities::ModelBuilder::TextureMaterial material;
+
+        combined_model_p->getMaterial( 1, material );
+
+        if( material.starting_vertex_index != CORNER_AMOUNT || material.count != 2 * CORNER_AMOUNT || material.vertex_count != 2 * CORNER_AMOUNT ) {
+            std::cout << "The second material of the combined model is wrong." << std::endl;
+            is_not_success = 1;
+        }
+    }
+
+    delete combined_model_p;
+
+    return is_not_success;
+}
+
+int testQuantize() {
+    const glm::vec3 POSITIONS[] = { glm::vec3( -4, 0, 0 ), glm::vec3( 2, 1, 0.5 ), glm::vec3( 0, 3, -1 ) };
+    const glm::vec3 NORMAL = glm::vec3( 0, 0.6, 0.8 );
+    const glm::vec3 COLOR = glm::vec3( 0.25, 0.5, 1 );
+    const glm::vec2 TEX_COORDS[] = { glm::vec2( 0, 0 ), glm::vec2( 0.3, 1 ), glm::vec2( 1, 0.7 ) };
+    const glm::vec2 REPEATING_TEX_COORD = glm::vec2( 2.5, 0.5 );
+
+    Utilities::ModelBuilder model;
+
+    auto position_component_index = model.addVertexComponent( Utilities::ModelBuilder::POSITION_COMPONENT_NAME, Utilities::DataTypes::FLOAT, Utilities::DataTypes::VEC3, false );
+    auto normal_component_index = model.addVertexComponent( Utilities::ModelBuilder::NORMAL_COMPONENT_NAME, Utilities::DataTypes::FLOAT, Utilities::DataTypes::VEC3, false );
+    auto color_component_index = model.addVertexComponent( Utilities::ModelBuilder::COLORS_0_COMPONENT_NAME, Utilities::DataTypes::FLOAT, Utilities::DataTypes::VEC3, false );
+    auto tex_coord_0_component_index = model.addVertexComponent( Utilities::ModelBuilder::TEX_COORD_0_COMPONENT_NAME, Utilities::DataTypes::FLOAT, Utilities::DataTypes::VEC2, false );
+    auto tex_coord_1_component_index = model.addVertexComponent( Utilities::ModelBuilder::TEX_COORD_1_COMPONENT_NAME, Utilities::DataTypes::FLOAT, Utilities::DataTypes::VEC2, false );
+
+    model.setupVertexComponents();
+    model.setMaterial( "triangle" );
+
+    for( unsigned i = 0; i < 3; i++ ) {
+        model.startVertex();
+        model.setVertexData( position_component_index, Utilities::DataTypes::Vec3Type( POSITIONS[ i ] ) );
+        model.setVertexData( normal_component_index, Utilities::DataTypes::Vec3Type( NORMAL ) );
+        model.setVertexData( color_component_index, Utilities::DataTypes::Vec3Type( COLOR ) );
+        model.setVertexData( tex_coord_0_component_index, Utilities::DataTypes::Vec2Type( TEX_COORDS[ i ] ) );
+        model.setVertexData( tex_coord_1_component_index, Utilities::DataTypes::Vec2Type( i == 1 ? REPEATING_TEX_COORD : TEX_COORDS[ i ] ) );
+    }
+
+    if( model.quantize() ) {
+        std::cout << "An unfinished model got quantized." << std::endl;
+        return 1;
+    }
+
+    model.finish();
+
+    if( !model.quantize() || !model.isQuantized() ) {
+        std::cout << "The triangle model has failed to quantize." << std::endl;
+        return 1;
+    }
+
+    if( model.quantize() ) {
+        std::cout << "The triangle model got quantized twice." << std::endl;
+        return 1;
+    }
+
+    Utilities::ModelBuilder::VertexComponent element("EMPTY");
+
+    model.getVertexComponent( position_component_index, element );
+
+    if( element.component_type != Utilities::DataTypes::SHORT || element.stride != 7 ) {
+        std::cout << "The quantized position is not a short, or the vertex is not 28 bytes long." << std::endl;
+        return 1;
+    }
+
+    model.getVertexComponent( tex_coord_0_component_index, element );
+
+    if( element.component_type != Utilities::DataTypes::UNSIGNED_SHORT || !element.isNormalized() ) {
+        std::cout << "The texture coordinates inside the texture are not normalized unsigned shorts." << std::endl;
+        return 1;
+    }
+
+    model.getVertexComponent( tex_coord_1_component_index, element );
+
+    if( element.component_type != Utilities::DataTypes::FLOAT ) {
+        std::cout << "The repeating texture coordinates did not stay as floats." << std::endl;
+        return 1;
+    }
+
+    // The largest coordinate must use the whole range of a short.
+    if( std::abs( model.getPositionScale() - 4.0f / 32767.0f ) > 0.000001f ) {
+        std::cout << "The quantized triangle model has the position scale " << model.getPositionScale() << "." << std::endl;
+        return 1;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> colors;
+
+    model.getAttributes( positions, position_component_index, 0, 3 );
+    model.getAttributes( normals, normal_component_index, 0, 3 );
+    model.getAttributes( colors, color_component_index, 0, 3 );
+
+    std::vector<glm::vec2> tex_coords_0;
+    std::vector<glm::vec2> tex_coords_1;
+
+    model.getAttributes( tex_coords_0, tex_coord_0_component_index, 0, 3 );
+    model.getAttributes( tex_coords_1, tex_coord_1_component_index, 0, 3 );
+
+    for( unsigned i = 0; i < 3; i++ ) {
+        for( unsigned e = 0; e < 3; e++ ) {
+            if( std::abs( positions[ i ][ e ] - POSITIONS[ i ][ e ] ) > model.getPositionScale() ||
+                std::abs( normals[ i ][ e ] - NORMAL[ e ] ) > 1.0f / 127.0f ||
+                std::abs( colors[ i ][ e ] - COLOR[ e ] ) > 1.0f / 255.0f ) {
+                std::cout << "The quantized triangle model does not match at vertex " << i << "." << std::endl;
+                return 1;
+            }
+        }
+
+        for( unsigned e = 0; e < 2; e++ ) {
+            if( std::abs( tex_coords_0[ i ][ e ] - TEX_COORDS[ i ][ e ] ) > 1.0f / 65535.0f ||
+                tex_coords_1[ i ][ e ] != ( i == 1 ? REPEATING_TEX_COORD : TEX_COORDS[ i ] )[ e ] ) {
+                std::cout << "The quantized triangle model does not match the texture coordinates at vertex " << i << "." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // The GLES2 world draws the stored shorts with the position scale folded into the model matrix.
+    // That has to put every vertex where the float model would be.
+    const glm::mat4 section_matrix = glm::translate( glm::mat4( 1 ), glm::vec3( 136, 0, -72 ) );
+    const glm::mat4 quantized_matrix = glm::scale( section_matrix, glm::vec3( model.getPositionScale() ) );
+
+    unsigned buffer_size;
+    const uint8_t *const buffer_r = reinterpret_cast<const uint8_t*>( model.getBuffer( buffer_size ) );
+
+    model.getVertexComponent( position_component_index, element );
+
+    for( unsigned i = 0; i < 3; i++ ) {
+        const int16_t *const stored_r = reinterpret_cast<const int16_t*>( buffer_r + sizeof( uint32_t ) * ( i * element.stride + element.begin ) );
+
+        const glm::vec4 world_position = quantized_matrix * glm::vec4( stored_r[ 0 ], stored_r[ 1 ], stored_r[ 2 ], 1 );
+        const glm::vec4 expected_position = section_matrix * glm::vec4( POSITIONS[ i ], 1 );
+
+        for( unsigned e = 0; e < 3; e++ ) {
+            if( std::abs( world_position[ e ] - expected_position[ e ] ) > model.getPositionScale() ) {
+                std::cout << "The position scale transform moves vertex " << i << " to the wrong world position." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    int status;
+    std::vector<Utilities::ModelBuilder*> models = { &model, &model };
+
+    Utilities::ModelBuilder *combined_model_p = Utilities::ModelBuilder::combine( models, status );
+
+    if( combined_model_p != nullptr || status != -11 ) {
+        delete combined_model_p;
+        std::cout << "A quantized model got combined." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+// Two triangles of a quad share two of their corners.
+int testWeld() {
+    const glm::vec3 QUAD_CORNERS[] = {
+        glm::vec3( 0, 0, 0 ), glm::vec3( 1, 0, 0 ), glm::vec3( 1, 1, 0 ),
+        glm::vec3( 1, 1, 0 ), glm::vec3( 0, 1, 0 ), glm::vec3( 0, 0, 0 ) };
+    const unsigned CORNER_AMOUNT = sizeof( QUAD_CORNERS ) / sizeof( QUAD_CORNERS[0] );
+
+    Utilities::ModelBuilder model;
+
+    auto position_component_index = model.addVertexComponent( Utilities::ModelBuilder::POSITION_COMPONENT_NAME, Utilities::DataTypes::FLOAT, Utilities::DataTypes::VEC3, false );
+
+    model.setupVertexComponents();
+    model.setMaterial( "quad" );
+
+    for( unsigned i = 0; i < CORNER_AMOUNT; i++ ) {
+        model.startVertex();
+        model.setVertexData( position_component_index, Utilities::DataTypes::Vec3Type( QUAD_CORNERS[ i ] ) );
+    }
+
+    Utilities::ModelBuilder unwelded_model( model );
+
+    if( !model.weld() ) {
+        std::cout << "The quad model has failed to weld." << std::endl;
+        return 1;
+    }
+
+    if( model.weld() ) {
+        std::cout << "The quad model got welded twice." << std::endl;
+        return 1;
+    }
+
+    if( model.getNumVertices() != 4 || model.getIndexBuffer().size() != CORNER_AMOUNT ) {
+        std::cout << "The welded quad model has " << model.getNumVertices() << " vertices and " << model.getIndexBuffer().size() << " indices instead of 4 and " << CORNER_AMOUNT << "." << std::endl;
+        return 1;
+    }
+
+    Utilities::ModelBuilder::TextureMaterial material;
+
+    model.getMaterial( 0, material );
+
+    if( material.count != CORNER_AMOUNT || material.vertex_count != 4 || material.starting_index != 0 ) {
+        std::cout << "The material of the welded quad model is wrong." << std::endl;
+        return 1;
+    }
+
+    // The indices must give back every corner in its original order.
+    for( unsigned i = 0; i < CORNER_AMOUNT; i++ ) {
+        glm::vec4 attributes( 0 );
+
+        model.getTransformation( attributes, position_component_index, material.starting_vertex_index + model.getIndexBuffer()[ i ] );
+
+        if( glm::vec3( attributes ) != QUAD_CORNERS[ i ] ) {
+            std::cout << "The welded quad model has the wrong corner at index " << i << "." << std::endl;
+            return 1;
+        }
+    }
+
+    int status;
+    std::vector<Utilities::ModelBuilder*> models = { &unwelded_model, &model };
+
+    Utilities::ModelBuilder *combined_model_p = Utilities::ModelBuilder::combine( models, status );
+
+    if( combined_model_p != nullptr ) {
+        delete combined_model_p;
+        std::cout << "A welded model got combined." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+}
+
 int main() {
     Utilities::ModelBuilder model;
 
@@ -195,5 +535,14 @@ int main() {
         }
     }
     
-    return 0;
+    if( testAttributes( model ) != 0 )
+        return 1;
+
+    if( testCombine() != 0 )
+        return 1;
+
+    if( testQuantize() != 0 )
+        return 1;
+
+    return testWeld();
 }
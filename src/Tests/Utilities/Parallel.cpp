@@ -0,0 +1,82 @@
+#include "../../Utilities/Parallel.h"
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using Utilities::Parallel;
+
+namespace {
+    const int FAILURE = 1;
+    const int SUCCESS = 0;
+
+    int testEveryIndex( size_t task_amount, unsigned thread_amount ) {
+        std::vector<std::atomic<unsigned>> visits( task_amount );
+
+        for( auto &visit : visits )
+            visit = 0;
+
+        Parallel::forEach( task_amount, thread_amount, [&visits]( size_t index ) {
+            visits[ index ]++;
+        } );
+
+        for( size_t i = 0; i < task_amount; i++ ) {
+            if( visits[ i ] != 1 ) {
+                std::cout << "Error: with " << thread_amount << " threads index " << i << " got visited " << visits[ i ] << " times instead of once." << std::endl;
+                return FAILURE;
+            }
+        }
+
+        return SUCCESS;
+    }
+
+    int testException( unsigned thread_amount ) {
+        bool caught = false;
+
+        try {
+            Parallel::forEach( 100, thread_amount, []( size_t index ) {
+                if( index == 42 )
+                    throw std::runtime_error( "task failed" );
+            } );
+        }
+        catch( const std::runtime_error & ) {
+            caught = true;
+        }
+
+        if( !caught ) {
+            std::cout << "Error: with " << thread_amount << " threads the exception of a task did not reach the caller." << std::endl;
+            return FAILURE;
+        }
+
+        return SUCCESS;
+    }
+}
+
+int main() {
+    int is_not_success = SUCCESS;
+
+    if( Parallel::getThreadAmount( 0 ) == 0 ) {
+        std::cout << "Error: getThreadAmount( 0 ) returned zero." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    if( Parallel::getThreadAmount( 3 ) != 3 ) {
+        std::cout << "Error: getThreadAmount( 3 ) did not return 3." << std::endl;
+        is_not_success = FAILURE;
+    }
+
+    const unsigned thread_amounts[] = { 0, 1, 2, 7 };
+
+    for( const auto thread_amount : thread_amounts ) {
+        if( testEveryIndex( 0, thread_amount ) != SUCCESS )
+            is_not_success = FAILURE;
+        if( testEveryIndex( 1, thread_amount ) != SUCCESS )
+            is_not_success = FAILURE;
+        if( testEveryIndex( 1000, thread_amount ) != SUCCESS )
+            is_not_success = FAILURE;
+        if( testException( thread_amount ) != SUCCESS )
+            is_not_success = FAILURE;
+    }
+
+    return is_not_success;
+}
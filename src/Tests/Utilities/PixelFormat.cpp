@@ -1,6 +1,8 @@
 #include "../../Utilities/PixelFormat.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "../../Utilities/Image2D.h"
 #include <glm/vec2.hpp>
@@ -638,6 +640,140 @@ int testSemiColor( std::string name )
     return problem;
 }
 
+int testConverters() {
+    int problem = 0;
+    
+    const Utilities::PixelFormatColor *const formats[] = {
+        &Utilities::PixelFormatColor_W8::linear,       &Utilities::PixelFormatColor_W8::s_rgb,
+        &Utilities::PixelFormatColor_W8A8::linear,     &Utilities::PixelFormatColor_W8A8::s_rgb,
+        &Utilities::PixelFormatColor_R5G5B5A1::linear, &Utilities::PixelFormatColor_R5G5B5A1::s_rgb,
+        &Utilities::PixelFormatColor_B5G5R5A1::linear, &Utilities::PixelFormatColor_B5G5R5A1::s_rgb,
+        &Utilities::PixelFormatColor_R5G5B5T1::linear, &Utilities::PixelFormatColor_R5G5B5T1::s_rgb,
+        &Utilities::PixelFormatColor_B5G5R5T1::linear, &Utilities::PixelFormatColor_B5G5R5T1::s_rgb,
+        &Utilities::PixelFormatColor_R8G8B8::linear,   &Utilities::PixelFormatColor_R8G8B8::s_rgb,
+        &Utilities::PixelFormatColor_R8G8B8A8::linear, &Utilities::PixelFormatColor_R8G8B8A8::s_rgb
+    };
+    const Utilities::Buffer::Endian endians[] = { Utilities::Buffer::Endian::LITTLE, Utilities::Buffer::Endian::BIG };
+    
+    // Every 16-bit value gets converted, and the other formats get the same bytes.
+    const size_t PIXEL_AMOUNT = 0x10000;
+    std::vector<uint8_t> source_bytes( 4 * PIXEL_AMOUNT );
+    
+    for( size_t i = 0; i < source_bytes.size(); i++ )
+        source_bytes[ i ] = (i * 0x9E3779B1) >> 11;
+    for( size_t i = 0; i < PIXEL_AMOUNT; i++ ) {
+        source_bytes[ 2 * i + 0 ] = i & 0xFF;
+        source_bytes[ 2 * i + 1 ] = i >> 8;
+    }
+    
+    for( auto source_r : formats ) {
+        for( auto destination_r : formats ) {
+            auto converter_r = Utilities::PixelFormatConverter::get( *source_r, *destination_r );
+            
+            if( converter_r == nullptr ) {
+                std::cout << "PixelFormatConverter from " << source_r->getName() << " to " << destination_r->getName() << " is missing." << std::endl;
+                problem = 1;
+                continue;
+            }
+            
+            for( auto source_endian : endians ) {
+                for( auto destination_endian : endians ) {
+                    std::vector<uint8_t> expected( destination_r->byteSize() * PIXEL_AMOUNT );
+                    std::vector<uint8_t> result( destination_r->byteSize() * PIXEL_AMOUNT );
+                    
+                    Utilities::Buffer::Reader reader( source_bytes.data(), source_r->byteSize() * PIXEL_AMOUNT );
+                    Utilities::Buffer::Writer writer( expected.data(), expected.size() );
+                    
+                    for( size_t i = 0; i < PIXEL_AMOUNT; i++ )
+                        destination_r->writePixel( writer, destination_endian, source_r->readPixel( reader, source_endian ) );
+                    
+                    // The conversion is split, so the start of the pixels is not aligned and both the vector and the remaining pixel loops of the kernels run.
+                    const size_t FIRST_AMOUNT = 3;
+
+                    converter_r->convert( source_bytes.data(), source_endian, result.data(), destination_endian, FIRST_AMOUNT );
+                    converter_r->convert( source_bytes.data() + FIRST_AMOUNT * source_r->byteSize(), source_endian, result.data() + FIRST_AMOUNT * destination_r->byteSize(), destination_endian, PIXEL_AMOUNT - FIRST_AMOUNT );
+                    
+                    for( size_t i = 0; i < result.size(); i++ ) {
+                        if( expected[ i ] != result[ i ] ) {
+                            std::cout << "PixelFormatConverter from " << source_r->getName() << " to " << destination_r->getName() << " does not match readPixel and writePixel.\n"
+                                << "  At byte " << i << " expected " << static_cast<uint32_t>( expected[ i ] ) << " but got " << static_cast<uint32_t>( result[ i ] ) << std::endl;
+                            problem = 1;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    return problem;
+}
+
+int testConverterWidths() {
+    int problem = 0;
+    
+    // These pairs have vector kernels, which convert several pixels at a time and leave the rest to a pixel loop.
+    const Utilities::PixelFormatColor *const sources[] = {
+        &Utilities::PixelFormatColor_R5G5B5A1::linear, &Utilities::PixelFormatColor_R5G5B5A1::s_rgb,
+        &Utilities::PixelFormatColor_B5G5R5A1::linear, &Utilities::PixelFormatColor_B5G5R5A1::s_rgb,
+        &Utilities::PixelFormatColor_R5G5B5T1::linear, &Utilities::PixelFormatColor_R5G5B5T1::s_rgb,
+        &Utilities::PixelFormatColor_B5G5R5T1::linear, &Utilities::PixelFormatColor_B5G5R5T1::s_rgb,
+        &Utilities::PixelFormatColor_R8G8B8::linear,   &Utilities::PixelFormatColor_R8G8B8::s_rgb
+    };
+    const Utilities::PixelFormatColor *const destinations[] = { &Utilities::PixelFormatColor_R8G8B8A8::linear, &Utilities::PixelFormatColor_R8G8B8A8::s_rgb };
+    const Utilities::Buffer::Endian endians[] = { Utilities::Buffer::Endian::LITTLE, Utilities::Buffer::Endian::BIG };
+    
+    const size_t MAX_WIDTH = 33;
+    const size_t GUARD_SIZE = 16;
+    const uint8_t GUARD_BYTE = 0xCD;
+    
+    for( auto source_r : sources ) {
+        for( auto destination_r : destinations ) {
+            auto converter_r = Utilities::PixelFormatConverter::get( *source_r, *destination_r );
+            
+            if( converter_r == nullptr ) {
+                std::cout << "PixelFormatConverter from " << source_r->getName() << " to " << destination_r->getName() << " is missing." << std::endl;
+                problem = 1;
+                continue;
+            }
+            
+            for( auto endian : endians ) {
+                for( size_t width = 1; width <= MAX_WIDTH; width++ ) {
+                    // The row is exactly as big as its pixels, so reading past it is caught by the address sanitizer.
+                    std::vector<uint8_t> row( source_r->byteSize() * width );
+                    
+                    for( size_t i = 0; i < row.size(); i++ )
+                        row[ i ] = ((i + width) * 0x9E3779B1) >> 13;
+                    
+                    std::vector<uint8_t> expected( destination_r->byteSize() * width );
+                    std::vector<uint8_t> result( destination_r->byteSize() * width + GUARD_SIZE, GUARD_BYTE );
+                    
+                    Utilities::Buffer::Reader reader( row.data(), row.size() );
+                    Utilities::Buffer::Writer writer( expected.data(), expected.size() );
+                    
+                    for( size_t i = 0; i < width; i++ )
+                        destination_r->writePixel( writer, endian, source_r->readPixel( reader, endian ) );
+                    
+                    converter_r->convert( row.data(), endian, result.data(), endian, width );
+                    
+                    bool is_matching = std::equal( expected.begin(), expected.end(), result.begin() );
+                    
+                    for( size_t i = expected.size(); i < result.size(); i++ )
+                        is_matching &= result[ i ] == GUARD_BYTE;
+                    
+                    if( !is_matching ) {
+                        std::cout << "PixelFormatConverter from " << source_r->getName() << " to " << destination_r->getName()
+                            << " does not match readPixel and writePixel for a row of " << width << " pixels, or it writes past the row." << std::endl;
+                        problem = 1;
+                    }
+                }
+            }
+        }
+    }
+    
+    return problem;
+}
+
 int main() {
     int problem = 0;
     
@@ -716,6 +852,10 @@ int main() {
         problem |= checkReadWriteOperation( pixel_buffer, generic, Utilities::PixelFormatColor_R8G8B8A8::s_rgb,  "PixelFormatColor_R8G8B8A8::s_rgb",  4 );
     }
     
+    // Test the conversion kernels against the read and write pixel operations.
+    problem |= testConverters();
+    problem |= testConverterWidths();
+    
     if( !checkColorPalette( Utilities::Buffer::Endian::BIG ) ) {
         std::cout << "checkColorPalette() BIG has failed." << std::endl;
         return 1;
@@ -1,8 +1,23 @@
 #include "Buffer.h"
 
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <cassert>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BUFFER_USE_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BUFFER_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BUFFER_USE_NEON
+#endif
 
 namespace {
 bool isLittleEndian() {
@@ -75,65 +90,181 @@ uint8_t read_u8( const uint8_t *const word ) {
 int8_t read_8( const uint8_t *const word) {
     return static_cast<int8_t>( read_u8( word ) );
 }
+
+// These copy amount values while reversing the bytes of each value. The widest vector instructions that the
+// compiler is allowed to use do the bulk of the work, and the values that are left over are swapped one at a time.
+void copySwap16( const uint8_t *source_r, uint8_t *destination_r, size_t amount ) {
+    size_t i = 0;
+
+#ifdef BUFFER_USE_AVX2
+    const __m256i SHUFFLE_MASK = _mm256_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+
+    for( ; i + 16 <= amount; i += 16 ) {
+        const __m256i values = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( source_r + 2 * i ) );
+
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( destination_r + 2 * i ), _mm256_shuffle_epi8( values, SHUFFLE_MASK ) );
+    }
+#endif
+
+#if defined(BUFFER_USE_SSE2)
+    for( ; i + 8 <= amount; i += 8 ) {
+        const __m128i values = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source_r + 2 * i ) );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( destination_r + 2 * i ), _mm_or_si128( _mm_slli_epi16( values, 8 ), _mm_srli_epi16( values, 8 ) ) );
+    }
+#elif defined(BUFFER_USE_NEON)
+    for( ; i + 8 <= amount; i += 8 )
+        vst1q_u8( destination_r + 2 * i, vrev16q_u8( vld1q_u8( source_r + 2 * i ) ) );
+#endif
+
+    for( ; i < amount; i++ ) {
+        const uint8_t first = source_r[ 2 * i + 0 ];
+
+        destination_r[ 2 * i + 0 ] = source_r[ 2 * i + 1 ];
+        destination_r[ 2 * i + 1 ] = first;
+    }
+}
+
+void copySwap32( const uint8_t *source_r, uint8_t *destination_r, size_t amount ) {
+    size_t i = 0;
+
+#ifdef BUFFER_USE_AVX2
+    const __m256i SHUFFLE_MASK = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+
+    for( ; i + 8 <= amount; i += 8 ) {
+        const __m256i values = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( source_r + 4 * i ) );
+
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( destination_r + 4 * i ), _mm256_shuffle_epi8( values, SHUFFLE_MASK ) );
+    }
+#endif
+
+#if defined(BUFFER_USE_SSE2)
+    for( ; i + 4 <= amount; i += 4 ) {
+        __m128i values = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source_r + 4 * i ) );
+
+        // Swap the 16 bit halves of every value, then swap the bytes of every half.
+        values = _mm_shufflehi_epi16( _mm_shufflelo_epi16( values, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _MM_SHUFFLE( 2, 3, 0, 1 ) );
+        values = _mm_or_si128( _mm_slli_epi16( values, 8 ), _mm_srli_epi16( values, 8 ) );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( destination_r + 4 * i ), values );
+    }
+#elif defined(BUFFER_USE_NEON)
+    for( ; i + 4 <= amount; i += 4 )
+        vst1q_u8( destination_r + 4 * i, vrev32q_u8( vld1q_u8( source_r + 4 * i ) ) );
+#endif
+
+    for( ; i < amount; i++ ) {
+        const uint8_t word[4] = { source_r[ 4 * i + 0 ], source_r[ 4 * i + 1 ], source_r[ 4 * i + 2 ], source_r[ 4 * i + 3 ] };
+
+        destination_r[ 4 * i + 0 ] = word[3];
+        destination_r[ 4 * i + 1 ] = word[2];
+        destination_r[ 4 * i + 2 ] = word[1];
+        destination_r[ 4 * i + 3 ] = word[0];
+    }
+}
 }
 
 const bool Utilities::Buffer::IS_CPU_LITTLE_ENDIAN = isLittleEndian();
 const bool Utilities::Buffer::IS_CPU_BIG_ENDIAN = !isLittleEndian();
 
-Utilities::Buffer::Buffer() {}
+Utilities::Buffer::Buffer() : view_r( nullptr ), view_size( 0 ) {}
 
-Utilities::Buffer::Buffer( const uint8_t *const buffer_r, size_t byte_amount ) {
+Utilities::Buffer::Buffer( const uint8_t *const buffer_r, size_t byte_amount ) : view_r( nullptr ), view_size( 0 ) {
     set( buffer_r, byte_amount );
 }
 
-Utilities::Buffer::Buffer( const Buffer &buffer ) {
-    set( buffer.data.data(), buffer.data.size() );
+Utilities::Buffer::Buffer( const Buffer &buffer ) : view_r( buffer.view_r ), view_size( buffer.view_size ), view_owner( buffer.view_owner ) {
+    // Views are shared rather than copied.
+    if( !isView() )
+        set( buffer.data.data(), buffer.data.size() );
 }
 
 Utilities::Buffer::~Buffer() {}
 
+void Utilities::Buffer::detach() {
+    if( !isView() )
+        return;
+
+    const uint8_t *const source_r = view_r;
+    const size_t source_size = view_size;
+
+    // The owner must be kept alive until the copy is done.
+    std::shared_ptr<const void> source_owner = std::move( view_owner );
+
+    view_r = nullptr;
+    view_size = 0;
+
+    data.assign( source_r, source_r + source_size );
+}
+
+void Utilities::Buffer::setView( std::shared_ptr<const void> owner, const uint8_t *const buffer_r, size_t byte_amount ) {
+    data.clear();
+    data.shrink_to_fit();
+
+    if( buffer_r == nullptr || byte_amount == 0 ) {
+        view_r = nullptr;
+        view_size = 0;
+        view_owner = nullptr;
+    }
+    else {
+        view_r = buffer_r;
+        view_size = byte_amount;
+        view_owner = std::move( owner );
+    }
+}
+
 void Utilities::Buffer::reserve( size_t byte_amount ) {
+    detach();
     data.reserve( byte_amount );
 }
 
 bool Utilities::Buffer::allocate( size_t byte_amount ) {
-    reserve( byte_amount + data.size() );
-    for( size_t i = 0; i < byte_amount; i++ )
-        addU8( 0 );
+    detach();
+    data.resize( data.size() + byte_amount, 0 );
     return true;
 }
 
 bool Utilities::Buffer::add( const uint8_t *const buffer, size_t byte_amount ) {
-    const auto TOTAL_SIZE = byte_amount + data.size();
+    detach();
 
-    if( buffer != nullptr ) {
-        reserve( TOTAL_SIZE );
-        for( size_t i = 0; i < byte_amount; i++ )
-            data.push_back( buffer[ i ] );
-    }
+    if( buffer != nullptr )
+        data.insert( data.end(), buffer, buffer + byte_amount );
     else
-        data.resize( TOTAL_SIZE, 0 );
+        data.resize( data.size() + byte_amount, 0 );
 
     return true;
 }
 
 bool Utilities::Buffer::set( const uint8_t *const buffer, size_t byte_amount ) {
+    // Drop the view without copying it since it would be overwritten anyways.
+    view_r = nullptr;
+    view_size = 0;
+    view_owner = nullptr;
+
     data.clear();
 
     return add( buffer, byte_amount );
 }
 
 bool Utilities::Buffer::addU8( uint8_t value ) {
+    detach();
     data.push_back( value );
     return true;
 }
 
 bool Utilities::Buffer::addI8( int8_t value ) {
+    detach();
     data.push_back( *reinterpret_cast<uint8_t*>(&value) );
     return true;
 }
 
 bool Utilities::Buffer::addU16( uint16_t value, Endian endianess ) {
+    detach();
+
     uint16_t store = value;
     
     if( getSwap( endianess ) )
@@ -147,6 +278,8 @@ bool Utilities::Buffer::addU16( uint16_t value, Endian endianess ) {
 }
 
 bool Utilities::Buffer::addI16( int16_t value, Endian endianess ) {
+    detach();
+
     int16_t store = value;
     
     if( getSwap( endianess ) )
@@ -160,6 +293,8 @@ bool Utilities::Buffer::addI16( int16_t value, Endian endianess ) {
 }
 
 bool Utilities::Buffer::addU32( uint32_t value, Endian endianess ) {
+    detach();
+
     uint32_t store = value;
     
     if( getSwap( endianess ) )
@@ -175,6 +310,8 @@ bool Utilities::Buffer::addU32( uint32_t value, Endian endianess ) {
 }
 
 bool Utilities::Buffer::addI32( int32_t value, Endian endianess ) {
+    detach();
+
     int32_t store = value;
     
     if( getSwap( endianess ) )
@@ -190,6 +327,8 @@ bool Utilities::Buffer::addI32( int32_t value, Endian endianess ) {
 }
 
 bool Utilities::Buffer::addU64( uint64_t value, Endian endianess ) {
+    detach();
+
     uint64_t store = value;
     
     if( getSwap( endianess ) )
@@ -209,6 +348,8 @@ bool Utilities::Buffer::addU64( uint64_t value, Endian endianess ) {
 }
 
 bool Utilities::Buffer::addI64(  int64_t value, Endian endianess ) {
+    detach();
+
     int64_t store = value;
     
     if( getSwap( endianess ) )
@@ -234,12 +375,13 @@ bool Utilities::Buffer::write( const std::filesystem::path& file_path ) const {
     
     if( output.is_open() )
     {
-        for( const auto &byte : data )
-            output.put( byte );
-        
+        output.write( reinterpret_cast<const char*>( dangerousPointer() ), getDataSize() );
+
+        const bool is_written = !output.fail();
+
         output.close();
         
-        return true;
+        return is_written;
     }
     else
         return false;
@@ -247,23 +389,35 @@ bool Utilities::Buffer::write( const std::filesystem::path& file_path ) const {
 
 bool Utilities::Buffer::read( const std::filesystem::path& file_path ) {
     std::ifstream input;
-    size_t size;
-    uint8_t byte;
 
-    input.open( file_path, std::ios::binary | std::ios::in );
+    input.open( file_path, std::ios::binary | std::ios::in | std::ios::ate );
 
     if( input.is_open() ) {
-        input.seekg(0, input.end);
-        size = input.tellg();
+        const std::streamoff size = input.tellg();
+
+        if( size < 0 )
+            return false;
+
         input.seekg(0, input.beg);
 
-        for(size_t i = 0; i < size; i++) {
-            input.read(reinterpret_cast<char*>(&byte), 1);
-            addU8(byte);
-        }
+        // The file gets appended to this buffer with one read call.
+        detach();
+
+        const size_t old_size = data.size();
+
+        data.resize( old_size + size );
+
+        input.read( reinterpret_cast<char*>( data.data() + old_size ), size );
+
+        const std::streamsize read_amount = input.gcount();
 
         input.close();
 
+        if( read_amount != size ) {
+            data.resize( old_size + read_amount );
+            return false;
+        }
+
         return true;
     }
     else
@@ -271,16 +425,73 @@ bool Utilities::Buffer::read( const std::filesystem::path& file_path ) {
 }
 
 uint8_t* Utilities::Buffer::dangerousPointer() {
+    detach();
+
     return data.data();
 }
 
 const uint8_t *const Utilities::Buffer::dangerousPointer() const {
+    if( isView() )
+        return view_r;
+
     return data.data();
 }
 
+uint64_t Utilities::Buffer::getHash() const {
+    const uint64_t PRIME_1 = 0x9E3779B185EBCA87;
+    const uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4F;
+
+    const uint8_t *bytes_r = dangerousPointer();
+    const size_t byte_amount = getDataSize();
+
+    auto mix = []( uint64_t lane, uint64_t word ) {
+        lane ^= word * PRIME_2;
+        lane = (lane << 31) | (lane >> 33);
+        return lane * PRIME_1;
+    };
+
+    // Four independent lanes let the cpu work on several words at once.
+    uint64_t lanes[4] = { PRIME_1 + PRIME_2, PRIME_2, 0, 0 - PRIME_1 };
+    size_t i = 0;
+
+    for( ; i + 32 <= byte_amount; i += 32 ) {
+        for( size_t l = 0; l < 4; l++ )
+            lanes[ l ] = mix( lanes[ l ], read_u64( bytes_r + i + 8 * l, IS_CPU_BIG_ENDIAN ) );
+    }
+
+    uint64_t hash = byte_amount * PRIME_1;
+
+    for( size_t l = 0; l < 4; l++ )
+        hash = mix( hash, lanes[ l ] );
+
+    for( ; i + 8 <= byte_amount; i += 8 )
+        hash = mix( hash, read_u64( bytes_r + i, IS_CPU_BIG_ENDIAN ) );
+
+    if( i < byte_amount ) {
+        uint64_t word = 0;
+
+        for( size_t b = 0; i + b < byte_amount; b++ )
+            word |= static_cast<uint64_t>( bytes_r[ i + b ] ) << (8 * b);
+
+        hash = mix( hash, word );
+    }
+
+    // Spread every bit of the hash across the others.
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCD;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
 Utilities::Buffer::Reader Utilities::Buffer::getReader( size_t offset, size_t byte_amount ) const {
+    const uint8_t *const bytes_r = dangerousPointer();
+    const size_t data_size = getDataSize();
+
     if( byte_amount == 0 )
-        byte_amount = data.size() - offset;
+        byte_amount = data_size - offset;
 
     size_t offset_sum = offset + byte_amount;
 
@@ -293,15 +504,17 @@ Utilities::Buffer::Reader Utilities::Buffer::getReader( size_t offset, size_t by
         if( offset_sum < byte_amount )
             return Reader( nullptr, 0 ); // If offset_sum has been overflowed return nullptr.
         else
-        if( offset_sum > data.size() )
+        if( offset_sum > data_size )
             return Reader( nullptr, 0 ); // If the requested data is too much then return nullptr;
         else
-            return Reader( data.data() + offset, byte_amount );
+            return Reader( bytes_r + offset, byte_amount );
     }
 }
 
 Utilities::Buffer::Writer Utilities::Buffer::getWriter( size_t offset, size_t byte_amount )
 {
+    detach();
+
     if( byte_amount == 0 )
         byte_amount = data.size() - offset;
 
@@ -444,11 +657,8 @@ std::vector<uint8_t> Utilities::Buffer::Reader::getBytes( size_t byte_amount, En
                     buffer.push_back( data_r[ i - 1 ] );
                 }
             }
-            else {
-                for( auto i = current_index; i < new_offset; i++ ) {
-                    buffer.push_back( data_r[ i ] );
-                }
-            }
+            else
+                buffer.assign( data_r + current_index, data_r + new_offset );
 
             current_index = new_offset;
 
@@ -590,6 +800,108 @@ int8_t Utilities::Buffer::Reader::readI8() {
     }
 }
 
+const uint8_t* Utilities::Buffer::Reader::advance( const char *const method_name_r, size_t byte_amount ) {
+    size_t new_offset = current_index + byte_amount;
+
+    if( new_offset < current_index )
+        throw BufferOutOfBounds( method_name_r, data_r, size, current_index );
+    else
+    if( new_offset > size )
+        throw BufferOutOfBounds( method_name_r, data_r, size, current_index );
+    else
+    {
+        const uint8_t *const span_r = data_r + current_index;
+
+        current_index = new_offset;
+
+        return span_r;
+    }
+}
+
+const uint8_t* Utilities::Buffer::Reader::readSpan( size_t byte_amount ) {
+    return advance( "readSpan", byte_amount );
+}
+
+void Utilities::Buffer::Reader::readU8Array( uint8_t *destination_r, size_t amount ) {
+    const uint8_t *const span_r = advance( "readU8Array", amount );
+
+    if( amount != 0 )
+        std::memcpy( destination_r, span_r, amount );
+}
+
+void Utilities::Buffer::Reader::readU16Array( uint16_t *destination_r, size_t amount, Endian endianess ) {
+    if( amount > SIZE_MAX / sizeof( uint16_t ) )
+        throw BufferOutOfBounds( "readU16Array", data_r, size, current_index );
+
+    const uint8_t *const span_r = advance( "readU16Array", sizeof( uint16_t ) * amount );
+
+    if( amount == 0 )
+        return;
+
+    if( getSwap( endianess ) )
+        copySwap16( span_r, reinterpret_cast<uint8_t*>( destination_r ), amount );
+    else
+        std::memcpy( destination_r, span_r, sizeof( uint16_t ) * amount );
+}
+
+void Utilities::Buffer::Reader::readU32Array( uint32_t *destination_r, size_t amount, Endian endianess ) {
+    if( amount > SIZE_MAX / sizeof( uint32_t ) )
+        throw BufferOutOfBounds( "readU32Array", data_r, size, current_index );
+
+    const uint8_t *const span_r = advance( "readU32Array", sizeof( uint32_t ) * amount );
+
+    if( amount == 0 )
+        return;
+
+    if( getSwap( endianess ) )
+        copySwap32( span_r, reinterpret_cast<uint8_t*>( destination_r ), amount );
+    else
+        std::memcpy( destination_r, span_r, sizeof( uint32_t ) * amount );
+}
+
+void Utilities::Buffer::Reader::readU16Records( uint16_t *destination_r, size_t record_amount, size_t kept_amount, size_t record_length, Endian endianess ) {
+    assert( kept_amount <= record_length );
+
+    if( record_length != 0 && record_amount > SIZE_MAX / (sizeof( uint16_t ) * record_length) )
+        throw BufferOutOfBounds( "readU16Records", data_r, size, current_index );
+
+    const uint8_t *span_r = advance( "readU16Records", sizeof( uint16_t ) * record_length * record_amount );
+
+    if( record_amount == 0 || kept_amount == 0 )
+        return;
+
+    if( kept_amount == record_length || !getSwap( endianess ) || record_length > 64 ) {
+        for( size_t i = 0; i < record_amount; i++ ) {
+            if( getSwap( endianess ) )
+                copySwap16( span_r, reinterpret_cast<uint8_t*>( destination_r ), kept_amount );
+            else
+                std::memcpy( destination_r, span_r, sizeof( uint16_t ) * kept_amount );
+
+            span_r += sizeof( uint16_t ) * record_length;
+            destination_r += kept_amount;
+        }
+        return;
+    }
+
+    // Swap whole blocks of records at once, then drop the values that are not kept.
+    uint16_t block[ 256 ];
+    const size_t BLOCK_RECORD_AMOUNT = sizeof( block ) / (sizeof( uint16_t ) * record_length);
+
+    for( size_t r = 0; r < record_amount; r += BLOCK_RECORD_AMOUNT ) {
+        const size_t block_record_amount = std::min( BLOCK_RECORD_AMOUNT, record_amount - r );
+
+        copySwap16( span_r, reinterpret_cast<uint8_t*>( block ), block_record_amount * record_length );
+
+        for( size_t i = 0; i < block_record_amount; i++ ) {
+            std::memcpy( destination_r, block + i * record_length, sizeof( uint16_t ) * kept_amount );
+
+            destination_r += kept_amount;
+        }
+
+        span_r += sizeof( uint16_t ) * record_length * block_record_amount;
+    }
+}
+
 std::vector<bool> Utilities::Buffer::Reader::getBitfield( size_t byte_amount ) {
     std::vector<bool> value;
     
@@ -882,6 +1194,5 @@ size_t Utilities::Buffer::Writer::write( std::istream &buffer, size_t byte_amoun
 
 void Utilities::Buffer::Writer::addToBuffer( Buffer& buffer ) const
 {
-    for( size_t i = 0; i < size; i++ )
-        buffer.addU8( data_r[i] );
+    buffer.add( data_r, size );
 }
@@ -4,6 +4,7 @@
 #include <exception>
 #include <istream>
 #include <filesystem>
+#include <memory>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -34,6 +35,18 @@ public:
 protected:
     std::vector<uint8_t> data;
 
+    // If view_r is not null then this buffer references memory owned by view_owner instead of data.
+    const uint8_t *view_r;
+    size_t view_size;
+    std::shared_ptr<const void> view_owner;
+
+    /**
+     * This copies the viewed memory into data, so the buffer could be modified.
+     */
+    void detach();
+
+    size_t getDataSize() const { return isView() ? view_size : data.size(); }
+
 public:
     static bool getSwap( Endian endianess );
     
@@ -42,6 +55,20 @@ public:
     Buffer( const uint8_t *const buffer_r, size_t byte_amount );
     virtual ~Buffer();
 
+    /**
+     * This makes this buffer reference memory that it does not own instead of copying it.
+     * @note Any method that modifies this buffer would copy the viewed memory first.
+     * @param owner This keeps the viewed memory alive for as long as this buffer or its copies reference it.
+     * @param buffer_r The start of the memory to view.
+     * @param byte_amount The amount of bytes to view.
+     */
+    void setView( std::shared_ptr<const void> owner, const uint8_t *const buffer_r, size_t byte_amount );
+
+    /**
+     * @return True if this buffer references memory it does not own.
+     */
+    bool isView() const { return view_r != nullptr; }
+
     void reserve(  size_t byte_amount );
     bool allocate( size_t byte_amount );
     bool add( const uint8_t *const buffer, size_t byte_amount );
@@ -64,6 +91,13 @@ public:
     
     uint8_t* dangerousPointer();
     const uint8_t *const dangerousPointer() const;
+
+    /**
+     * This makes a 64 bit hash of the bytes of this buffer. It is fast, but not meant for security.
+     * @note The hash is the same on big and little endian cpus.
+     * @return The hash of the bytes.
+     */
+    uint64_t getHash() const;
 public:
     class BufferOutOfBounds: public std::exception {
     private:
@@ -80,6 +114,14 @@ public:
         size_t size;
 
         size_t current_index;
+
+        /**
+         * This moves the reader past byte_amount bytes.
+         * @param method_name_r The name of the method to put in BufferOutOfBounds.
+         * @param byte_amount The amount of bytes to move past.
+         * @return The pointer to the first byte moved past.
+         */
+        const uint8_t* advance( const char *const method_name_r, size_t byte_amount );
     public:
         Reader( const Reader& reader );
         Reader( const uint8_t *const buffer_r = nullptr, size_t byte_amount = 0 );
@@ -107,6 +149,35 @@ public:
 
         uint8_t readU8();
         int8_t  readI8();
+
+        /**
+         * This gets the next bytes of the reader without copying them.
+         * @param byte_amount The amount of bytes to read.
+         * @return A pointer to byte_amount contiguous bytes. It is valid as long as the memory of the reader is.
+         */
+        const uint8_t* readSpan( size_t byte_amount );
+
+        /**
+         * These read many values at once, which is much faster than reading them one at a time.
+         * The byte swapping is done with SSE2, AVX2 or NEON when the compiler targets them.
+         * @param destination_r The array to write the values to.
+         * @param amount The amount of values to read, not the amount of bytes.
+         * @param endianess The endian of the values in the reader.
+         */
+        void readU8Array(   uint8_t *destination_r, size_t amount );
+        void readU16Array( uint16_t *destination_r, size_t amount, Endian endianess = NO_SWAP );
+        void readU32Array( uint32_t *destination_r, size_t amount, Endian endianess = NO_SWAP );
+
+        /**
+         * This reads records of 16 bit values, and only keeps the first values of each record.
+         * For example, a vertex stored as x, y, z and a padding value is read with kept_amount 3 and record_length 4.
+         * @param destination_r The array to write record_amount * kept_amount values to.
+         * @param record_amount The amount of records to read.
+         * @param kept_amount The amount of values to keep from the start of each record. It must not exceed record_length.
+         * @param record_length The amount of values in each record.
+         * @param endianess The endian of the values in the reader.
+         */
+        void readU16Records( uint16_t *destination_r, size_t record_amount, size_t kept_amount, size_t record_length, Endian endianess = NO_SWAP );
         
         std::vector<bool> getBitfield( size_t byte_amount = 0 );
 
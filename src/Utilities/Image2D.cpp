@@ -16,6 +16,38 @@ inline void fillInImage( const I &source, U s_x, U s_y, U s_w, U s_h, J &destina
     }
 }
 
+/**
+ * This copies a rectangle from one image to another with the row kernels of PixelFormatConverter.
+ * @return False if the pixel formats have no kernel, in which case nothing got copied.
+ */
+template<class U>
+inline bool convertImage( const Utilities::Image2D &source, U s_x, U s_y, U width, U height, Utilities::Image2D &destination, U d_x, U d_y )
+{
+    auto converter_r = Utilities::PixelFormatConverter::get( *source.getPixelFormat(), *destination.getPixelFormat() );
+
+    if( converter_r == nullptr )
+        return false;
+
+    const size_t SOURCE_PIXEL_SIZE      = source.getPixelFormat()->byteSize();
+    const size_t DESTINATION_PIXEL_SIZE = destination.getPixelFormat()->byteSize();
+
+    const uint8_t *source_r = source.getDirectGridData();
+    uint8_t *destination_r  = destination.getDirectGridData();
+
+    for( U current_y = 0; current_y < height; current_y++ )
+    {
+        const size_t source_offset      = static_cast<size_t>( source.getWidth() )      * (s_y + current_y) + s_x;
+        const size_t destination_offset = static_cast<size_t>( destination.getWidth() ) * (d_y + current_y) + d_x;
+
+        converter_r->convert(
+            source_r      + source_offset      * SOURCE_PIXEL_SIZE,      source.getEndian(),
+            destination_r + destination_offset * DESTINATION_PIXEL_SIZE, destination.getEndian(),
+            width );
+    }
+
+    return true;
+}
+
 template<class U, class I, class J>
 inline bool internalInscribeImage( U x, U y, const I &sub_image, J &destination )
 {
@@ -186,12 +218,16 @@ Utilities::Image2D::Image2D( const Image2D &obj ) : Image2D( obj, *obj.pixel_for
 
 Utilities::Image2D::Image2D( const Image2D &obj, const PixelFormatColor& format ) : Image2D( obj.getWidth(), obj.getHeight(), format, obj.endian )
 {
-    fillInImage<grid_2d_unit, Image2D>( obj, 0, 0, obj.getWidth(), obj.getHeight(), *this, 0, 0, getWidth(), getHeight() );
+    if( !convertImage<grid_2d_unit>( obj, 0, 0, obj.getWidth(), obj.getHeight(), *this, 0, 0 ) )
+        fillInImage<grid_2d_unit, Image2D>( obj, 0, 0, obj.getWidth(), obj.getHeight(), *this, 0, 0, getWidth(), getHeight() );
 }
 
 Utilities::Image2D::Image2D( const ImageBase2D<Grid2DPlacementNormal>& obj, const PixelFormatColor& format ) : Image2D( obj.getWidth(), obj.getHeight(), format, Buffer::NO_SWAP )
 {
-    fillInImage<grid_2d_unit, ImageBase2D<Grid2DPlacementNormal>, Image2D>( obj, 0, 0, obj.getWidth(), obj.getHeight(), *this, 0, 0, getWidth(), getHeight() );
+    auto image_r = dynamic_cast<const Image2D*>( &obj );
+
+    if( image_r == nullptr || !convertImage<grid_2d_unit>( *image_r, 0, 0, obj.getWidth(), obj.getHeight(), *this, 0, 0 ) )
+        fillInImage<grid_2d_unit, ImageBase2D<Grid2DPlacementNormal>, Image2D>( obj, 0, 0, obj.getWidth(), obj.getHeight(), *this, 0, 0, getWidth(), getHeight() );
 }
 
 Utilities::Image2D::Image2D( grid_2d_unit width, grid_2d_unit height, const PixelFormatColor& format, Buffer::Endian endian_param ) : ImageColor2D( width, height, format, endian_param )
@@ -214,6 +250,14 @@ Utilities::PixelFormatColor::GenericColor Utilities::Image2D::readPixel( grid_2d
 
 bool Utilities::Image2D::inscribeSubImage( grid_2d_unit x, grid_2d_unit y, const ImageBase2D<Grid2DPlacementNormal>& sub_image )
 {
+    auto image_r = dynamic_cast<const Image2D*>( &sub_image );
+
+    if( image_r != nullptr &&
+        x + sub_image.getWidth() <= getWidth() &&
+        y + sub_image.getHeight() <= getHeight() &&
+        convertImage<grid_2d_unit>( *image_r, 0, 0, sub_image.getWidth(), sub_image.getHeight(), *this, x, y ) )
+        return true;
+
     return internalInscribeImage<grid_2d_unit, ImageBase2D<Grid2DPlacementNormal>, Image2D>( x, y, sub_image, *this );
 }
 
@@ -227,7 +271,8 @@ bool Utilities::Image2D::subImage( grid_2d_unit x, grid_2d_unit y, grid_2d_unit
     {
         dyn_p->setDimensions( width, height );
 
-        fillInImage<grid_2d_unit, Image2D>( *this, x, y, width, height, *dyn_p, 0, 0, width, height );
+        if( !convertImage<grid_2d_unit>( *this, x, y, width, height, *dyn_p, 0, 0 ) )
+            fillInImage<grid_2d_unit, Image2D>( *this, x, y, width, height, *dyn_p, 0, 0, width, height );
 
         return true;
     }
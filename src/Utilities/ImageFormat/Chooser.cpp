@@ -3,8 +3,11 @@
 #include "QuiteOkImage.h"
 #include "WindowsBitmap.h"
 
-Utilities::ImageFormat::Chooser::Chooser() {
-    formats.push_back( new Utilities::ImageFormat::PortableNetworkGraphics() );
+Utilities::ImageFormat::Chooser::Chooser() : Chooser( Utilities::ImageFormat::PortableNetworkGraphics::DEFAULT_COMPRESSION_LEVEL, 1 ) {
+}
+
+Utilities::ImageFormat::Chooser::Chooser( int png_compression_level, unsigned png_thread_amount ) {
+    formats.push_back( new Utilities::ImageFormat::PortableNetworkGraphics( png_compression_level, png_thread_amount ) );
     formats.push_back( new Utilities::ImageFormat::QuiteOkImage() );
     formats.push_back( new Utilities::ImageFormat::WindowsBitmap() );
     
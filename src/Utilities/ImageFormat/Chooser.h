@@ -18,6 +18,12 @@ protected:
     std::vector<ImageFormat*> reader_references;
 public:
     Chooser();
+
+    /**
+     * @param png_compression_level The zlib compression level of the PNG writer from 0 to 9, or -1 for the default of zlib.
+     * @param png_thread_amount The maximum amount of threads that the PNG writer deflates with. Zero means every hardware thread.
+     */
+    Chooser( int png_compression_level, unsigned png_thread_amount );
     virtual ~Chooser();
     
     /**
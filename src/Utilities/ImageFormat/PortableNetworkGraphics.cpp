@@ -2,6 +2,8 @@
 
 #include "Config.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 
 std::filesystem::path Utilities::ImageFormat::PortableNetworkGraphics::getExtension() const {
@@ -22,12 +24,21 @@ bool Utilities::ImageFormat::PortableNetworkGraphics::isFormat( const Buffer& bu
 
 const std::filesystem::path Utilities::ImageFormat::PortableNetworkGraphics::FILE_EXTENSION = "png";
 
-Utilities::ImageFormat::PortableNetworkGraphics::PortableNetworkGraphics() {}
+Utilities::ImageFormat::PortableNetworkGraphics::PortableNetworkGraphics( int compression_level, unsigned thread_amount ) : thread_amount( thread_amount ) {
+    setCompressionLevel( compression_level );
+}
 
 Utilities::ImageFormat::PortableNetworkGraphics::~PortableNetworkGraphics() {}
 
+void Utilities::ImageFormat::PortableNetworkGraphics::setCompressionLevel( int compression_level ) {
+    if( compression_level < 0 || compression_level > 9 )
+        this->compression_level = DEFAULT_COMPRESSION_LEVEL;
+    else
+        this->compression_level = compression_level;
+}
+
 Utilities::ImageFormat::ImageFormat* Utilities::ImageFormat::PortableNetworkGraphics::duplicate() const {
-    return new PortableNetworkGraphics();
+    return new PortableNetworkGraphics( compression_level, thread_amount );
 }
 
 #ifndef BUILD_WITH_LIBPNG
@@ -54,51 +65,352 @@ int Utilities::ImageFormat::PortableNetworkGraphics::write( const ImageBase2D<Gr
 
 #else
 
-#include <libpng16/png.h>
 #include <zlib.h>
 #include "../ImagePalette2D.h"
+#include "../Parallel.h"
 
 namespace {
 
-png_image setupImage( const Utilities::ImageBase2D<Utilities::Grid2DPlacementNormal>& image_data, bool &is_valid ) {
-    // Thanks NonStatic
-    png_image image_write;
-    memset( &image_write, 0, sizeof(image_write) );
-    image_write.version = PNG_IMAGE_VERSION;
-    image_write.format = PNG_FORMAT_RGB;
-    image_write.height = image_data.getHeight();
-    image_write.width  = image_data.getWidth();
+const uint8_t SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
 
-    is_valid = true;
+const uint8_t COLOR_TYPE_GRAY       = 0;
+const uint8_t COLOR_TYPE_RGB        = 2;
+const uint8_t COLOR_TYPE_GRAY_ALPHA = 4;
+const uint8_t COLOR_TYPE_RGBA       = 6;
+
+const uint8_t FILTER_NONE    = 0;
+const uint8_t FILTER_SUB     = 1;
+const uint8_t FILTER_UP      = 2;
+const uint8_t FILTER_AVERAGE = 3;
+const uint8_t FILTER_PAETH   = 4;
+
+const size_t GROUP_BYTE_AMOUNT = 1 << 18; // The amount of filtered bytes that one thread deflates at once.
+const size_t WINDOW_SIZE = 1 << 15;       // The deflate window which is also the dictionary for the next group.
+
+void writeBigU32( uint8_t *output_r, uint32_t value ) {
+    output_r[0] = (value >> 24) & 0xFF;
+    output_r[1] = (value >> 16) & 0xFF;
+    output_r[2] = (value >>  8) & 0xFF;
+    output_r[3] = (value >>  0) & 0xFF;
+}
 
-    if( dynamic_cast<const Utilities::PixelFormatColor_W8*>( image_data.getPixelFormat() ) != nullptr )
-        image_write.format = PNG_FORMAT_GRAY;
+void addChunk( std::vector<uint8_t> &png, const char type[4], const uint8_t *data_r, size_t length ) {
+    const size_t OFFSET = png.size();
+
+    png.resize( OFFSET + 12 + length );
+
+    uint8_t *chunk_r = png.data() + OFFSET;
+
+    writeBigU32( chunk_r, length );
+    std::memcpy( chunk_r + 4, type, 4 );
+
+    if( length != 0 )
+        std::memcpy( chunk_r + 8, data_r, length );
+
+    // The CRC covers the chunk type and the data but not the length.
+    uLong crc = crc32( 0, chunk_r + 4, 4 + length );
+
+    writeBigU32( chunk_r + 8 + length, crc );
+}
+
+/**
+ * @param pixel_format The pixel format of the rows.
+ * @param channel_amount This gets the amount of bytes per pixel.
+ * @return The PNG color type or 0xFF if the pixel format cannot be written without a conversion.
+ */
+uint8_t getColorType( const Utilities::PixelFormatColor *const pixel_format, unsigned &channel_amount ) {
+    if( dynamic_cast<const Utilities::PixelFormatColor_W8*>( pixel_format ) != nullptr ) {
+        channel_amount = 1;
+        return COLOR_TYPE_GRAY;
+    }
     else
-    if( dynamic_cast<const Utilities::PixelFormatColor_W8A8*>( image_data.getPixelFormat() ) != nullptr )
-        image_write.format = PNG_FORMAT_GA;
+    if( dynamic_cast<const Utilities::PixelFormatColor_W8A8*>( pixel_format ) != nullptr ) {
+        channel_amount = 2;
+        return COLOR_TYPE_GRAY_ALPHA;
+    }
     else
-    if( dynamic_cast<const Utilities::PixelFormatColor_R8G8B8*>( image_data.getPixelFormat() ) != nullptr )
-        image_write.format = PNG_FORMAT_RGB;
+    if( dynamic_cast<const Utilities::PixelFormatColor_R8G8B8*>( pixel_format ) != nullptr ) {
+        channel_amount = 3;
+        return COLOR_TYPE_RGB;
+    }
     else
-    if( dynamic_cast<const Utilities::PixelFormatColor_R8G8B8A8*>( image_data.getPixelFormat() ) != nullptr )
-        image_write.format = PNG_FORMAT_RGBA;
+    if( dynamic_cast<const Utilities::PixelFormatColor_R8G8B8A8*>( pixel_format ) != nullptr ) {
+        channel_amount = 4;
+        return COLOR_TYPE_RGBA;
+    }
+    else {
+        channel_amount = 0;
+        return 0xFF;
+    }
+}
+
+uint8_t paethPredictor( int left, int up, int up_left ) {
+    const int estimate = left + up - up_left;
+    const int left_distance    = std::abs( estimate - left );
+    const int up_distance      = std::abs( estimate - up );
+    const int up_left_distance = std::abs( estimate - up_left );
+
+    if( left_distance <= up_distance && left_distance <= up_left_distance )
+        return left;
+    else if( up_distance <= up_left_distance )
+        return up;
     else
-        is_valid = false;
-        
-    // image_write.format = PNG_FORMAT_LINEAR_Y;
-    // image_write.format = PNG_FORMAT_LINEAR_Y_ALPHA;
-    // image_write.format = PNG_FORMAT_LINEAR_RGB;
-    // image_write.format = PNG_FORMAT_LINEAR_RGB_ALPHA;
-    
-    return image_write;
+        return up_left;
 }
 
-bool internalMemory( png_image& info, void *buffer_r, png_alloc_size_t &length, const Utilities::ImageBase2D<Utilities::Grid2DPlacementNormal>& image_data ) {
-    const Utilities::ImageBase2D<Utilities::Grid2DPlacementNormal>* image_data_r = &image_data;
-    
-    bool is_valid = png_image_write_to_memory( &info, buffer_r, &length, 0, (void*)image_data_r->getDirectGridData(), 0, nullptr );
-    
-    return is_valid;
+/**
+ * This filters a single row with the filter that has the smallest sum of absolute differences.
+ * @param row_r The row to filter.
+ * @param previous_row_r The row above, which is a row of zeros for the first row.
+ * @param row_size The amount of bytes in the row.
+ * @param channel_amount The amount of bytes per pixel.
+ * @param output_r The filter type byte followed by row_size filtered bytes.
+ */
+void filterRow( const uint8_t *row_r, const uint8_t *previous_row_r, size_t row_size, unsigned channel_amount, uint8_t *output_r ) {
+    uint32_t sums[ 5 ] = { 0, 0, 0, 0, 0 };
+
+    // Signed bytes are used for the sums, so small negative differences count as small.
+    auto weight = []( uint8_t value ) -> uint32_t { return value < 128 ? value : 256 - value; };
+
+    for( size_t i = 0; i < row_size; i++ ) {
+        const int value   = row_r[ i ];
+        const int left    = i >= channel_amount ? row_r[ i - channel_amount ] : 0;
+        const int up      = previous_row_r[ i ];
+        const int up_left = i >= channel_amount ? previous_row_r[ i - channel_amount ] : 0;
+
+        sums[ FILTER_NONE ]    += weight( value );
+        sums[ FILTER_SUB ]     += weight( value - left );
+        sums[ FILTER_UP ]      += weight( value - up );
+        sums[ FILTER_AVERAGE ] += weight( value - ((left + up) >> 1) );
+        sums[ FILTER_PAETH ]   += weight( value - paethPredictor( left, up, up_left ) );
+    }
+
+    uint8_t filter = FILTER_NONE;
+
+    for( uint8_t f = FILTER_SUB; f <= FILTER_PAETH; f++ ) {
+        if( sums[ f ] < sums[ filter ] )
+            filter = f;
+    }
+
+    *output_r++ = filter;
+
+    for( size_t i = 0; i < row_size; i++ ) {
+        const int value   = row_r[ i ];
+        const int left    = i >= channel_amount ? row_r[ i - channel_amount ] : 0;
+        const int up      = previous_row_r[ i ];
+        const int up_left = i >= channel_amount ? previous_row_r[ i - channel_amount ] : 0;
+
+        switch( filter ) {
+            case FILTER_NONE:    output_r[ i ] = value; break;
+            case FILTER_SUB:     output_r[ i ] = value - left; break;
+            case FILTER_UP:      output_r[ i ] = value - up; break;
+            case FILTER_AVERAGE: output_r[ i ] = value - ((left + up) >> 1); break;
+            default:             output_r[ i ] = value - paethPredictor( left, up, up_left );
+        }
+    }
+
+}
+
+/**
+ * This encodes an image that is not a palette image into a PNG file.
+ * @param color_image The image to encode.
+ * @param compression_level The zlib compression level.
+ * @param thread_amount The maximum amount of threads to use.
+ * @param png The PNG file gets placed here.
+ * @return 1 for success, -1 for an unsupported pixel format, -2 for an empty image and -3 if deflate failed.
+ */
+int encodeColor( const Utilities::ImageBase2D<Utilities::Grid2DPlacementNormal>& color_image, int compression_level, unsigned thread_amount, std::vector<uint8_t> &png ) {
+    if( color_image.getWidth() == 0 || color_image.getHeight() == 0 )
+        return -2;
+
+    unsigned channel_amount;
+    uint8_t color_type = getColorType( color_image.getPixelFormat(), channel_amount );
+
+    const size_t WIDTH  = color_image.getWidth();
+    const size_t HEIGHT = color_image.getHeight();
+
+    // Pixel formats without a PNG equivalent get converted to R8G8B8A8 once with a row kernel.
+    const Utilities::PixelFormatConverter *converter_r = nullptr;
+
+    if( color_type == 0xFF ) {
+        if( dynamic_cast<const Utilities::PixelFormatColor_R5G5B5A1*>( color_image.getPixelFormat() ) == nullptr )
+            return -1;
+
+        converter_r = Utilities::PixelFormatConverter::get( *color_image.getPixelFormat(), Utilities::PixelFormatColor_R8G8B8A8::linear );
+
+        if( converter_r == nullptr )
+            return -1;
+
+        color_type = getColorType( &Utilities::PixelFormatColor_R8G8B8A8::linear, channel_amount );
+    }
+
+    const size_t ROW_SIZE = WIDTH * channel_amount;
+    const size_t FILTERED_ROW_SIZE = ROW_SIZE + 1;
+    const size_t ROWS_PER_GROUP = std::max<size_t>( 1, GROUP_BYTE_AMOUNT / FILTERED_ROW_SIZE );
+    const size_t GROUP_AMOUNT = (HEIGHT + ROWS_PER_GROUP - 1) / ROWS_PER_GROUP;
+
+    thread_amount = std::min<size_t>( Utilities::Parallel::getThreadAmount( thread_amount ), GROUP_AMOUNT );
+
+    std::vector<uint8_t> converted;
+    const uint8_t *rows_r = color_image.getDirectGridData();
+
+    if( converter_r != nullptr ) {
+        converted.resize( ROW_SIZE * HEIGHT );
+
+        Utilities::Parallel::forEach( GROUP_AMOUNT, thread_amount, [&]( size_t group ) {
+            const size_t BEGIN = group * ROWS_PER_GROUP;
+            const size_t END   = std::min( HEIGHT, BEGIN + ROWS_PER_GROUP );
+
+            converter_r->convert( rows_r + BEGIN * WIDTH * color_image.getPixelFormat()->byteSize(), color_image.getEndian(), converted.data() + BEGIN * ROW_SIZE, Utilities::Buffer::Endian::NO_SWAP, (END - BEGIN) * WIDTH );
+        } );
+
+        rows_r = converted.data();
+    }
+
+    // Filter every row. The groups only read the raw rows, so they do not depend on each other.
+    std::vector<uint8_t> filtered( FILTERED_ROW_SIZE * HEIGHT );
+    const std::vector<uint8_t> zero_row( ROW_SIZE, 0 );
+
+    Utilities::Parallel::forEach( GROUP_AMOUNT, thread_amount, [&]( size_t group ) {
+        const size_t BEGIN = group * ROWS_PER_GROUP;
+        const size_t END   = std::min( HEIGHT, BEGIN + ROWS_PER_GROUP );
+
+        for( size_t y = BEGIN; y < END; y++ )
+            filterRow( rows_r + y * ROW_SIZE, y != 0 ? rows_r + (y - 1) * ROW_SIZE : zero_row.data(), ROW_SIZE, channel_amount, filtered.data() + y * FILTERED_ROW_SIZE );
+    } );
+
+    // Deflate every group as its own raw deflate stream.
+    // Every group except the last ends with a sync flush, so the streams can be joined with no bit shifting.
+    // The end of the previous group is the dictionary of the next group, so little compression is lost at the seams.
+    std::vector<std::vector<uint8_t>> deflated( GROUP_AMOUNT );
+    std::vector<uLong> adlers( GROUP_AMOUNT );
+    std::vector<uint8_t> failed( GROUP_AMOUNT, false );
+
+    Utilities::Parallel::forEach( GROUP_AMOUNT, thread_amount, [&]( size_t group ) {
+        const size_t BEGIN = group * ROWS_PER_GROUP * FILTERED_ROW_SIZE;
+        const size_t END   = std::min( HEIGHT, (group + 1) * ROWS_PER_GROUP ) * FILTERED_ROW_SIZE;
+        const bool IS_LAST = group + 1 == GROUP_AMOUNT;
+
+        adlers[ group ] = adler32( adler32( 0, nullptr, 0 ), filtered.data() + BEGIN, END - BEGIN );
+
+        z_stream stream;
+        std::memset( &stream, 0, sizeof( stream ) );
+
+        if( deflateInit2( &stream, compression_level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY ) != Z_OK ) {
+            failed[ group ] = true;
+            return;
+        }
+
+        if( BEGIN != 0 ) {
+            const size_t DICTIONARY_SIZE = std::min( BEGIN, WINDOW_SIZE );
+
+            deflateSetDictionary( &stream, filtered.data() + BEGIN - DICTIONARY_SIZE, DICTIONARY_SIZE );
+        }
+
+        // The bound does not count the sync flush marker.
+        std::vector<uint8_t> &output = deflated[ group ];
+        output.resize( deflateBound( &stream, END - BEGIN ) + 16 );
+
+        stream.next_in   = filtered.data() + BEGIN;
+        stream.avail_in  = END - BEGIN;
+        stream.next_out  = output.data();
+        stream.avail_out = output.size();
+
+        const int result = deflate( &stream, IS_LAST ? Z_FINISH : Z_SYNC_FLUSH );
+
+        if( (IS_LAST ? result != Z_STREAM_END : result != Z_OK) || stream.avail_in != 0 || stream.avail_out == 0 )
+            failed[ group ] = true;
+
+        output.resize( stream.total_out );
+
+        deflateEnd( &stream );
+    } );
+
+    size_t zlib_size = 2 + 4;
+
+    for( size_t group = 0; group < GROUP_AMOUNT; group++ ) {
+        if( failed[ group ] )
+            return -3;
+
+        zlib_size += deflated[ group ].size();
+    }
+
+    // Join the groups into one zlib stream.
+    std::vector<uint8_t> zlib_stream;
+    zlib_stream.reserve( zlib_size );
+
+    uint8_t level_flag = 2;
+
+    if( compression_level == 0 || compression_level == 1 )
+        level_flag = 0;
+    else if( compression_level >= 2 && compression_level <= 5 )
+        level_flag = 1;
+    else if( compression_level >= 7 )
+        level_flag = 3;
+
+    const uint8_t CMF = 0x78; // Deflate with a 32 KiB window.
+    uint8_t flags = level_flag << 6;
+    flags += 31 - ((CMF << 8) | flags) % 31;
+
+    zlib_stream.push_back( CMF );
+    zlib_stream.push_back( flags );
+
+    uLong adler = adlers[ 0 ];
+
+    for( size_t group = 0; group < GROUP_AMOUNT; group++ ) {
+        zlib_stream.insert( zlib_stream.end(), deflated[ group ].begin(), deflated[ group ].end() );
+
+        if( group != 0 ) {
+            const size_t GROUP_SIZE = (std::min( HEIGHT, (group + 1) * ROWS_PER_GROUP ) - group * ROWS_PER_GROUP) * FILTERED_ROW_SIZE;
+
+            adler = adler32_combine( adler, adlers[ group ], GROUP_SIZE );
+        }
+    }
+
+    zlib_stream.resize( zlib_stream.size() + 4 );
+    writeBigU32( zlib_stream.data() + zlib_stream.size() - 4, adler );
+
+    // Now write the PNG.
+    uint8_t header[ 13 ];
+    writeBigU32( header + 0, WIDTH );
+    writeBigU32( header + 4, HEIGHT );
+    header[  8 ] = 8; // Bit depth.
+    header[  9 ] = color_type;
+    header[ 10 ] = 0; // Compression method.
+    header[ 11 ] = 0; // Filter method.
+    header[ 12 ] = 0; // No interlacing.
+
+    const uint8_t RENDERING_INTENT = 0; // Perceptual, as the libpng simplified API wrote.
+
+    png.reserve( png.size() + sizeof( SIGNATURE ) + 4 * 12 + sizeof( header ) + 1 + zlib_stream.size() );
+    png.insert( png.end(), SIGNATURE, SIGNATURE + sizeof( SIGNATURE ) );
+
+    addChunk( png, "IHDR", header, sizeof( header ) );
+    addChunk( png, "sRGB", &RENDERING_INTENT, 1 );
+    addChunk( png, "IDAT", zlib_stream.data(), zlib_stream.size() );
+    addChunk( png, "IEND", nullptr, 0 );
+
+    return 1;
+}
+
+/**
+ * This encodes the image into a PNG file.
+ * @param image_data The image to encode. A palette image is converted to a color image first.
+ * @param compression_level The zlib compression level.
+ * @param thread_amount The maximum amount of threads to use.
+ * @param png The PNG file gets placed here.
+ * @return 1 for success, -1 for an unsupported pixel format, -2 for an empty image and -3 if deflate failed.
+ */
+int encode( const Utilities::ImageBase2D<Utilities::Grid2DPlacementNormal>& image_data, int compression_level, unsigned thread_amount, std::vector<uint8_t> &png ) {
+    auto palette_image_r = dynamic_cast<const Utilities::ImagePalette2D*>( &image_data );
+
+    if( palette_image_r != nullptr ) {
+        const Utilities::Image2D image_convert = palette_image_r->toColorImage();
+
+        return encodeColor( image_convert, compression_level, thread_amount, png );
+    }
+
+    return encodeColor( image_data, compression_level, thread_amount, png );
 }
 
 }
@@ -131,68 +443,24 @@ bool Utilities::ImageFormat::PortableNetworkGraphics::supports( const PixelForma
 }
 
 size_t Utilities::ImageFormat::PortableNetworkGraphics::getSpace( const ImageBase2D<Grid2DPlacementNormal>& image_data ) const {
-    bool is_valid;
-    auto image_write = setupImage( image_data, is_valid );
-    
-    if( !is_valid )
+    std::vector<uint8_t> png;
+
+    if( encode( image_data, compression_level, thread_amount, png ) != 1 )
         return 0; // The format is invalid for writing.
-    else {
-        png_alloc_size_t length = 0;
-        
-        if( !internalMemory( image_write, nullptr, length, image_data ) )
-            return 0; // Failed to obtain data needed to write the PNG.
-        else
-            return static_cast<size_t>( length );
-    }
+    else
+        return png.size();
 }
 
 int Utilities::ImageFormat::PortableNetworkGraphics::write( const ImageBase2D<Grid2DPlacementNormal>& image_data, Buffer& buffer ) {
-    bool is_valid;
-    png_image image_write;
-    Utilities::Image2D image_convert( 0, 0, *image_data.getPixelFormat() );
-    Utilities::Image2D image_convert_rbga( 0, 0, Utilities::PixelFormatColor_R8G8B8A8::linear ); // TODO Check the color spaces. PNG's use sRGB space.
-    auto selected_image_r = &image_data;
-    
-    if( dynamic_cast<const Utilities::ImagePalette2D*>( &image_data ) != nullptr ) {
-        image_convert.setDimensions( image_data.getWidth(), image_data.getHeight() );
-        
-        image_convert.inscribeSubImage( 0, 0, image_data );
-        
-        selected_image_r = &image_convert;
-    }
-    
-    if( dynamic_cast<const Utilities::PixelFormatColor_R5G5B5A1*>( selected_image_r->getPixelFormat() ) != nullptr ) {
-        image_convert_rbga.setDimensions( selected_image_r->getWidth(), selected_image_r->getHeight() );
-        
-        
-        image_convert_rbga.inscribeSubImage( 0, 0, *selected_image_r );
-        
-        selected_image_r = &image_convert_rbga;
-    }
-    
-    image_write = setupImage( *selected_image_r, is_valid );
-    
-    if( !is_valid )
-        return -1; // The format is invalid for writing.
-    else {
-        png_alloc_size_t length = 0;
-        
-        if( !internalMemory( image_write, nullptr, length, *selected_image_r ) )
-            return -2; // Failed to obtain data needed to write the PNG.
-        else if( length == 0 )
-            return -3; // There is no length to allocate for the buffer.
-        else {
-            // Now, attempt to allocate the buffer.
-            if( !buffer.allocate( length ) )
-                return -4;
-            else {
-                // The buffer is finally allocated. Now, attempt to write the PNG to memory
-                if( internalMemory( image_write, (void*)buffer.dangerousPointer(), length, *selected_image_r ) )
-                    return 1; // The buffer is successfully read.
-                else
-                    return -5; // The image has failed to be written.
-            }
-        }
-    }
+    std::vector<uint8_t> png;
+
+    const int result = encode( image_data, compression_level, thread_amount, png );
+
+    if( result != 1 )
+        return result;
+    else if( !buffer.add( png.data(), png.size() ) )
+        return -4;
+    else
+        return 1;
 }
 #endif
@@ -10,16 +10,35 @@ namespace ImageFormat {
 /**
  * This class only encodes a lossless format.
  *
- * This class uses a PNG library in order to do this task.
+ * This class uses zlib in order to do this task. The rows are split into groups that get deflated on separate threads,
+ * and the groups are joined into one zlib stream like pigz does.
  */
 class PortableNetworkGraphics : public ImageFormat {
 public:
     const static std::filesystem::path FILE_EXTENSION;
+    constexpr static int DEFAULT_COMPRESSION_LEVEL = -1; // This is zlib's own default which is level 6.
+    
+private:
+    int compression_level;
+    unsigned thread_amount;
     
 public:
-    PortableNetworkGraphics();
+    /**
+     * @param compression_level The zlib compression level from 0 (stored) to 9 (smallest), or DEFAULT_COMPRESSION_LEVEL.
+     * @param thread_amount The maximum amount of threads to deflate with. Zero means every hardware thread.
+     */
+    PortableNetworkGraphics( int compression_level = DEFAULT_COMPRESSION_LEVEL, unsigned thread_amount = 1 );
     ~PortableNetworkGraphics();
     
+    int getCompressionLevel() const { return compression_level; }
+    unsigned getThreadAmount() const { return thread_amount; }
+    
+    /**
+     * @param compression_level The zlib compression level from 0 (stored) to 9 (smallest). Anything else would be the default.
+     */
+    void setCompressionLevel( int compression_level );
+    void setThreadAmount( unsigned thread_amount ) { this->thread_amount = thread_amount; }
+    
     virtual ImageFormat* duplicate() const;
     virtual bool isFormat( const Buffer& buffer ) const;
     virtual bool canRead() const;
@@ -1,6 +1,21 @@
 #include "QuiteOkImage.h"
 #include <cassert>
 
+namespace {
+
+const size_t INFO_STRUCT = 14;
+const size_t END_BYTES = 8;
+
+inline void writeBigU32( uint8_t *&output_r, uint32_t value ) {
+    output_r[0] = value >> 24;
+    output_r[1] = value >> 16;
+    output_r[2] = value >>  8;
+    output_r[3] = value >>  0;
+    output_r += 4;
+}
+
+}
+
 const Utilities::ImageFormat::QuiteOkImage::Pixel Utilities::ImageFormat::QuiteOkImage::INITIAL_PIXEL = { 0, 0, 0, 0xFF };
 const Utilities::ImageFormat::QuiteOkImage::Pixel Utilities::ImageFormat::QuiteOkImage::ZERO_PIXEL = { 0, 0, 0, 0 };
 const std::filesystem::path Utilities::ImageFormat::QuiteOkImage::FILE_EXTENSION = "qoi";
@@ -53,12 +68,6 @@ Utilities::ImageFormat::QuiteOkImage::PixelSigned Utilities::ImageFormat::QuiteO
     return result;
 }
 
-bool Utilities::ImageFormat::QuiteOkImage::isOPIndexPossiable( const Utilities::ImageFormat::QuiteOkImage::Pixel& pixel ) const {
-    Pixel hash_pixel = this->pixel_hash_table[ getHashIndex( pixel ) ];
-    
-    return matchColor( hash_pixel, pixel );
-}
-
 bool Utilities::ImageFormat::QuiteOkImage::isOPDiffPossiable( const Utilities::ImageFormat::QuiteOkImage::Pixel& pixel ) const {
     if( previous_pixel.alpha == pixel.alpha )
         return (difference.green >= -2) & (difference.green <= 1 ) & (difference.red >= -2) & (difference.red <= 1 ) & (difference.blue >= -2) & (difference.blue <= 1 );
@@ -84,49 +93,47 @@ bool Utilities::ImageFormat::QuiteOkImage::isOpRGBPossiable( const Utilities::Im
         return false;
 }
 
-void Utilities::ImageFormat::QuiteOkImage::applyOPDiff( const Utilities::ImageFormat::QuiteOkImage::Pixel& pixel, Utilities::Buffer& buffer ) {
+void Utilities::ImageFormat::QuiteOkImage::applyOPDiff( uint8_t *&output_r ) {
     uint8_t diff_byte = QOI_OP_DIFF;
     
     diff_byte |= (difference.red   + BIAS) << 4;
     diff_byte |= (difference.green + BIAS) << 2;
     diff_byte |= (difference.blue  + BIAS);
     
-    buffer.addU8( diff_byte );
+    *output_r++ = diff_byte;
     status.used_diff = true;
 }
 
-void Utilities::ImageFormat::QuiteOkImage::applyOPLuma( const Utilities::ImageFormat::QuiteOkImage::Pixel& pixel, Utilities::Buffer& buffer ) {
-    uint16_t luma_byte = static_cast<uint16_t>( QOI_OP_LUMA ) << 8;
-    
-    luma_byte |= (difference.green + GREEN_BIAS) << 8;
-    luma_byte |= ((dr_dg + BIG_BIAS) & 0b00001111) << 4;
-    luma_byte |= ((db_dg + BIG_BIAS) & 0b00001111);
-    
-    buffer.addU16( luma_byte, Buffer::Endian::BIG );
+void Utilities::ImageFormat::QuiteOkImage::applyOPLuma( uint8_t *&output_r ) {
+    output_r[0] = QOI_OP_LUMA | (difference.green + GREEN_BIAS);
+    output_r[1] = (((dr_dg + BIG_BIAS) & 0b00001111) << 4) | ((db_dg + BIG_BIAS) & 0b00001111);
+    output_r += 2;
     status.used_luma = true;
 }
 
-void Utilities::ImageFormat::QuiteOkImage::applyOPRGB(  const Utilities::ImageFormat::QuiteOkImage::Pixel& pixel, Utilities::Buffer& buffer ) {
-    buffer.addU8( QOI_OP_RGB );
-    buffer.addU8( pixel.red );
-    buffer.addU8( pixel.green );
-    buffer.addU8( pixel.blue );
+void Utilities::ImageFormat::QuiteOkImage::applyOPRGB(  const Utilities::ImageFormat::QuiteOkImage::Pixel& pixel, uint8_t *&output_r ) {
+    output_r[0] = QOI_OP_RGB;
+    output_r[1] = pixel.red;
+    output_r[2] = pixel.green;
+    output_r[3] = pixel.blue;
+    output_r += 4;
     status.used_RGB = true;
 }
 
-void Utilities::ImageFormat::QuiteOkImage::applyOPRGBA( const Utilities::ImageFormat::QuiteOkImage::Pixel& pixel, Utilities::Buffer& buffer ) {
-    buffer.addU8( QOI_OP_RGBA );
-    buffer.addU8( pixel.red );
-    buffer.addU8( pixel.green );
-    buffer.addU8( pixel.blue );
-    buffer.addU8( pixel.alpha );
+void Utilities::ImageFormat::QuiteOkImage::applyOPRGBA( const Utilities::ImageFormat::QuiteOkImage::Pixel& pixel, uint8_t *&output_r ) {
+    output_r[0] = QOI_OP_RGBA;
+    output_r[1] = pixel.red;
+    output_r[2] = pixel.green;
+    output_r[3] = pixel.blue;
+    output_r[4] = pixel.alpha;
+    output_r += 5;
     status.used_RGBA = true;
 }
 
-void Utilities::ImageFormat::QuiteOkImage::applyOPRun( Buffer& buffer ) {
+void Utilities::ImageFormat::QuiteOkImage::applyOPRun( uint8_t *&output_r ) {
     if( this->run_amount > 0 )
     {
-        buffer.addU8( (QOI_OP_D_BIT & (this->run_amount - 1)) | QOI_OP_RUN );
+        *output_r++ = (QOI_OP_D_BIT & (this->run_amount - 1)) | QOI_OP_RUN;
         this->run_amount = 0;
         status.used_run = true;
     }
@@ -209,18 +216,6 @@ std::filesystem::path Utilities::ImageFormat::QuiteOkImage::getExtension() const
 int Utilities::ImageFormat::QuiteOkImage::write( const ImageBase2D<Grid2DPlacementNormal>& image_data, Buffer& buffer ) {
     if( supports( *image_data.getPixelFormat() ) )
     {
-        reset();
-        
-        Pixel current_pixel = INITIAL_PIXEL;
-        
-        // Write the header
-        buffer.addI8( 'q' );
-        buffer.addI8( 'o' );
-        buffer.addI8( 'i' );
-        buffer.addI8( 'f' );
-        buffer.addU32( image_data.getWidth(),  Buffer::Endian::BIG );
-        buffer.addU32( image_data.getHeight(), Buffer::Endian::BIG );
-        
         bool has_alpha = false;
         
         if( dynamic_cast<const Utilities::PixelFormatColor_R8G8B8A8*>( image_data.getPixelFormat() ) != nullptr )
@@ -235,79 +230,38 @@ int Utilities::ImageFormat::QuiteOkImage::write( const ImageBase2D<Grid2DPlaceme
         if( dynamic_cast<const Utilities::PixelFormatColor_B5G5R5A1*>( image_data.getPixelFormat() ) != nullptr )
             has_alpha = true;
         
-        if( has_alpha )
-            buffer.addU8( 4 );
-        else
-            buffer.addU8( 3 );
+        const size_t PIXEL_AMOUNT = static_cast<size_t>( image_data.getWidth() ) * static_cast<size_t>( image_data.getHeight() );
+        std::vector<uint8_t> pixels( 4 * PIXEL_AMOUNT );
         
-        buffer.addU8( 1 ); // Linear color space.
+        // Color images get converted with a kernel instead of a GenericColor for every pixel.
+        auto color_image_r = dynamic_cast<const Image2D*>( &image_data );
+        const PixelFormatConverter *converter_r = nullptr;
         
-        for( size_t y = 0; y < image_data.getHeight(); y++ )
+        if( color_image_r != nullptr )
+            converter_r = PixelFormatConverter::get( *color_image_r->getPixelFormat(), PixelFormatColor_R8G8B8A8::linear );
+        
+        if( converter_r != nullptr )
+            converter_r->convert( color_image_r->getDirectGridData(), color_image_r->getEndian(), pixels.data(), Buffer::Endian::NO_SWAP, PIXEL_AMOUNT );
+        else
         {
-            for( size_t x = 0; x < image_data.getWidth(); x++ )
+            uint8_t *pixel_r = pixels.data();
+            
+            for( size_t y = 0; y < image_data.getHeight(); y++ )
             {
-                auto generic_color = image_data.readPixel( x, y );
-                
-                current_pixel.red   = std::min( generic_color.red * 256.0, 255.);
-                current_pixel.green = std::min( generic_color.green * 256.0, 255.);
-                current_pixel.blue  = std::min( generic_color.blue * 256.0, 255.);
-
-                if( has_alpha )
-                    current_pixel.alpha = std::min( generic_color.alpha * 256.0, 255. );
-                
-                if( matchColor(current_pixel, this->previous_pixel) )
+                for( size_t x = 0; x < image_data.getWidth(); x++ )
                 {
-                    this->run_amount++;
-                    
-                    assert( this->run_amount <= MAX_RUN_AMOUNT );
+                    auto generic_color = image_data.readPixel( x, y );
                     
-                    if( this->run_amount == MAX_RUN_AMOUNT )
-                        applyOPRun( buffer );
+                    pixel_r[0] = std::min( generic_color.red   * 256.0, 255. );
+                    pixel_r[1] = std::min( generic_color.green * 256.0, 255. );
+                    pixel_r[2] = std::min( generic_color.blue  * 256.0, 255. );
+                    pixel_r[3] = std::min( generic_color.alpha * 256.0, 255. );
+                    pixel_r += 4;
                 }
-                else
-                {
-                    applyOPRun( buffer );
-                    
-                    if( isOPIndexPossiable( current_pixel ) )
-                    {
-                        buffer.addU8( (QOI_OP_D_BIT & getHashIndex( current_pixel )) | QOI_OP_INDEX );
-                        status.used_index = true;
-                    }
-                    else
-                    {
-                        difference = subColor( current_pixel, previous_pixel );
-                        
-                        if( isOPDiffPossiable( current_pixel ) )
-                            applyOPDiff( current_pixel, buffer );
-                        else
-                        {
-                            dr_dg = difference.red  - difference.green;
-                            db_dg = difference.blue - difference.green;
-                            
-                            if( isOPLumaPossiable( current_pixel ) )
-                                applyOPLuma( current_pixel, buffer );
-                            else
-                            if( isOpRGBPossiable( current_pixel ) )
-                                applyOPRGB( current_pixel, buffer );
-                            else
-                                applyOPRGBA( current_pixel, buffer );
-                        }
-                    }
-                }
-                placePixelInHash( current_pixel );
-                this->previous_pixel = current_pixel;
             }
         }
         
-        applyOPRun( buffer );
-        
-        buffer.addU64( 0x1, Utilities::Buffer::Endian::BIG );
-        
-        status.complete = true;
-        status.success  = true;
-        status.status   = Status::OKAY;
-        
-        return 1;
+        return writeRGBA( pixels.data(), image_data.getWidth(), image_data.getHeight(), has_alpha, buffer );
     }
     else {
         status.status = Status::INVALID_IMAGE_FORMAT;
@@ -315,12 +269,147 @@ int Utilities::ImageFormat::QuiteOkImage::write( const ImageBase2D<Grid2DPlaceme
     }
 }
 
+int Utilities::ImageFormat::QuiteOkImage::writeRGBA( const uint8_t *pixels_r, uint32_t width, uint32_t height, bool has_alpha, Buffer& buffer ) {
+    reset();
+    
+    const size_t PIXEL_AMOUNT = static_cast<size_t>( width ) * static_cast<size_t>( height );
+    const uint8_t CHANNELS = has_alpha ? 4 : 3;
+    
+    // At worst every pixel is written with all of its channels after the opcode.
+    std::vector<uint8_t> output( INFO_STRUCT + PIXEL_AMOUNT * (CHANNELS + 1) + END_BYTES );
+    uint8_t *output_r = output.data();
+    
+    // Write the header
+    *output_r++ = 'q';
+    *output_r++ = 'o';
+    *output_r++ = 'i';
+    *output_r++ = 'f';
+    writeBigU32( output_r, width );
+    writeBigU32( output_r, height );
+    *output_r++ = CHANNELS;
+    *output_r++ = 1; // Linear color space.
+    
+    Pixel current_pixel = INITIAL_PIXEL;
+    
+    for( size_t i = 0; i < PIXEL_AMOUNT; i++ )
+    {
+        current_pixel.red   = pixels_r[ 4 * i + 0 ];
+        current_pixel.green = pixels_r[ 4 * i + 1 ];
+        current_pixel.blue  = pixels_r[ 4 * i + 2 ];
+        
+        if( has_alpha )
+            current_pixel.alpha = pixels_r[ 4 * i + 3 ];
+        
+        const uint8_t hash_index = getHashIndex( current_pixel );
+        
+        if( matchColor(current_pixel, this->previous_pixel) )
+        {
+            this->run_amount++;
+            
+            assert( this->run_amount <= MAX_RUN_AMOUNT );
+            
+            if( this->run_amount == MAX_RUN_AMOUNT )
+                applyOPRun( output_r );
+        }
+        else
+        {
+            applyOPRun( output_r );
+            
+            if( matchColor( this->pixel_hash_table[ hash_index ], current_pixel ) )
+            {
+                *output_r++ = (QOI_OP_D_BIT & hash_index) | QOI_OP_INDEX;
+                status.used_index = true;
+            }
+            else
+            {
+                difference = subColor( current_pixel, previous_pixel );
+                
+                if( isOPDiffPossiable( current_pixel ) )
+                    applyOPDiff( output_r );
+                else
+                {
+                    dr_dg = difference.red  - difference.green;
+                    db_dg = difference.blue - difference.green;
+                    
+                    if( isOPLumaPossiable( current_pixel ) )
+                        applyOPLuma( output_r );
+                    else
+                    if( isOpRGBPossiable( current_pixel ) )
+                        applyOPRGB( current_pixel, output_r );
+                    else
+                        applyOPRGBA( current_pixel, output_r );
+                }
+            }
+        }
+        this->pixel_hash_table[ hash_index ] = current_pixel;
+        this->previous_pixel = current_pixel;
+    }
+    
+    applyOPRun( output_r );
+    
+    // The end marker is seven zeros and a one.
+    for( size_t i = 0; i < END_BYTES - 1; i++ )
+        *output_r++ = 0;
+    *output_r++ = 1;
+    
+    assert( output_r <= output.data() + output.size() );
+    
+    buffer.add( output.data(), output_r - output.data() );
+    
+    status.complete = true;
+    status.success  = true;
+    status.status   = Status::OKAY;
+    
+    return 1;
+}
+
 int Utilities::ImageFormat::QuiteOkImage::read( const Buffer& buffer, ImageColor2D<Grid2DPlacementNormal>& image_data ) {
-    const size_t INFO_STRUCT = 14;
-    const size_t END_BYTES = 8;
-    bool end_found = false;
+    std::vector<uint8_t> pixels;
     uint32_t width;
     uint32_t height;
+    
+    const int result = readRGBA( buffer, pixels, width, height );
+    
+    if( result < 0 )
+        return result;
+    
+    // Allocate the image.
+    image_data.setDimensions( width, height );
+    
+    // Color images get converted with a kernel instead of a GenericColor for every pixel.
+    auto color_image_r = dynamic_cast<Image2D*>( &image_data );
+    const PixelFormatConverter *converter_r = nullptr;
+    
+    if( color_image_r != nullptr )
+        converter_r = PixelFormatConverter::get( PixelFormatColor_R8G8B8A8::linear, *color_image_r->getPixelFormat() );
+    
+    if( converter_r != nullptr )
+        converter_r->convert( pixels.data(), Buffer::Endian::NO_SWAP, color_image_r->getDirectGridData(), color_image_r->getEndian(), pixels.size() / 4 );
+    else
+    {
+        const uint8_t *pixel_r = pixels.data();
+        
+        for( grid_2d_unit y = 0; y < height; y++ )
+        {
+            for( grid_2d_unit x = 0; x < width; x++ )
+            {
+                PixelFormatColor::GenericColor m_color;
+                
+                m_color.red   = static_cast<float>( pixel_r[0] ) / 256.0;
+                m_color.green = static_cast<float>( pixel_r[1] ) / 256.0;
+                m_color.blue  = static_cast<float>( pixel_r[2] ) / 256.0;
+                m_color.alpha = static_cast<float>( pixel_r[3] ) / 256.0;
+                image_data.writePixel( x, y, m_color );
+                pixel_r += 4;
+            }
+        }
+    }
+    
+    return result;
+}
+
+int Utilities::ImageFormat::QuiteOkImage::readRGBA( const Buffer& buffer, std::vector<uint8_t> &pixels, uint32_t &width, uint32_t &height ) {
+    bool end_found = false;
     uint8_t channels;
     uint8_t colorspace;
     Buffer::Reader reader = buffer.getReader();
@@ -338,10 +427,6 @@ int Utilities::ImageFormat::QuiteOkImage::read( const Buffer& buffer, ImageColor
             channels = reader.readU8();
             colorspace = reader.readU8();
             
-            GridDimensions2D dim2D( width, height );
-            Grid2DPlacementNormal placer( &dim2D );
-            grid_2d_unit placer_x, placer_y;
-            
             if( width != 0 && height != 0 && channels >= 3 && channels <= 4 && colorspace <= 1 )
             {
                 // Find the ending 8 byte 0x1.
@@ -357,33 +442,34 @@ int Utilities::ImageFormat::QuiteOkImage::read( const Buffer& buffer, ImageColor
                 
                 if( end_found )
                 {
-                    Pixel current_pixel;
-                    current_pixel.alpha = 0xFF;
+                    const size_t PIXEL_AMOUNT = static_cast<size_t>( width ) * static_cast<size_t>( height );
                     
-                    // Allocate the image.
-                    image_data.setDimensions( width, height );
+                    pixels.assign( 4 * PIXEL_AMOUNT, 0 );
                     
                     // Once, something was done with channels variable.
                     
                     // TODO Make colorspace > 1 warning Although colorspace has no effect on color space anyways.
                     
-                    reader.setPosition( INFO_STRUCT, Buffer::Direction::BEGIN );
+                    const uint8_t *input_r = buffer.dangerousPointer() + INFO_STRUCT;
+                    const uint8_t *const end_r = buffer.dangerousPointer() + reader.totalSize() - END_BYTES;
+                    uint8_t *pixel_r = pixels.data();
                     
-                    bool no_abort = true;
+                    Pixel current_pixel = INITIAL_PIXEL;
                     size_t m;
                     
-                    for( m = 0; m < width * height && no_abort; m++ )
+                    for( m = 0; m < PIXEL_AMOUNT && input_r < end_r; m++ )
                     {
-                        auto opcode = reader.readU8();
+                        auto opcode = *input_r++;
                         
                         if( (opcode & QOI_OP_RGB) == QOI_OP_RGB )
                         {
-                            current_pixel.red   = reader.readU8();
-                            current_pixel.green = reader.readU8();
-                            current_pixel.blue  = reader.readU8();
+                            current_pixel.red   = input_r[0];
+                            current_pixel.green = input_r[1];
+                            current_pixel.blue  = input_r[2];
+                            input_r += 3;
                             
                             if( opcode == QOI_OP_RGBA ) {
-                                current_pixel.alpha = reader.readU8();
+                                current_pixel.alpha = *input_r++;
                                 status.used_RGBA = true;
                             }
                             else
@@ -401,23 +487,20 @@ int Utilities::ImageFormat::QuiteOkImage::read( const Buffer& buffer, ImageColor
                                 
                                 current_pixel = previous_pixel;
                                 
-                                for( uint8_t i = 0; i < run && m < (width * height - 1); i++, m++ )
+                                for( uint8_t i = 0; i < run && m < (PIXEL_AMOUNT - 1); i++, m++ )
                                 {
-                                    placer.getCoordinates( m, placer_x, placer_y );
-                                    PixelFormatColor::GenericColor m_color;
-                                    
-                                    m_color.red = static_cast<float>( current_pixel.red ) / 256.0;
-                                    m_color.green = static_cast<float>( current_pixel.green ) / 256.0;
-                                    m_color.blue = static_cast<float>( current_pixel.blue ) / 256.0;
-                                    m_color.alpha = static_cast<float>( current_pixel.alpha ) / 256.0;
-                                    image_data.writePixel( placer_x, placer_y, m_color );
+                                    pixel_r[0] = current_pixel.red;
+                                    pixel_r[1] = current_pixel.green;
+                                    pixel_r[2] = current_pixel.blue;
+                                    pixel_r[3] = current_pixel.alpha;
+                                    pixel_r += 4;
                                 }
                                 status.used_run = true;
                             }
                             else
                             if( opcode == QOI_OP_LUMA )
                             {
-                                auto data_2 = reader.readU8();
+                                auto data_2 = *input_r++;
                                 
                                 int16_t diff_green = (static_cast<int8_t>(data) - GREEN_BIAS);
                                 
@@ -441,23 +524,17 @@ int Utilities::ImageFormat::QuiteOkImage::read( const Buffer& buffer, ImageColor
                             }
                         }
                         
-                        placer.getCoordinates( m, placer_x, placer_y );
-                        placer.getCoordinates( m, placer_x, placer_y );
-                        PixelFormatColor::GenericColor m_color;
-                        
-                        m_color.red = static_cast<float>( current_pixel.red ) / 256.0;
-                        m_color.green = static_cast<float>( current_pixel.green ) / 256.0;
-                        m_color.blue = static_cast<float>( current_pixel.blue ) / 256.0;
-                        m_color.alpha = static_cast<float>( current_pixel.alpha ) / 256.0;
-                        image_data.writePixel( placer_x, placer_y, m_color );
+                        pixel_r[0] = current_pixel.red;
+                        pixel_r[1] = current_pixel.green;
+                        pixel_r[2] = current_pixel.blue;
+                        pixel_r[3] = current_pixel.alpha;
+                        pixel_r += 4;
                         
                         placePixelInHash( current_pixel );
                         
                         this->previous_pixel = current_pixel;
-                        
-                        no_abort = reader.getPosition( Buffer::END ) > 8;
                     }
-                    status.complete = (m == (width * height));
+                    status.complete = (m == PIXEL_AMOUNT);
                     status.success = true;
                     
                     status.status = Status::OKAY;
@@ -101,16 +101,17 @@ private:
     static bool matchColor( const Pixel& one, const Pixel& two );
     static PixelSigned subColor( const Pixel& current, const Pixel& previous );
     
-    bool isOPIndexPossiable( const Pixel& pixel ) const;
     bool isOPDiffPossiable( const Pixel& pixel ) const;
     bool isOPLumaPossiable( const Pixel& pixel ) const;
     bool isOpRGBPossiable( const Pixel& pixel ) const;
     
-    void applyOPRun(  Buffer& buffer );
-    void applyOPDiff( const Pixel& pixel, Buffer& buffer );
-    void applyOPLuma( const Pixel& pixel, Buffer& buffer );
-    void applyOPRGB(  const Pixel& pixel, Buffer& buffer );
-    void applyOPRGBA( const Pixel& pixel, Buffer& buffer );
+    // These methods write the opcode at output_r and move output_r past it.
+    // The difference opcodes use the difference found by isOPDiffPossiable and isOPLumaPossiable.
+    void applyOPRun(  uint8_t *&output_r );
+    void applyOPDiff( uint8_t *&output_r );
+    void applyOPLuma( uint8_t *&output_r );
+    void applyOPRGB(  const Pixel& pixel, uint8_t *&output_r );
+    void applyOPRGBA( const Pixel& pixel, uint8_t *&output_r );
     
 public:
     QuiteOkImage();
@@ -130,6 +131,27 @@ public:
     int write( const ImageBase2D<Grid2DPlacementNormal>& image_data, Buffer& buffer );
     int read( const Buffer& buffer, ImageColor2D<Grid2DPlacementNormal>& image_data );
     
+    /**
+     * This encodes pixels that are already 8-bit red, green, blue and alpha without converting them.
+     * @param pixels_r The rows of the image from top to bottom with 4 bytes for every pixel.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param has_alpha If false, the alpha bytes are ignored and the file is written with 3 channels.
+     * @param buffer The buffer to append the file to.
+     * @return 1 for success.
+     */
+    int writeRGBA( const uint8_t *pixels_r, uint32_t width, uint32_t height, bool has_alpha, Buffer& buffer );
+    
+    /**
+     * This decodes a file into 8-bit red, green, blue and alpha rows without converting them.
+     * @param buffer The file to decode.
+     * @param pixels The rows of the image from top to bottom with 4 bytes for every pixel.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @return 1 if the whole image got decoded, 0 if the file ended early and negative numbers for invalid files.
+     */
+    int readRGBA( const Buffer& buffer, std::vector<uint8_t> &pixels, uint32_t &width, uint32_t &height );
+    
     QOIStatus getStatus() const;
 };
 
@@ -1,7 +1,84 @@
 #include "ImagePalette2D.h"
 
+#include <cstring>
+
 namespace {
 
+// These are the bits of the x and the y coordinates inside of a Morton offset, see Grid2DPlacementMorbin.
+const Utilities::order_unit MORTON_X_BITS = 0x55555555;
+const Utilities::order_unit MORTON_Y_BITS = 0xAAAAAAAA;
+
+/**
+ * This moves a Morton offset to the next x coordinate. The y bits are filled, so the carry of the add goes through them.
+ * @param x_bits Only the x bits of the Morton offset.
+ * @return The x bits of the next x coordinate.
+ */
+inline Utilities::order_unit nextMortonX( Utilities::order_unit x_bits ) {
+    return ((x_bits | MORTON_Y_BITS) + 1) & MORTON_X_BITS;
+}
+
+/**
+ * This expands the palette indexes of a rectangle into colors with a table from ColorPalette::getColorTable.
+ * Both the indexes and the colors can either be in the normal order or in the Morton order.
+ * @param PIXEL_SIZE The byte size of a color, zero means that pixel_size is used instead.
+ */
+template<unsigned PIXEL_SIZE, bool IS_SOURCE_MORTON, bool IS_DESTINATION_MORTON>
+void expandIndexes( const uint8_t *table_r, unsigned pixel_size, const uint8_t *indexes_r, Utilities::grid_2d_unit source_width, uint8_t *pixels_r, Utilities::grid_2d_unit destination_width, Utilities::grid_2d_unit width, Utilities::grid_2d_unit height )
+{
+    const size_t SIZE = (PIXEL_SIZE != 0) ? PIXEL_SIZE : pixel_size;
+    const Utilities::Grid2DPlacementMorbin morton( nullptr );
+
+    for( Utilities::grid_2d_unit y = 0; y < height; y++ )
+    {
+        const Utilities::order_unit y_bits = morton.getOffset( 0, y );
+        Utilities::order_unit x_bits = 0;
+
+        const uint8_t *source_row_r = indexes_r + static_cast<size_t>( source_width ) * y;
+        uint8_t *destination_row_r  = pixels_r  + static_cast<size_t>( destination_width ) * y * SIZE;
+
+        for( Utilities::grid_2d_unit x = 0; x < width; x++ )
+        {
+            const size_t source_offset      = IS_SOURCE_MORTON      ? (x_bits | y_bits) : x;
+            const size_t destination_offset = IS_DESTINATION_MORTON ? (x_bits | y_bits) : x;
+
+            const uint8_t *source_r = IS_SOURCE_MORTON      ? indexes_r + source_offset             : source_row_r + source_offset;
+            uint8_t *destination_r  = IS_DESTINATION_MORTON ? pixels_r  + destination_offset * SIZE : destination_row_r + destination_offset * SIZE;
+
+            std::memcpy( destination_r, table_r + static_cast<size_t>( *source_r ) * SIZE, SIZE );
+
+            if( IS_SOURCE_MORTON || IS_DESTINATION_MORTON )
+                x_bits = nextMortonX( x_bits );
+        }
+    }
+}
+
+/**
+ * This picks the expansion loop for the byte size of the colors.
+ */
+template<bool IS_SOURCE_MORTON, bool IS_DESTINATION_MORTON>
+void expandPalette( const Utilities::ColorPalette &palette, const Utilities::PixelFormatColor &format, Utilities::Buffer::Endian endian, const uint8_t *indexes_r, Utilities::grid_2d_unit source_width, uint8_t *pixels_r, Utilities::grid_2d_unit destination_width, Utilities::grid_2d_unit width, Utilities::grid_2d_unit height )
+{
+    const std::vector<uint8_t> table = palette.getColorTable( format, endian );
+    const unsigned pixel_size = format.byteSize();
+
+    switch( pixel_size ) {
+        case 1:
+            expandIndexes<1, IS_SOURCE_MORTON, IS_DESTINATION_MORTON>( table.data(), pixel_size, indexes_r, source_width, pixels_r, destination_width, width, height );
+            break;
+        case 2:
+            expandIndexes<2, IS_SOURCE_MORTON, IS_DESTINATION_MORTON>( table.data(), pixel_size, indexes_r, source_width, pixels_r, destination_width, width, height );
+            break;
+        case 3:
+            expandIndexes<3, IS_SOURCE_MORTON, IS_DESTINATION_MORTON>( table.data(), pixel_size, indexes_r, source_width, pixels_r, destination_width, width, height );
+            break;
+        case 4:
+            expandIndexes<4, IS_SOURCE_MORTON, IS_DESTINATION_MORTON>( table.data(), pixel_size, indexes_r, source_width, pixels_r, destination_width, width, height );
+            break;
+        default:
+            expandIndexes<0, IS_SOURCE_MORTON, IS_DESTINATION_MORTON>( table.data(), pixel_size, indexes_r, source_width, pixels_r, destination_width, width, height );
+    }
+}
+
 template<class U, class I, class J = I>
 inline void fillInImage( const I &source, U s_x, U s_y, U s_w, U s_h, J &destination, U d_x, U d_y, U d_w, U d_h )
 {
@@ -177,43 +254,29 @@ Utilities::Image2D Utilities::ImagePalette2D::toColorImage() const
 {
     Utilities::Image2D image( getWidth(), getHeight(), *getColorPalette()->getColorFormat(), getColorPalette()->getEndian() );
     
-    for( grid_2d_unit current_x = 0; current_x < getWidth(); current_x++ )
-    {
-        for( grid_2d_unit current_y = 0; current_y < getHeight(); current_y++ )
-        {
-            image.writePixel( current_x, current_y, color_palette_p->getIndex( getPixelIndex( current_x, current_y ) ) );
-        }
-    }
+    inscribeColorImage( image );
         
     return image;
 }
 
-
 void Utilities::ImagePalette2D::inscribeColorImage( Image2D &image, const ColorPalette *const palette_r ) const {
-    const ColorPalette * selected_palette_r = palette_r;
+    const ColorPalette * selected_palette_r = color_palette_p;
 
-    // TODO Find a faster algorithm for the case that the placement order is the same.
+    if( palette_r != nullptr )
+        selected_palette_r = palette_r;
 
-    for( grid_2d_unit current_x = 0; current_x < getWidth(); current_x++ )
-    {
-        for( grid_2d_unit current_y = 0; current_y < getHeight(); current_y++ )
-        {
-            image.writePixel( current_x, current_y, selected_palette_r->getIndex( getPixelIndex( current_x, current_y ) ) );
-        }
-    }
+    // Only the pixels that are inside both images get written.
+    const grid_2d_unit width  = std::min( getWidth(),  image.getWidth() );
+    const grid_2d_unit height = std::min( getHeight(), image.getHeight() );
+
+    expandPalette<false, false>( *selected_palette_r, *image.getPixelFormat(), image.getEndian(), getDirectGridData(), getWidth(), image.getDirectGridData(), image.getWidth(), width, height );
 }
 
 Utilities::ImageMorbin2D Utilities::ImagePalette2D::toColorMorbinImage() const
 {
     Utilities::ImageMorbin2D image( getWidth(), getHeight(), *getColorPalette()->getColorFormat(), getColorPalette()->getEndian() );
     
-    for( grid_2d_unit current_x = 0; current_x < getWidth(); current_x++ )
-    {
-        for( grid_2d_unit current_y = 0; current_y < getHeight(); current_y++ )
-        {
-            image.writePixel( current_x, current_y, readPixel( current_x, current_y ) );
-        }
-    }
+    expandPalette<false, true>( *color_palette_p, *image.getPixelFormat(), image.getEndian(), getDirectGridData(), getWidth(), image.getDirectGridData(), image.getWidth(), getWidth(), getHeight() );
     
     return image;
 }
@@ -383,28 +446,18 @@ void Utilities::ImagePaletteMorbin2D::inscribeColorImage( Image2D &image, const
     if( palette_r != nullptr )
         selected_palette_r = palette_r;
 
-    // TODO Find a faster algorithm for the case that the placement order is the same.
+    // Only the pixels that are inside both images get written.
+    const grid_2d_unit width  = std::min( getWidth(),  image.getWidth() );
+    const grid_2d_unit height = std::min( getHeight(), image.getHeight() );
 
-    for( grid_2d_unit current_x = 0; current_x < getWidth(); current_x++ )
-    {
-        for( grid_2d_unit current_y = 0; current_y < getHeight(); current_y++ )
-        {
-            image.writePixel( current_x, current_y, selected_palette_r->getIndex( getPixelIndex( current_x, current_y ) ) );
-        }
-    }
+    expandPalette<true, false>( *selected_palette_r, *image.getPixelFormat(), image.getEndian(), getDirectGridData(), getWidth(), image.getDirectGridData(), image.getWidth(), width, height );
 }
 
 Utilities::ImageMorbin2D Utilities::ImagePaletteMorbin2D::toColorMorbinImage() const
 {
     Utilities::ImageMorbin2D image( getWidth(), getHeight(), *getColorPalette()->getColorFormat(), getColorPalette()->getEndian() );
     
-    for( grid_2d_unit current_x = 0; current_x < getWidth(); current_x++ )
-    {
-        for( grid_2d_unit current_y = 0; current_y < getHeight(); current_y++ )
-        {
-            image.writePixel( current_x, current_y, readPixel( current_x, current_y ) );
-        }
-    }
+    expandPalette<true, true>( *color_palette_p, *image.getPixelFormat(), image.getEndian(), getDirectGridData(), getWidth(), image.getDirectGridData(), image.getWidth(), getWidth(), getHeight() );
     
     return image;
 }
@@ -0,0 +1,127 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+Utilities::MappedFile::MappedFile() : data_r( nullptr ), size( 0 ), file_handle_p( INVALID_HANDLE_VALUE ), mapping_handle_p( nullptr ) {}
+#else
+Utilities::MappedFile::MappedFile() : data_r( nullptr ), size( 0 ), file_descriptor( -1 ) {}
+#endif
+
+Utilities::MappedFile::~MappedFile() {
+    close();
+}
+
+bool Utilities::MappedFile::open( const std::filesystem::path& file_path ) {
+    close();
+
+#ifdef _WIN32
+    file_handle_p = CreateFileW( file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+    if( file_handle_p == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER file_size;
+
+    if( !GetFileSizeEx( file_handle_p, &file_size ) || file_size.QuadPart == 0 ) {
+        close();
+        return false;
+    }
+
+    mapping_handle_p = CreateFileMappingW( file_handle_p, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+    if( mapping_handle_p == nullptr ) {
+        close();
+        return false;
+    }
+
+    void *view_p = MapViewOfFile( mapping_handle_p, FILE_MAP_READ, 0, 0, 0 );
+
+    if( view_p == nullptr ) {
+        close();
+        return false;
+    }
+
+    data_r = reinterpret_cast<const uint8_t*>( view_p );
+    size = static_cast<size_t>( file_size.QuadPart );
+#else
+    file_descriptor = ::open( file_path.c_str(), O_RDONLY );
+
+    if( file_descriptor < 0 )
+        return false;
+
+    struct stat file_status;
+
+    if( fstat( file_descriptor, &file_status ) != 0 || file_status.st_size <= 0 ) {
+        close();
+        return false;
+    }
+
+    void *view_p = mmap( nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0 );
+
+    if( view_p == MAP_FAILED ) {
+        close();
+        return false;
+    }
+
+    data_r = reinterpret_cast<const uint8_t*>( view_p );
+    size = static_cast<size_t>( file_status.st_size );
+
+    // The chunks are read from start to end, so tell the kernel to read ahead.
+    madvise( view_p, size, MADV_SEQUENTIAL );
+#endif
+
+    return true;
+}
+
+void Utilities::MappedFile::close() {
+#ifdef _WIN32
+    if( data_r != nullptr )
+        UnmapViewOfFile( data_r );
+
+    if( mapping_handle_p != nullptr )
+        CloseHandle( mapping_handle_p );
+
+    if( file_handle_p != INVALID_HANDLE_VALUE )
+        CloseHandle( file_handle_p );
+
+    mapping_handle_p = nullptr;
+    file_handle_p = INVALID_HANDLE_VALUE;
+#else
+    if( data_r != nullptr )
+        munmap( const_cast<uint8_t*>( data_r ), size );
+
+    if( file_descriptor >= 0 )
+        ::close( file_descriptor );
+
+    file_descriptor = -1;
+#endif
+
+    data_r = nullptr;
+    size = 0;
+}
+
+Utilities::Buffer::Reader Utilities::MappedFile::getReader( size_t offset, size_t byte_amount ) const {
+    if( data_r == nullptr || offset >= size )
+        return Buffer::Reader( nullptr, 0 );
+
+    if( byte_amount == 0 )
+        byte_amount = size - offset;
+
+    const size_t offset_sum = offset + byte_amount;
+
+    if( offset_sum < byte_amount || offset_sum > size )
+        return Buffer::Reader( nullptr, 0 ); // Overflow or the requested data is too much.
+
+    return Buffer::Reader( data_r + offset, byte_amount );
+}
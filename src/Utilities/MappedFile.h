@@ -0,0 +1,63 @@
+#ifndef UTILITIES_MAPPED_FILE_H
+#define UTILITIES_MAPPED_FILE_H
+
+#include "Buffer.h"
+
+#include <filesystem>
+#include <stdint.h>
+
+namespace Utilities {
+
+/**
+ * This class maps a whole file into read only memory.
+ *
+ * Buffer::setView can reference this memory, so the file can be read without copying it.
+ * Give those buffers a std::shared_ptr of this class, so the mapping outlives them.
+ */
+class MappedFile {
+protected:
+    const uint8_t *data_r;
+    size_t size;
+
+#ifdef _WIN32
+    void *file_handle_p;
+    void *mapping_handle_p;
+#else
+    int file_descriptor;
+#endif
+
+public:
+    MappedFile();
+    MappedFile( const MappedFile & ) = delete;
+    MappedFile& operator=( const MappedFile & ) = delete;
+    virtual ~MappedFile();
+
+    /**
+     * This maps the file into memory. An already opened mapping would be closed first.
+     * @param file_path The path to the file to map.
+     * @return True if the file has been mapped. Empty files cannot be mapped.
+     */
+    bool open( const std::filesystem::path& file_path );
+
+    /**
+     * This unmaps the file. Every pointer and reader into the mapping would become invalid.
+     */
+    void close();
+
+    bool isOpen() const { return data_r != nullptr; }
+
+    size_t getSize() const { return size; }
+
+    const uint8_t *getData() const { return data_r; }
+
+    /**
+     * @param offset The offset into the file.
+     * @param byte_amount The size of the reader. 0 means the rest of the file.
+     * @return A reader for the mapped file or an empty reader if the range is outside the file.
+     */
+    Buffer::Reader getReader( size_t offset = 0, size_t byte_amount = 0 ) const;
+};
+
+}
+
+#endif // UTILITIES_MAPPED_FILE_H
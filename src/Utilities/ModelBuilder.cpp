@@ -1,7 +1,143 @@
 #include "ModelBuilder.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <fstream>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+/**
+ * @param value The coordinate of a position in model space.
+ * @param scale The position scale of the quantized model.
+ * @return The coordinate as it is stored in a quantized model.
+ */
+int16_t quantizeCoordinate( float value, float scale ) {
+    const float MAX_VALUE = std::numeric_limits<int16_t>::max();
+
+    return std::clamp( std::round( value / scale ), -MAX_VALUE, MAX_VALUE );
+}
+
+double getNormalizer( const Utilities::ModelBuilder::VertexComponent &component ) {
+    if( !component.isNormalized() )
+        return 1.0;
+
+    switch( component.component_type ) {
+        case Utilities::DataTypes::UNSIGNED_BYTE:
+            return 1.0 / (std::numeric_limits<uint8_t>().max());
+        case Utilities::DataTypes::BYTE:
+            return 1.0 / (std::numeric_limits<int8_t>().max());
+        case Utilities::DataTypes::UNSIGNED_SHORT:
+            return 1.0 / (std::numeric_limits<uint16_t>().max());
+        case Utilities::DataTypes::SHORT:
+            return 1.0 / (std::numeric_limits<int16_t>().max());
+        case Utilities::DataTypes::UNSIGNED_INT:
+            return 1.0 / (std::numeric_limits<uint32_t>().max());
+        case Utilities::DataTypes::INT:
+            return 1.0 / (std::numeric_limits<int32_t>().max());
+        default:
+            return 1.0;
+    }
+}
+
+/**
+ * This is the loop of getAttributes. The source type and the element amount are template parameters, so the loop does not switch per element.
+ */
+template<class Source, unsigned ELEMENT_AMOUNT, class T>
+void readComponentStream( const uint32_t *source_r, size_t stride, size_t vertex_amount, double normalizer, T *destination_r ) {
+    typedef typename std::remove_const<typename std::remove_reference<decltype( std::declval<const T&>()[0] )>::type>::type Destination;
+
+    const unsigned COPY_AMOUNT = std::min( ELEMENT_AMOUNT, static_cast<unsigned>( T::length() ) );
+
+    for( size_t v = 0; v < vertex_amount; v++ ) {
+        const Source *const values_r = reinterpret_cast<const Source*>( source_r + stride * v );
+
+        for( unsigned i = 0; i < COPY_AMOUNT; i++ ) {
+            if constexpr( std::is_floating_point<Destination>::value ) {
+                // This is the same conversion as getTransformation.
+                float value = values_r[ i ];
+
+                if constexpr( !std::is_floating_point<Source>::value )
+                    value *= normalizer;
+
+                destination_r[ v ][ i ] = value;
+            }
+            else
+                destination_r[ v ][ i ] = static_cast<Destination>( values_r[ i ] );
+        }
+    }
+}
+
+template<class Source, class T>
+void readComponentElements( const Utilities::ModelBuilder::VertexComponent &component, const uint32_t *source_r, size_t vertex_amount, T *destination_r ) {
+    const size_t stride = component.stride == 0 ? 1 : component.stride;
+    const double normalizer = getNormalizer( component );
+
+    switch( component.type ) {
+        case Utilities::DataTypes::Type::SCALAR:
+            readComponentStream<Source, 1>( source_r, stride, vertex_amount, normalizer, destination_r );
+            break;
+        case Utilities::DataTypes::Type::VEC2:
+            readComponentStream<Source, 2>( source_r, stride, vertex_amount, normalizer, destination_r );
+            break;
+        case Utilities::DataTypes::Type::VEC3:
+            readComponentStream<Source, 3>( source_r, stride, vertex_amount, normalizer, destination_r );
+            break;
+        default:
+            readComponentStream<Source, 4>( source_r, stride, vertex_amount, normalizer, destination_r );
+    }
+}
+
+template<class T>
+bool readComponent( const Utilities::ModelBuilder::VertexComponent &component, const uint32_t *source_r, size_t vertex_amount, T *destination_r ) {
+    switch( component.component_type ) {
+        case Utilities::DataTypes::UNSIGNED_BYTE:
+            readComponentElements<uint8_t>( component, source_r, vertex_amount, destination_r );
+            return true;
+        case Utilities::DataTypes::BYTE:
+            readComponentElements<int8_t>( component, source_r, vertex_amount, destination_r );
+            return true;
+        case Utilities::DataTypes::UNSIGNED_SHORT:
+            readComponentElements<uint16_t>( component, source_r, vertex_amount, destination_r );
+            return true;
+        case Utilities::DataTypes::SHORT:
+            readComponentElements<int16_t>( component, source_r, vertex_amount, destination_r );
+            return true;
+        case Utilities::DataTypes::UNSIGNED_INT:
+            readComponentElements<uint32_t>( component, source_r, vertex_amount, destination_r );
+            return true;
+        case Utilities::DataTypes::INT:
+            readComponentElements<int32_t>( component, source_r, vertex_amount, destination_r );
+            return true;
+        case Utilities::DataTypes::FLOAT:
+            readComponentElements<float>( component, source_r, vertex_amount, destination_r );
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * This multiplies the first three elements of every attribute by scale. Integer attributes are kept as they are stored.
+ */
+template<class T>
+void scaleComponent( T *attributes_r, size_t vertex_amount, float scale ) {
+    typedef typename std::remove_const<typename std::remove_reference<decltype( std::declval<const T&>()[0] )>::type>::type Destination;
+
+    if constexpr( std::is_floating_point<Destination>::value ) {
+        const unsigned SCALE_AMOUNT = std::min( 3u, static_cast<unsigned>( T::length() ) );
+
+        for( size_t v = 0; v < vertex_amount; v++ ) {
+            for( unsigned i = 0; i < SCALE_AMOUNT; i++ )
+                attributes_r[ v ][ i ] *= scale;
+        }
+    }
+}
+
+}
 
 const std::string Utilities::ModelBuilder::POSITION_COMPONENT_NAME = "POSITION";
 const std::string Utilities::ModelBuilder::NORMAL_COMPONENT_NAME = "NORMAL";
@@ -75,6 +211,8 @@ Utilities::ModelBuilder::TextureMaterial::TextureMaterial( const TextureMaterial
     file_name( mat.file_name ),
     starting_vertex_index( mat.starting_vertex_index ),
     count( mat.count ),
+    vertex_count( mat.vertex_count ),
+    starting_index( mat.starting_index ),
     addition_index( mat.addition_index ),
     mix_index( mat.mix_index ),
     min( mat.min ),
@@ -123,6 +261,8 @@ Utilities::ModelBuilder::ModelBuilder( MeshPrimativeMode mode ) {
     components_are_done = false;
     joint_amount = 0;
     joint_inverse_frame = std::numeric_limits<unsigned>::max();
+    is_quantized = false;
+    position_scale = 1.0f;
 
     mesh_primative_mode = mode;
 }
@@ -133,10 +273,13 @@ Utilities::ModelBuilder::ModelBuilder( const ModelBuilder& to_copy ) :
         vertex_morph_components( to_copy.vertex_morph_components ),
         total_morph_components_size( to_copy.total_morph_components_size ),
         texture_materials( to_copy.texture_materials ),
+        index_buffer( to_copy.index_buffer ),
         current_vertex_index( to_copy.current_vertex_index ),
         vertex_amount( to_copy.vertex_amount ),
         joint_amount( to_copy.joint_amount ),
         is_model_finished( to_copy.is_model_finished ),
+        is_quantized( to_copy.is_quantized ),
+        position_scale( to_copy.position_scale ),
         components_are_done( to_copy.components_are_done ),
         mesh_primative_mode( to_copy.mesh_primative_mode )
 {
@@ -308,6 +451,15 @@ bool Utilities::ModelBuilder::checkForInvalidComponent( unsigned &begin, std::os
             {
                 if( vertex_components[ begin ].component_type == Utilities::DataTypes::FLOAT )
                     correct = !vertex_components[ begin ].isNormalized();
+                else
+                if( is_quantized ) {
+                    // KHR_mesh_quantization allows these types.
+                    if( vertex_components[ begin ].component_type == Utilities::DataTypes::SHORT && vertex_components[ begin ].isPosition() )
+                        correct = !vertex_components[ begin ].isNormalized();
+                    else
+                    if( vertex_components[ begin ].component_type == Utilities::DataTypes::BYTE && !vertex_components[ begin ].isPosition() )
+                        correct = vertex_components[ begin ].isNormalized();
+                }
             }
         }
         else
@@ -436,6 +588,8 @@ bool Utilities::ModelBuilder::setMaterial( const std::filesystem::path& file_nam
         texture_materials.back().cbmp_resource_id = cbmp_resource_id;
         texture_materials.back().starting_vertex_index = current_vertex_index;
         texture_materials.back().count = 0;
+        texture_materials.back().vertex_count = 0;
+        texture_materials.back().starting_index = 0;
         texture_materials.back().addition_index = std::numeric_limits<unsigned>::max();
         texture_materials.back().mix_index = std::numeric_limits<unsigned>::max();
         texture_materials.back().has_culling = culling_enabled;
@@ -463,6 +617,8 @@ bool Utilities::ModelBuilder::getMaterial(unsigned material_index, TextureMateri
     if( material_index < texture_materials.size() ) {
 
         element.count                 = texture_materials[material_index].count;
+        element.vertex_count          = texture_materials[material_index].vertex_count;
+        element.starting_index        = texture_materials[material_index].starting_index;
         element.addition_index        = texture_materials[material_index].addition_index;
         element.mix_index             = texture_materials[material_index].mix_index;
         element.starting_vertex_index = texture_materials[material_index].starting_vertex_index;
@@ -497,6 +653,7 @@ void Utilities::ModelBuilder::startVertex() {
     }
 
     texture_materials.back().count++;
+    texture_materials.back().vertex_count++;
 }
 
 bool Utilities::ModelBuilder::setVertexIndex( unsigned vertex_index ) {
@@ -610,6 +767,257 @@ bool Utilities::ModelBuilder::finish()
         return false;
 }
 
+bool Utilities::ModelBuilder::getWeldMapping( std::vector<uint32_t> &unique_vertices, std::vector<uint32_t> &indices ) const {
+    const uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+
+    unique_vertices.clear();
+    indices.clear();
+
+    if( !components_are_done || vertex_amount == 0 || isWelded() )
+        return false;
+
+    auto hashVertex = [this]( unsigned vertex_index ) {
+        uint64_t hash = 0xcbf29ce484222325;
+
+        auto hashWords = [&hash]( const uint32_t *words_r, unsigned amount ) {
+            for( unsigned w = 0; w < amount; w++ ) {
+                hash ^= words_r[ w ];
+                hash *= 0x100000001b3;
+            }
+        };
+
+        hashWords( primary_buffer.data() + vertex_index * total_components_size, total_components_size );
+
+        for( const auto &morph_frame : morph_frame_buffers )
+            hashWords( morph_frame.data() + vertex_index * total_morph_components_size, total_morph_components_size );
+
+        // The lower bits pick the slot, so mix the upper bits into them.
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccd;
+        hash ^= hash >> 33;
+
+        return hash;
+    };
+
+    auto isSameVertex = [this]( unsigned a, unsigned b ) {
+        if( !std::equal( primary_buffer.begin() + a * total_components_size, primary_buffer.begin() + (a + 1) * total_components_size, primary_buffer.begin() + b * total_components_size ) )
+            return false;
+
+        for( const auto &morph_frame : morph_frame_buffers ) {
+            if( !std::equal( morph_frame.begin() + a * total_morph_components_size, morph_frame.begin() + (a + 1) * total_morph_components_size, morph_frame.begin() + b * total_morph_components_size ) )
+                return false;
+        }
+
+        return true;
+    };
+
+    std::vector<uint32_t> slots;
+
+    unique_vertices.reserve( vertex_amount );
+    indices.reserve( vertex_amount );
+
+    for( const auto &material : texture_materials ) {
+        const size_t first_unique = unique_vertices.size();
+        const unsigned end_vertex = std::min( material.starting_vertex_index + material.count, vertex_amount );
+
+        size_t slot_amount = 16;
+
+        while( slot_amount < 2 * static_cast<size_t>( material.count ) )
+            slot_amount *= 2;
+
+        slots.assign( slot_amount, EMPTY_SLOT );
+
+        for( unsigned v = material.starting_vertex_index; v < end_vertex; v++ ) {
+            size_t slot = hashVertex( v ) & (slot_amount - 1);
+
+            while( slots[ slot ] != EMPTY_SLOT && !isSameVertex( unique_vertices[ first_unique + slots[ slot ] ], v ) )
+                slot = (slot + 1) & (slot_amount - 1);
+
+            if( slots[ slot ] == EMPTY_SLOT ) {
+                slots[ slot ] = unique_vertices.size() - first_unique;
+                unique_vertices.push_back( v );
+            }
+
+            indices.push_back( first_unique + slots[ slot ] );
+        }
+    }
+
+    return !indices.empty();
+}
+
+bool Utilities::ModelBuilder::weld() {
+    std::vector<uint32_t> unique_vertices;
+    std::vector<uint32_t> indices;
+
+    if( !getWeldMapping( unique_vertices, indices ) )
+        return false;
+
+    // The unique vertices never go past the vertex that they come from, so the buffers are compacted in place.
+    for( unsigned v = 0; v < unique_vertices.size(); v++ ) {
+        if( unique_vertices[ v ] == v )
+            continue;
+
+        std::copy_n( primary_buffer.begin() + unique_vertices[ v ] * total_components_size, total_components_size, primary_buffer.begin() + v * total_components_size );
+
+        for( auto &morph_frame : morph_frame_buffers )
+            std::copy_n( morph_frame.begin() + unique_vertices[ v ] * total_morph_components_size, total_morph_components_size, morph_frame.begin() + v * total_morph_components_size );
+    }
+
+    unsigned welded_vertex_amount = 0;
+    size_t index = 0;
+
+    index_buffer.reserve( indices.size() );
+
+    for( auto &material : texture_materials ) {
+        const unsigned first_vertex = welded_vertex_amount;
+        const unsigned end_vertex = std::min( material.starting_vertex_index + material.count, vertex_amount );
+
+        material.starting_index = index_buffer.size();
+
+        for( unsigned v = material.starting_vertex_index; v < end_vertex; v++ ) {
+            const uint32_t welded_index = indices[ index++ ];
+
+            index_buffer.push_back( welded_index - first_vertex );
+            welded_vertex_amount = std::max( welded_vertex_amount, welded_index + 1 );
+        }
+
+        material.starting_vertex_index = first_vertex;
+        material.count = index_buffer.size() - material.starting_index;
+        material.vertex_count = welded_vertex_amount - first_vertex;
+    }
+
+    vertex_amount = unique_vertices.size();
+    current_vertex_index = vertex_amount;
+
+    primary_buffer.resize( vertex_amount * total_components_size );
+    primary_buffer.shrink_to_fit();
+
+    for( auto &morph_frame : morph_frame_buffers ) {
+        morph_frame.resize( vertex_amount * total_morph_components_size );
+        morph_frame.shrink_to_fit();
+    }
+
+    is_model_finished = true;
+
+    return true;
+}
+
+bool Utilities::ModelBuilder::quantize() {
+    if( !is_model_finished || is_quantized || !morph_frame_buffers.empty() || getNumJoints() != 0 || vertex_amount == 0 )
+        return false;
+
+    // Make the smaller layout first.
+    std::vector<VertexComponent> quantized_components = vertex_components;
+    unsigned quantized_components_size = 0;
+    unsigned position_index = vertex_components.size();
+
+    for( unsigned c = 0; c < quantized_components.size(); c++ ) {
+        VertexComponent &component = quantized_components[ c ];
+
+        if( component.component_type == Utilities::DataTypes::FLOAT ) {
+            if( component.isPosition() && component.type == Utilities::DataTypes::VEC3 ) {
+                component.component_type = Utilities::DataTypes::SHORT;
+                component.setNormalization( false );
+                position_index = c;
+            }
+            else
+            if( NORMAL_COMPONENT_NAME.compare( component.getName() ) == 0 && component.type == Utilities::DataTypes::VEC3 ) {
+                component.component_type = Utilities::DataTypes::BYTE;
+                component.setNormalization( true );
+            }
+            else
+            if( COLORS_0_COMPONENT_NAME.compare( component.getName() ) == 0 && ( component.type == Utilities::DataTypes::VEC3 || component.type == Utilities::DataTypes::VEC4 ) ) {
+                component.component_type = Utilities::DataTypes::UNSIGNED_BYTE;
+                component.setNormalization( true );
+            }
+            else
+            if( ( TEX_COORD_0_COMPONENT_NAME.compare( component.getName() ) == 0 || TEX_COORD_1_COMPONENT_NAME.compare( component.getName() ) == 0 ) && component.type == Utilities::DataTypes::VEC2 ) {
+                // Only texture coordinates inside the texture can be normalized, so repeating ones stay as floats.
+                bool is_inside = true;
+
+                for( unsigned v = 0; v < vertex_amount && is_inside; v++ ) {
+                    const float *const uv_r = reinterpret_cast<const float*>( primary_buffer.data() + v * total_components_size + component.begin );
+
+                    is_inside = uv_r[ 0 ] >= 0.0f && uv_r[ 0 ] <= 1.0f && uv_r[ 1 ] >= 0.0f && uv_r[ 1 ] <= 1.0f;
+                }
+
+                if( is_inside ) {
+                    component.component_type = Utilities::DataTypes::UNSIGNED_SHORT;
+                    component.setNormalization( true );
+                }
+            }
+        }
+
+        component.begin = quantized_components_size;
+        component.size = Utilities::DataTypes::getDataTypeSizeInt32( component.type, component.component_type ) / 4;
+        quantized_components_size += component.size;
+    }
+
+    if( position_index == vertex_components.size() )
+        return false;
+
+    for( auto &component : quantized_components )
+        component.stride = quantized_components_size;
+
+    // One scale is used for the whole model, so the farthest coordinate uses the whole range of a short.
+    float max_coordinate = 0.0f;
+
+    for( unsigned v = 0; v < vertex_amount; v++ ) {
+        const float *const position_r = reinterpret_cast<const float*>( primary_buffer.data() + v * total_components_size + vertex_components[ position_index ].begin );
+
+        for( unsigned i = 0; i < 3; i++ )
+            max_coordinate = std::max( max_coordinate, std::abs( position_r[ i ] ) );
+    }
+
+    const float scale = max_coordinate > 0.0f ? max_coordinate / std::numeric_limits<int16_t>::max() : 1.0f;
+
+    std::vector<uint32_t> quantized_buffer( vertex_amount * quantized_components_size, 0 );
+
+    for( unsigned v = 0; v < vertex_amount; v++ ) {
+        for( unsigned c = 0; c < vertex_components.size(); c++ ) {
+            const VertexComponent &source = vertex_components[ c ];
+            const VertexComponent &destination = quantized_components[ c ];
+
+            const uint32_t *const source_r = primary_buffer.data() + v * total_components_size + source.begin;
+            uint32_t *const destination_r = quantized_buffer.data() + v * quantized_components_size + destination.begin;
+
+            const float *const values_r = reinterpret_cast<const float*>( source_r );
+            const unsigned element_amount = std::min( static_cast<unsigned>( source.type ), 4u );
+
+            switch( destination.component_type == source.component_type ? Utilities::DataTypes::FLOAT : destination.component_type ) {
+                case Utilities::DataTypes::SHORT:
+                    for( unsigned i = 0; i < element_amount; i++ )
+                        reinterpret_cast<int16_t*>( destination_r )[ i ] = quantizeCoordinate( values_r[ i ], scale );
+                    break;
+                case Utilities::DataTypes::BYTE:
+                    for( unsigned i = 0; i < element_amount; i++ )
+                        reinterpret_cast<int8_t*>( destination_r )[ i ] = std::round( std::clamp( values_r[ i ], -1.0f, 1.0f ) * std::numeric_limits<int8_t>::max() );
+                    break;
+                case Utilities::DataTypes::UNSIGNED_BYTE:
+                    for( unsigned i = 0; i < element_amount; i++ )
+                        reinterpret_cast<uint8_t*>( destination_r )[ i ] = std::round( std::clamp( values_r[ i ], 0.0f, 1.0f ) * std::numeric_limits<uint8_t>::max() );
+                    break;
+                case Utilities::DataTypes::UNSIGNED_SHORT:
+                    for( unsigned i = 0; i < element_amount; i++ )
+                        reinterpret_cast<uint16_t*>( destination_r )[ i ] = std::round( std::clamp( values_r[ i ], 0.0f, 1.0f ) * std::numeric_limits<uint16_t>::max() );
+                    break;
+                default:
+                    // This component is kept as it is.
+                    std::memcpy( destination_r, source_r, sizeof( uint32_t ) * source.size );
+            }
+        }
+    }
+
+    primary_buffer.swap( quantized_buffer );
+    vertex_components.swap( quantized_components );
+    total_components_size = quantized_components_size;
+
+    position_scale = scale;
+    is_quantized = true;
+
+    return true;
+}
+
 bool Utilities::ModelBuilder::applyJointTransforms( unsigned frame_index ) {
     const unsigned UNFOUND_INDEX = std::numeric_limits<unsigned>::max();
     
@@ -648,6 +1056,19 @@ bool Utilities::ModelBuilder::applyJointTransforms( unsigned frame_index ) {
             return false; // These three things are needed for this algorithm to work.
         }
         
+        // Every joint matrix of the frame is computed once, instead of once for every vertex.
+        std::vector<glm::mat4> joint_matrices( getNumJoints() );
+
+        for( unsigned j = 0; j < joint_matrices.size(); j++ )
+            joint_matrices[ j ] = getJointFrame( frame_index, j );
+
+        auto getJointMatrix = [&joint_matrices]( unsigned joint_index ) {
+            if( joint_index < joint_matrices.size() )
+                return joint_matrices[ joint_index ];
+            else
+                return glm::mat4( 1.0f );
+        };
+
         for( auto t = texture_materials.begin(); t != texture_materials.end(); t++ ) {
             (*t).min.data.x = std::numeric_limits<float>::max();
             (*t).min.data.y =  (*t).min.data.x;
@@ -656,7 +1077,7 @@ bool Utilities::ModelBuilder::applyJointTransforms( unsigned frame_index ) {
             (*t).max.data.y = -(*t).min.data.x;
             (*t).max.data.z = -(*t).min.data.x;
             
-            for( unsigned i = (*t).starting_vertex_index; i < (*t).starting_vertex_index + (*t).count; i++ ) {
+            for( unsigned i = (*t).starting_vertex_index; i < (*t).starting_vertex_index + (*t).vertex_count; i++ ) {
                 uint32_t *position_values_r = primary_buffer.data() + i * vertex_components[ position_index ].stride + vertex_components[ position_index ].begin;
                 float *positions_3_r = reinterpret_cast<float*>( position_values_r );
                 
@@ -738,14 +1159,14 @@ bool Utilities::ModelBuilder::applyJointTransforms( unsigned frame_index ) {
                         return false; // Invalid Weight unit.
                 }
                 
-                glm::mat4 skin_matrix = weights[ 0 ] * getJointFrame( frame_index, joint_index[ 0 ] );
+                glm::mat4 skin_matrix = weights[ 0 ] * getJointMatrix( joint_index[ 0 ] );
                 
                 // Now, for every weight value do this.
                 for( int d = 1; d < 4; d++ ) {
                     // Do not bother to do matrix multiplications on zeros.
                     if( weights[ d ] != 0.0f ) {
                         // Matrix math with weights.
-                        skin_matrix += weights[ d ] * getJointFrame( frame_index, joint_index[ 0 ] );
+                        skin_matrix += weights[ d ] * getJointMatrix( joint_index[ 0 ] );
                     }
                 }
                 
@@ -791,32 +1212,7 @@ int Utilities::ModelBuilder::getTransformation( glm::vec4& attributes, unsigned
         stride = 1; // The data is tighly packed.
     }
 
-    double normalizer = 1.0;
-
-    if( compenent.isNormalized() ) {
-        switch( compenent.component_type ) {
-            case DataTypes::UNSIGNED_BYTE:
-                normalizer = 1.0 / (std::numeric_limits<uint8_t>().max());
-                break;
-            case DataTypes::BYTE:
-                normalizer = 1.0 / (std::numeric_limits<int8_t>().max());
-                break;
-            case DataTypes::UNSIGNED_SHORT:
-                normalizer = 1.0 / (std::numeric_limits<uint16_t>().max());
-                break;
-            case DataTypes::SHORT:
-                normalizer = 1.0 / (std::numeric_limits<int16_t>().max());
-                break;
-            case DataTypes::UNSIGNED_INT:
-                normalizer = 1.0 / (std::numeric_limits<uint32_t>().max());
-                break;
-            case DataTypes::INT:
-                normalizer = 1.0 / (std::numeric_limits<int32_t>().max());
-                break;
-            default: // Do nothing.
-                break;
-        }
-    }
+    const double normalizer = getNormalizer( compenent );
 
     unsigned element_amount;
 
@@ -903,6 +1299,13 @@ int Utilities::ModelBuilder::getTransformation( glm::vec4& attributes, unsigned
             return 0;
     }
 
+    // Quantized positions are given back in model space.
+    if( is_quantized && compenent.isPosition() ) {
+        for( unsigned i = 0; i < std::min( element_amount, 3u ); i++ ) {
+            *vec_array[ i ] *= position_scale;
+        }
+    }
+
     return element_amount;
 }
 
@@ -926,32 +1329,7 @@ int Utilities::ModelBuilder::getTransformation( glm::vec4& attributes, unsigned
         stride = 1; // The data is tighly packed.
     }
 
-    double normalizer = 1.0;
-
-    if( compenent.isNormalized() ) {
-        switch( compenent.component_type ) {
-            case DataTypes::UNSIGNED_BYTE:
-                normalizer = 1.0 / (std::numeric_limits<uint8_t>().max());
-                break;
-            case DataTypes::BYTE:
-                normalizer = 1.0 / (std::numeric_limits<int8_t>().max());
-                break;
-            case DataTypes::UNSIGNED_SHORT:
-                normalizer = 1.0 / (std::numeric_limits<uint16_t>().max());
-                break;
-            case DataTypes::SHORT:
-                normalizer = 1.0 / (std::numeric_limits<int16_t>().max());
-                break;
-            case DataTypes::UNSIGNED_INT:
-                normalizer = 1.0 / (std::numeric_limits<uint32_t>().max());
-                break;
-            case DataTypes::INT:
-                normalizer = 1.0 / (std::numeric_limits<int32_t>().max());
-                break;
-            default: // Do nothing.
-                break;
-        }
-    }
+    const double normalizer = getNormalizer( compenent );
 
     unsigned element_amount;
 
@@ -1041,11 +1419,58 @@ int Utilities::ModelBuilder::getTransformation( glm::vec4& attributes, unsigned
     return element_amount;
 }
 
-bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std::string title ) const {
-    std::ofstream resource;
+template<class T>
+bool Utilities::ModelBuilder::getAttributes( std::vector<T> &attributes, unsigned vertex_component_index, unsigned first_vertex, unsigned vertex_amount, const T &default_value ) const {
+    attributes.assign( vertex_amount, default_value );
 
-    Json::Value root;
-    
+    if( vertex_components.size() <= vertex_component_index )
+        return false;
+
+    if( first_vertex > this->vertex_amount || vertex_amount > this->vertex_amount - first_vertex )
+        return false;
+
+    const VertexComponent& component = vertex_components[ vertex_component_index ];
+    const size_t stride = component.stride == 0 ? 1 : component.stride;
+
+    if( !readComponent( component, primary_buffer.data() + component.begin + stride * first_vertex, vertex_amount, attributes.data() ) )
+        return false;
+
+    // Quantized positions are given back in model space.
+    if( is_quantized && component.isPosition() )
+        scaleComponent( attributes.data(), vertex_amount, position_scale );
+
+    return true;
+}
+
+template<class T>
+bool Utilities::ModelBuilder::getMorphAttributes( std::vector<T> &attributes, unsigned morph_vertex_component_index, unsigned frame_index, unsigned first_vertex, unsigned vertex_amount, const T &default_value ) const {
+    attributes.assign( vertex_amount, default_value );
+
+    if( vertex_morph_components.size() <= morph_vertex_component_index || morph_frame_buffers.size() <= frame_index )
+        return false;
+
+    if( first_vertex > this->vertex_amount || vertex_amount > this->vertex_amount - first_vertex )
+        return false;
+
+    const VertexComponent& component = vertex_morph_components[ morph_vertex_component_index ];
+    const size_t stride = component.stride == 0 ? 1 : component.stride;
+
+    return readComponent( component, morph_frame_buffers[ frame_index ].data() + component.begin + stride * first_vertex, vertex_amount, attributes.data() );
+}
+
+// These are the only types that getAttributes and getMorphAttributes are made for.
+template bool Utilities::ModelBuilder::getAttributes<glm::vec2>( std::vector<glm::vec2>&, unsigned, unsigned, unsigned, const glm::vec2& ) const;
+template bool Utilities::ModelBuilder::getAttributes<glm::vec3>( std::vector<glm::vec3>&, unsigned, unsigned, unsigned, const glm::vec3& ) const;
+template bool Utilities::ModelBuilder::getAttributes<glm::vec4>( std::vector<glm::vec4>&, unsigned, unsigned, unsigned, const glm::vec4& ) const;
+template bool Utilities::ModelBuilder::getAttributes<glm::u8vec4>( std::vector<glm::u8vec4>&, unsigned, unsigned, unsigned, const glm::u8vec4& ) const;
+template bool Utilities::ModelBuilder::getAttributes<glm::i16vec2>( std::vector<glm::i16vec2>&, unsigned, unsigned, unsigned, const glm::i16vec2& ) const;
+template bool Utilities::ModelBuilder::getMorphAttributes<glm::vec2>( std::vector<glm::vec2>&, unsigned, unsigned, unsigned, unsigned, const glm::vec2& ) const;
+template bool Utilities::ModelBuilder::getMorphAttributes<glm::vec3>( std::vector<glm::vec3>&, unsigned, unsigned, unsigned, unsigned, const glm::vec3& ) const;
+template bool Utilities::ModelBuilder::getMorphAttributes<glm::vec4>( std::vector<glm::vec4>&, unsigned, unsigned, unsigned, unsigned, const glm::vec4& ) const;
+template bool Utilities::ModelBuilder::getMorphAttributes<glm::u8vec4>( std::vector<glm::u8vec4>&, unsigned, unsigned, unsigned, unsigned, const glm::u8vec4& ) const;
+template bool Utilities::ModelBuilder::getMorphAttributes<glm::i16vec2>( std::vector<glm::i16vec2>&, unsigned, unsigned, unsigned, unsigned, const glm::i16vec2& ) const;
+
+void Utilities::ModelBuilder::makeGLTF( Json::Value &root, std::vector<float> &animation_data, const std::string &title ) const {
     const float TIME_SPEED = 1.f / 24.f;
 
     // Write the header of the json file
@@ -1062,55 +1487,73 @@ bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std
         root["nodes"][0]["name"] = title;
     }
 
+    // The node scale turns the quantized positions back into model space.
+    if( is_quantized ) {
+        root["extensionsUsed"].append( "KHR_mesh_quantization" );
+        root["extensionsRequired"].append( "KHR_mesh_quantization" );
+
+        for( unsigned e = 0; e < 3; e++ )
+            root["nodes"][0]["scale"][e] = position_scale;
+    }
+
     // Buffers need to be referenced by the glTF file.
-    unsigned total_binary_buffer_size = 0;
     unsigned morph_buffer_view_index = 0;
     unsigned bone_buffer_view_index = 0;
+    unsigned index_buffer_view_index = 0;
 
-    std::ofstream binary;
+    // The binary buffer is the primary_buffer, then the morph_frame_buffers, then the index_buffer, and then the animation_data.
+    unsigned total_binary_buffer_size = sizeof( uint32_t ) * primary_buffer.size();
 
-    std::filesystem::path binary_location = file_path;
-    binary_location += std::filesystem::path(".bin");
-    binary.open( binary_location, std::ios::binary | std::ios::out );
+    if( morph_frame_buffers.size() > 0 ) {
+        total_binary_buffer_size += sizeof( uint32_t )  * morph_frame_buffers[0].size() * morph_frame_buffers.size();
+    }
 
-    // Write the binary file first.
-    if( binary.is_open() )
-    {
-        binary.write( reinterpret_cast<const char*>( primary_buffer.data() ), sizeof( int32_t ) * primary_buffer.size() );
+    const unsigned index_buffer_offset = total_binary_buffer_size;
 
-        total_binary_buffer_size = sizeof( int32_t ) * primary_buffer.size();
+    total_binary_buffer_size += sizeof( uint32_t ) * index_buffer.size();
 
-        // Write the contents of the buffer to the binary file.
-        for( auto i = morph_frame_buffers.begin(); i != morph_frame_buffers.end(); i++ ) {
-            binary.write( reinterpret_cast<const char*>( (*i).data() ), sizeof( int32_t ) * (*i).size() );
-        }
-        if( morph_frame_buffers.size() > 0 ) {
-            total_binary_buffer_size += sizeof( int32_t )  * morph_frame_buffers[0].size() * morph_frame_buffers.size();
-        }
+    animation_data.clear();
 
-        // Write the primary buffer info to this file as well
-        root["buffers"][0]["uri"] = binary_location.filename().string();
+    // This is the offset in the binary buffer where the next animation_data value would go.
+    auto getAnimationOffset = [&animation_data, total_binary_buffer_size]() {
+        return static_cast<unsigned>( total_binary_buffer_size + sizeof( float ) * animation_data.size() );
+    };
 
-        unsigned index = 0;
+    unsigned index = 0;
 
-        for( auto i = vertex_components.begin(); i != vertex_components.end(); i++ ) {
-            root["bufferViews"][index]["buffer"] = 0;
-            root["bufferViews"][index]["byteLength"] = static_cast<unsigned>((vertex_amount * (*i).stride - (*i).stride + (*i).size) * sizeof( uint32_t ));
-            root["bufferViews"][index]["byteOffset"] = static_cast<unsigned>((*i).begin * sizeof( uint32_t ));
-            root["bufferViews"][index]["byteStride"] = static_cast<unsigned>((*i).stride * sizeof( uint32_t ));
-            
-            root["bufferViews"][index]["target"] = ARRAY_BUFFER;
+    for( auto i = vertex_components.begin(); i != vertex_components.end(); i++ ) {
+        root["bufferViews"][index]["buffer"] = 0;
+        root["bufferViews"][index]["byteLength"] = static_cast<unsigned>((vertex_amount * (*i).stride - (*i).stride + (*i).size) * sizeof( uint32_t ));
+        root["bufferViews"][index]["byteOffset"] = static_cast<unsigned>((*i).begin * sizeof( uint32_t ));
+        root["bufferViews"][index]["byteStride"] = static_cast<unsigned>((*i).stride * sizeof( uint32_t ));
+        
+        root["bufferViews"][index]["target"] = ARRAY_BUFFER;
 
-            // TODO Set this as optional
-            root["bufferViews"][index]["name"] = (*i).getName();
+        // TODO Set this as optional
+        root["bufferViews"][index]["name"] = (*i).getName();
 
-            index++;
-        }
+        index++;
+    }
 
-        for( auto i = vertex_morph_components.begin(); i != vertex_morph_components.end(); i++ ) {
-            const unsigned BYTE_LENGTH = (morph_frame_buffers[0].size()) * sizeof( uint32_t );
-            unsigned byte_offset = ((*i).begin + primary_buffer.size()) * sizeof( uint32_t );
-            const unsigned BYTE_STRIDE = (*i).stride * sizeof( uint32_t );
+    for( auto i = vertex_morph_components.begin(); i != vertex_morph_components.end(); i++ ) {
+        const unsigned BYTE_LENGTH = (morph_frame_buffers[0].size()) * sizeof( uint32_t );
+        unsigned byte_offset = ((*i).begin + primary_buffer.size()) * sizeof( uint32_t );
+        const unsigned BYTE_STRIDE = (*i).stride * sizeof( uint32_t );
+        
+        root["bufferViews"][index]["buffer"] = 0;
+        root["bufferViews"][index]["byteLength"] = BYTE_LENGTH;
+        root["bufferViews"][index]["byteOffset"] = byte_offset;
+        root["bufferViews"][index]["byteStride"] = BYTE_STRIDE;
+        
+        root["bufferViews"][index]["target"] = ARRAY_BUFFER;
+        
+        // TODO Set this as optional
+        root["bufferViews"][index]["name"] = "MORPH_" + (*i).getName();
+        
+        index++;
+        
+        for( unsigned a = 1; a < morph_frame_buffers.size(); a++ ) {
+            byte_offset += BYTE_LENGTH;
             
             root["bufferViews"][index]["buffer"] = 0;
             root["bufferViews"][index]["byteLength"] = BYTE_LENGTH;
@@ -1123,136 +1566,125 @@ bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std
             root["bufferViews"][index]["name"] = "MORPH_" + (*i).getName();
             
             index++;
-            
-            for( unsigned a = 1; a < morph_frame_buffers.size(); a++ ) {
-                byte_offset += BYTE_LENGTH;
-                
-                root["bufferViews"][index]["buffer"] = 0;
-                root["bufferViews"][index]["byteLength"] = BYTE_LENGTH;
-                root["bufferViews"][index]["byteOffset"] = byte_offset;
-                root["bufferViews"][index]["byteStride"] = BYTE_STRIDE;
-                
-                root["bufferViews"][index]["target"] = ARRAY_BUFFER;
-                
-                // TODO Set this as optional
-                root["bufferViews"][index]["name"] = "MORPH_" + (*i).getName();
-                
-                index++;
-            }
         }
+    }
+
+    if( isWelded() ) {
+        index_buffer_view_index = index;
+
+        root["bufferViews"][index]["buffer"] = 0;
+        root["bufferViews"][index]["byteLength"] = static_cast<unsigned>( sizeof( uint32_t ) * index_buffer.size() );
+        root["bufferViews"][index]["byteOffset"] = index_buffer_offset;
+
+        root["bufferViews"][index]["target"] = ELEMENT_ARRAY_BUFFER;
+
+        // TODO Set this as optional
+        root["bufferViews"][index]["name"] = "INDICES";
+
+        index++;
+    }
+    
+    if( !morph_frame_buffers.empty() ) {
+        morph_buffer_view_index = index;
+        const unsigned TIME_BYTE_LENGTH = sizeof( float ) * (morph_frame_buffers.size() + 2);
         
-        if( !morph_frame_buffers.empty() ) {
-            morph_buffer_view_index = index;
-            const unsigned TIME_BYTE_LENGTH = sizeof( float ) * (morph_frame_buffers.size() + 2);
-            
-            root["bufferViews"][index]["buffer"] = 0;
-            root["bufferViews"][index]["byteLength"] = TIME_BYTE_LENGTH;
-            root["bufferViews"][index]["byteOffset"] = static_cast<unsigned>( binary.tellp() );
-            
-            float frame;
-            for( unsigned frame_index = 0; frame_index < morph_frame_buffers.size() + 2; frame_index++ ) {
-                frame = static_cast<float>( frame_index ) * TIME_SPEED;
-                binary.write( reinterpret_cast<const char*>( &frame ), sizeof( float ) );
-            }
-            
-            index++;
-            const unsigned MORPH_BYTE_LENGTH = sizeof( float ) * (morph_frame_buffers.size() + 2) * morph_frame_buffers.size();
-            
-            root["bufferViews"][index]["buffer"] = 0;
-            root["bufferViews"][index]["byteLength"] = MORPH_BYTE_LENGTH;
-            root["bufferViews"][index]["byteOffset"] = static_cast<unsigned>( binary.tellp() );
-            
-            // Write all zeros for the first frame.
-            frame = 0.0f;
+        root["bufferViews"][index]["buffer"] = 0;
+        root["bufferViews"][index]["byteLength"] = TIME_BYTE_LENGTH;
+        root["bufferViews"][index]["byteOffset"] = getAnimationOffset();
+        
+        for( unsigned frame_index = 0; frame_index < morph_frame_buffers.size() + 2; frame_index++ ) {
+            animation_data.push_back( static_cast<float>( frame_index ) * TIME_SPEED );
+        }
+        
+        index++;
+        const unsigned MORPH_BYTE_LENGTH = sizeof( float ) * (morph_frame_buffers.size() + 2) * morph_frame_buffers.size();
+        
+        root["bufferViews"][index]["buffer"] = 0;
+        root["bufferViews"][index]["byteLength"] = MORPH_BYTE_LENGTH;
+        root["bufferViews"][index]["byteOffset"] = getAnimationOffset();
+        
+        // Write all zeros for the first frame.
+        animation_data.insert( animation_data.end(), morph_frame_buffers.size(), 0.0f );
+        
+        for( unsigned frame_index = 0; frame_index < morph_frame_buffers.size(); frame_index++ ) {
             for( unsigned morph_index = 0; morph_index < morph_frame_buffers.size(); morph_index++ ) {
-                binary.write( reinterpret_cast<const char*>( &frame ), sizeof( float ) );
-            }
-            
-            for( unsigned frame_index = 0; frame_index < morph_frame_buffers.size(); frame_index++ ) {
-                for( unsigned morph_index = 0; morph_index < morph_frame_buffers.size(); morph_index++ ) {
-                    
-                    if( frame_index == morph_index )
-                        frame = 1.0f;
-                    else
-                        frame = 0.0f;
-                    
-                    binary.write( reinterpret_cast<const char*>( &frame ), sizeof( float ) );
-                }
+                
+                if( frame_index == morph_index )
+                    animation_data.push_back( 1.0f );
+                else
+                    animation_data.push_back( 0.0f );
             }
+        }
+        
+        // Write all zeros for the first frame.
+        animation_data.insert( animation_data.end(), morph_frame_buffers.size(), 0.0f );
+        
+        index++;
+    }
+    // Skeletal Animation.
+    if( getNumJointFrames() != 0 && this->joint_inverse_frame < getNumJointFrames() ) {
+        bone_buffer_view_index = index;
+        
+        // This is the inverse buffer view.
+        root["bufferViews"][index]["buffer"] = 0;
+        root["bufferViews"][index]["byteLength"] = static_cast<unsigned>(sizeof( float ) * 4 * 4 * getNumJoints());
+        root["bufferViews"][index]["byteOffset"] = getAnimationOffset();
+        root["bufferViews"][index]["name"] = "inverse " + std::to_string( getNumJoints() );
+        
+        // Write down the inverse matrices from the joints.
+        for( unsigned joint_index = 0; joint_index < getNumJoints(); joint_index++ ) {
+            glm::mat4 matrix = getJointFrame( this->joint_inverse_frame, joint_index );
             
-            // Write all zeros for the first frame.
-            frame = 0.0f;
-            for( unsigned morph_index = 0; morph_index < morph_frame_buffers.size(); morph_index++ ) {
-                binary.write( reinterpret_cast<const char*>( &frame ), sizeof( float ) );
-            }
+            matrix = glm::inverse( matrix );
             
-            index++;
+            animation_data.insert( animation_data.end(), &matrix[0][0], &matrix[0][0] + 4 * 4 );
         }
-        // Skeletal Animation.
-        if( getNumJointFrames() != 0 && this->joint_inverse_frame < getNumJointFrames() ) {
-            bone_buffer_view_index = index;
-            
-            // This is the inverse buffer view.
+        index++;
+        
+        // This is the time between frame buffer view.
+        root["bufferViews"][index]["buffer"] = 0;
+        root["bufferViews"][index]["byteLength"] = static_cast<unsigned>(sizeof( float ) * getNumJointFrames());
+        root["bufferViews"][index]["byteOffset"] = getAnimationOffset();
+        root["bufferViews"][index]["name"] = "time";
+        
+        // Write down the time line.
+        for( unsigned joint_frame = 0; joint_frame < this->getNumJointFrames(); joint_frame++ ) {
+            animation_data.push_back( static_cast<float>( joint_frame ) * TIME_SPEED );
+        }
+        index++;
+        
+        // From this point is where the animations start.
+        for( unsigned joint_index = 0; joint_index < getNumJoints(); joint_index++ ) {
             root["bufferViews"][index]["buffer"] = 0;
-            root["bufferViews"][index]["byteLength"] = static_cast<unsigned>(sizeof( float ) * 4 * 4 * getNumJoints());
-            root["bufferViews"][index]["byteOffset"] = static_cast<unsigned>( binary.tellp() );
-            root["bufferViews"][index]["name"] = "inverse " + std::to_string( getNumJoints() );
+            root["bufferViews"][index]["byteLength"] = static_cast<unsigned>( 3 * sizeof( float ) * this->getNumJointFrames());
+            root["bufferViews"][index]["byteOffset"] = getAnimationOffset();
             
-            // Write down the inverse matrices from the joints.
-            for( unsigned joint_index = 0; joint_index < getNumJoints(); joint_index++ ) {
-                glm::mat4 matrix = getJointFrame( this->joint_inverse_frame, joint_index );
-                
-                matrix = glm::inverse( matrix );
-                
-                binary.write( reinterpret_cast<const char*>( &matrix[0][0] ), sizeof( float ) * 4 * 4 );
+            for( unsigned joint_frame = 0; joint_frame < this->getNumJointFrames(); joint_frame++ ) {
+                const glm::vec3 &position = joints.at( joint_index ).position.at( joint_frame );
+
+                animation_data.push_back( position.x );
+                animation_data.push_back( position.y );
+                animation_data.push_back( position.z );
             }
             index++;
             
-            // This is the time between frame buffer view.
             root["bufferViews"][index]["buffer"] = 0;
-            root["bufferViews"][index]["byteLength"] = static_cast<unsigned>(sizeof( float ) * getNumJointFrames());
-            root["bufferViews"][index]["byteOffset"] = static_cast<unsigned>( binary.tellp() );
-            root["bufferViews"][index]["name"] = "time";
-            
-            float frame = 0.0f;
+            root["bufferViews"][index]["byteLength"] = static_cast<unsigned>( 4 * sizeof( float ) * this->getNumJointFrames());
+            root["bufferViews"][index]["byteOffset"] = getAnimationOffset();
             
-            // Write down the time line.
             for( unsigned joint_frame = 0; joint_frame < this->getNumJointFrames(); joint_frame++ ) {
-                frame = static_cast<float>( joint_frame ) * TIME_SPEED;
-                binary.write( reinterpret_cast<const char*>( &frame ), sizeof( float ));
+                const glm::quat &rotation = joints.at( joint_index ).rotation.at( joint_frame );
+
+                animation_data.push_back( rotation.x );
+                animation_data.push_back( rotation.y );
+                animation_data.push_back( rotation.z );
+                animation_data.push_back( rotation.w );
             }
             index++;
-            
-            // From this point is where the animations start.
-            for( unsigned joint_index = 0; joint_index < getNumJoints(); joint_index++ ) {
-                root["bufferViews"][index]["buffer"] = 0;
-                root["bufferViews"][index]["byteLength"] = static_cast<unsigned>( 3 * sizeof( float ) * this->getNumJointFrames());
-                root["bufferViews"][index]["byteOffset"] = static_cast<unsigned>( binary.tellp() );
-                
-                for( unsigned joint_frame = 0; joint_frame < this->getNumJointFrames(); joint_frame++ ) {
-                    binary.write( reinterpret_cast<const char*>( &joints.at( joint_index ).position.at( joint_frame ) ), 3 * sizeof( float ));
-                }
-                index++;
-                
-                root["bufferViews"][index]["buffer"] = 0;
-                root["bufferViews"][index]["byteLength"] = static_cast<unsigned>( 4 * sizeof( float ) * this->getNumJointFrames());
-                root["bufferViews"][index]["byteOffset"] = static_cast<unsigned>( binary.tellp() );
-                
-                for( unsigned joint_frame = 0; joint_frame < this->getNumJointFrames(); joint_frame++ ) {
-                    binary.write( reinterpret_cast<const char*>( &joints.at( joint_index ).rotation.at( joint_frame ).x ), sizeof( float ));
-                    binary.write( reinterpret_cast<const char*>( &joints.at( joint_index ).rotation.at( joint_frame ).y ), sizeof( float ));
-                    binary.write( reinterpret_cast<const char*>( &joints.at( joint_index ).rotation.at( joint_frame ).z ), sizeof( float ));
-                    binary.write( reinterpret_cast<const char*>( &joints.at( joint_index ).rotation.at( joint_frame ).w ), sizeof( float ));
-                }
-                index++;
-            }
         }
-        
-        root["buffers"][0]["byteLength"] = static_cast<unsigned>( binary.tellp() );
-
-        // Then the file is now finished.
-        binary.close();
     }
+    
+    root["buffers"][0]["byteLength"] = getAnimationOffset();
 
 
     unsigned accessors_amount = 0;
@@ -1302,9 +1734,18 @@ bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std
             root["accessors"][accessors_amount]["bufferView"] = vertex_component_index;
             root["accessors"][accessors_amount]["byteOffset"] = static_cast<unsigned>((*i).starting_vertex_index * (*d).stride * sizeof( uint32_t ));
             root["accessors"][accessors_amount]["componentType"] = (*d).component_type;
-            root["accessors"][accessors_amount]["count"] = (*i).count;
+            root["accessors"][accessors_amount]["count"] = (*i).vertex_count;
             root["accessors"][accessors_amount]["type"] = typeToText((*d).type);
 
+            if( (*d).isPosition() && is_quantized )
+            {
+                // The bounds of quantized positions are in the units that are stored.
+                for( unsigned e = 0; e < 3; e++ ) {
+                    root["accessors"][accessors_amount]["min"][e] = quantizeCoordinate( (*i).min.data[ e ], position_scale );
+                    root["accessors"][accessors_amount]["max"][e] = quantizeCoordinate( (*i).max.data[ e ], position_scale );
+                }
+            }
+            else
             if( (*d).isPosition() )
             {
                 (*i).min.writeJSON( root["accessors"][accessors_amount]["min"] );
@@ -1329,7 +1770,7 @@ bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std
                 root["accessors"][accessors_amount]["bufferView"] = vertex_component_index;
                 root["accessors"][accessors_amount]["byteOffset"] = static_cast<unsigned>((*i).starting_vertex_index * (*comp).stride * sizeof( uint32_t ));
                 root["accessors"][accessors_amount]["componentType"] = (*comp).component_type;
-                root["accessors"][accessors_amount]["count"] = (*i).count;
+                root["accessors"][accessors_amount]["count"] = (*i).vertex_count;
                 root["accessors"][accessors_amount]["type"] = typeToText((*comp).type);
                 
                 if( vertex_morph_position_component_index == b ) {
@@ -1345,6 +1786,18 @@ bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std
                 vertex_component_index++;
             }
         }
+
+        if( isWelded() ) {
+            root["meshes"][0]["primitives"][material_index]["indices"] = accessors_amount;
+
+            root["accessors"][accessors_amount]["bufferView"] = index_buffer_view_index;
+            root["accessors"][accessors_amount]["byteOffset"] = static_cast<unsigned>( (*i).starting_index * sizeof( uint32_t ) );
+            root["accessors"][accessors_amount]["componentType"] = Utilities::DataTypes::ComponentType::UNSIGNED_INT;
+            root["accessors"][accessors_amount]["count"] = (*i).count;
+            root["accessors"][accessors_amount]["type"] = "SCALAR";
+
+            accessors_amount++;
+        }
     }
     
     // Add morph animaitons.
@@ -1467,6 +1920,42 @@ bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std
             current_channels++;
         }
     }
+}
+
+bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std::string title ) const {
+    Json::Value root;
+    std::vector<float> animation_data;
+
+    makeGLTF( root, animation_data, title );
+
+    std::filesystem::path binary_location = file_path;
+    binary_location += std::filesystem::path(".bin");
+
+    std::ofstream binary;
+
+    binary.open( binary_location, std::ios::binary | std::ios::out );
+
+    if( binary.is_open() )
+    {
+        binary.write( reinterpret_cast<const char*>( primary_buffer.data() ), sizeof( uint32_t ) * primary_buffer.size() );
+
+        // Write the contents of the buffer to the binary file.
+        for( auto i = morph_frame_buffers.begin(); i != morph_frame_buffers.end(); i++ ) {
+            binary.write( reinterpret_cast<const char*>( (*i).data() ), sizeof( uint32_t ) * (*i).size() );
+        }
+
+        binary.write( reinterpret_cast<const char*>( index_buffer.data() ), sizeof( uint32_t ) * index_buffer.size() );
+
+        binary.write( reinterpret_cast<const char*>( animation_data.data() ), sizeof( float ) * animation_data.size() );
+
+        // Then the file is now finished.
+        binary.close();
+    }
+
+    // Write the primary buffer info to this file as well
+    root["buffers"][0]["uri"] = binary_location.filename().string();
+
+    std::ofstream resource;
 
     std::filesystem::path file_path_gltf = file_path;
     file_path_gltf += std::filesystem::path(".gltf");
@@ -1485,6 +1974,67 @@ bool Utilities::ModelBuilder::write( const std::filesystem::path& file_path, std
         return false;
 }
 
+bool Utilities::ModelBuilder::writeGLB( const std::filesystem::path& file_path, std::string title ) const {
+    // which is { 'g', 'l', 'T', 'F' } or "glTF"
+    const uint32_t GLB_MAGIC = 0x46546C67;
+    const uint32_t GLB_VERSION = 2;
+    // which is { 'J', 'S', 'O', 'N' } or "JSON"
+    const uint32_t JSON_CHUNK_TYPE = 0x4E4F534A;
+    // which is { 'B', 'I', 'N', 0 } or "BIN"
+    const uint32_t BIN_CHUNK_TYPE  = 0x004E4942;
+
+    Json::Value root;
+    std::vector<float> animation_data;
+
+    makeGLTF( root, animation_data, title );
+
+    // The json chunk has to be padded with spaces to be four byte aligned.
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+
+    std::string json_chunk = Json::writeString( builder, root );
+    json_chunk.append( (4 - json_chunk.size() % 4) % 4, ' ' );
+
+    // Every part of the binary chunk is made of four byte values, so it is always aligned.
+    const uint32_t bin_chunk_size = root["buffers"][0]["byteLength"].asUInt();
+
+    const uint32_t header[5] = {
+        GLB_MAGIC,
+        GLB_VERSION,
+        static_cast<uint32_t>( 12 + 8 + json_chunk.size() + 8 + bin_chunk_size ),
+        static_cast<uint32_t>( json_chunk.size() ),
+        JSON_CHUNK_TYPE };
+    const uint32_t bin_chunk_header[2] = { bin_chunk_size, BIN_CHUNK_TYPE };
+
+    std::filesystem::path file_path_glb = file_path;
+    file_path_glb += std::filesystem::path(".glb");
+
+    std::ofstream resource;
+
+    resource.open( file_path_glb, std::ios::binary | std::ios::out );
+
+    if( !resource.is_open() )
+        return false;
+
+    // The buffers are written straight from this model, so nothing needs to be copied.
+    resource.write( reinterpret_cast<const char*>( header ), sizeof( header ) );
+    resource.write( json_chunk.data(), json_chunk.size() );
+    resource.write( reinterpret_cast<const char*>( bin_chunk_header ), sizeof( bin_chunk_header ) );
+    resource.write( reinterpret_cast<const char*>( primary_buffer.data() ), sizeof( uint32_t ) * primary_buffer.size() );
+
+    for( auto i = morph_frame_buffers.begin(); i != morph_frame_buffers.end(); i++ ) {
+        resource.write( reinterpret_cast<const char*>( (*i).data() ), sizeof( uint32_t ) * (*i).size() );
+    }
+
+    resource.write( reinterpret_cast<const char*>( index_buffer.data() ), sizeof( uint32_t ) * index_buffer.size() );
+
+    resource.write( reinterpret_cast<const char*>( animation_data.data() ), sizeof( float ) * animation_data.size() );
+
+    resource.close();
+
+    return resource.good();
+}
+
 void Utilities::ModelBuilder::about( std::ostream &stream ) const {
     stream << "Vertex Amount: " << getNumVertices() << std::endl;
     stream << "Material Amount: " << getNumMaterials() << std::endl;
@@ -1538,6 +2088,20 @@ Utilities::ModelBuilder* Utilities::ModelBuilder::combine( const std::vector<Mod
             }
         }
         
+        // Welded models cannot be combined, since their vertices are not in the order of their primitives.
+        for( auto it = models.begin(); it != models.end(); it++ ) {
+            if( (*it)->isWelded() ) {
+                status = -10;
+                return nullptr;
+            }
+
+            // Every quantized model has its own position scale.
+            if( (*it)->isQuantized() ) {
+                status = -11;
+                return nullptr;
+            }
+        }
+        
         // Check if all the models have the same components.
         for( auto it = models.begin() + 1; it != models.end(); it++ ) {
             // Only one primative mode is aloud.
@@ -1616,24 +2180,17 @@ Utilities::ModelBuilder* Utilities::ModelBuilder::combine( const std::vector<Mod
             
             // Now that the material has been set add the mesh info.
             
-            // This is the destination index for the new model.
-            auto destination_index = (*it)->current_vertex_index + new_model->current_vertex_index;
-            
-            // This is the index for it.
-            size_t it_index = 0;
-            
-            // Finally copy the mesh information.
-            while( destination_index > new_model->current_vertex_index ) {
-                for( int b = 0; b < stride; b++ )
-                {
-                    new_model->primary_buffer[ new_model->current_vertex_index * stride + b ] = (*it)->primary_buffer[ it_index * stride + b ];
-                }
-                new_model->current_vertex_index++;
-                it_index++;
-                
-                // Increment the material
-                new_model->texture_materials.back().count++;
-            }
+            // The vertices are interleaved with the same layout, so the whole vertex range is copied at once.
+            const unsigned it_vertex_amount = (*it)->current_vertex_index;
+
+            if( it_vertex_amount != 0 )
+                std::memcpy( new_model->primary_buffer.data() + static_cast<size_t>( new_model->current_vertex_index ) * stride, (*it)->primary_buffer.data(), sizeof( uint32_t ) * stride * it_vertex_amount );
+
+            new_model->current_vertex_index += it_vertex_amount;
+
+            // Increment the material
+            new_model->texture_materials.back().count        += it_vertex_amount;
+            new_model->texture_materials.back().vertex_count += it_vertex_amount;
 
             if( (*it)->texture_materials.back().addition_index != std::numeric_limits<unsigned>::max() )
                 new_model->texture_materials.back().addition_index = (*it)->texture_materials.back().addition_index;
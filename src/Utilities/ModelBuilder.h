@@ -75,7 +75,9 @@ public:
         uint32_t cbmp_resource_id;
         std::filesystem::path file_name; // The file is relative to the texture.
         unsigned starting_vertex_index; // The index of the starting vertices.
-        unsigned count; // The amount of vertices that the texture material covers.
+        unsigned count; // The amount of vertices that the texture material covers. If the model is welded, then this is the amount of indices.
+        unsigned vertex_count; // The amount of vertices that the texture material has. This is only different from count if the model is welded.
+        unsigned starting_index; // The index of the first index in the index buffer. Only used if the model is welded.
         unsigned addition_index;
         unsigned mix_index;
         Utilities::DataTypes::Vec3Type min, max;
@@ -142,6 +144,9 @@ private:
 
     std::vector<TextureMaterial> texture_materials;
 
+    // If this is not empty then the model is welded. Every index is relative to the starting_vertex_index of its material.
+    std::vector<uint32_t> index_buffer;
+
     unsigned current_vertex_index;
     unsigned vertex_amount;
 
@@ -152,9 +157,19 @@ private:
     unsigned joint_inverse_frame; // This value is greater than the joint_matrix_frames size then it was not set properly.
 
     bool is_model_finished; // This tells if the ModelBuilder should add more vertices.
+    bool is_quantized; // This tells if the positions are shorts that have to be multiplied by position_scale.
+    float position_scale;
     bool components_are_done; // This tells if the ModelBuilder should add more components.
     
     MeshPrimativeMode mesh_primative_mode;
+
+    /**
+     * This makes the glTF json of the model. The binary buffer is the primary_buffer, then every morph_frame_buffers, and then the animation_data.
+     * @param root The json to write to. The uri of the buffer is not set.
+     * @param animation_data This gets the times, morph weights and joint transformations of the binary buffer.
+     * @param title if this is not some empty string then this will give the model a name when exported.
+     */
+    void makeGLTF( Json::Value &root, std::vector<float> &animation_data, const std::string &title ) const;
 public:
     ModelBuilder( MeshPrimativeMode mode = MeshPrimativeMode::TRIANGLES );
     ModelBuilder( const ModelBuilder& to_copy );
@@ -385,6 +400,56 @@ public:
      */
     bool finish();
     
+    /**
+     * This finds the vertices of each material that are exactly the same including their morph frames, without changing the model.
+     * @note weld() uses this, so a renderer could weld its own copy of the vertices while the model stays in the order of its primitives.
+     * @param unique_vertices This gets the vertex that every welded vertex comes from in increasing order. The welded vertices of a material are next to each other.
+     * @param indices This gets the welded vertex of every vertex of the materials, in the order of the materials. Unlike the index buffer, these are not relative to the material.
+     * @return false if setupVertexComponents was not called, there are no vertices, or the model is already welded.
+     */
+    bool getWeldMapping( std::vector<uint32_t> &unique_vertices, std::vector<uint32_t> &indices ) const;
+
+    /**
+     * This welds the vertices of each material that are exactly the same including their morph frames, and makes an index buffer for them.
+     * After this, the count of every material is the amount of indices, and vertex_count is the amount of unique vertices.
+     * @note The order of the primitives is kept, so addition_index and mix_index still work. This also finishes the model.
+     * @warning A welded model cannot be combined.
+     * @return true if the model got welded, or false if setupVertexComponents was not called, there are no vertices, or the model is already welded.
+     */
+    bool weld();
+
+    /**
+     * @return true if weld had been called successfully on this model.
+     */
+    bool isWelded() const { return !index_buffer.empty(); }
+
+    /**
+     * @return The index buffer. Every index is relative to the starting_vertex_index of its material. It is empty if the model is not welded.
+     */
+    const std::vector<uint32_t>& getIndexBuffer() const { return index_buffer; }
+
+    /**
+     * This converts the vertices into the compact layout of the KHR_mesh_quantization glTF extension.
+     * Positions become shorts with one scale for the whole model, normals become normalized bytes, and colors become normalized unsigned bytes.
+     * Float texture coordinates become normalized unsigned shorts if every one of them is inside [0, 1].
+     * The other components are kept as they are.
+     * @note Normals stay three bytes instead of an octahedral pair, since KHR_mesh_quantization only allows VEC3 normals.
+     * @note getTransformation and getAttributes still give the positions in model space.
+     * @warning A quantized model cannot be combined.
+     * @return true if the model got quantized, or false if the model is not finished, is already quantized, has morph frames or joints, or has no float position.
+     */
+    bool quantize();
+
+    /**
+     * @return true if quantize had been called successfully on this model.
+     */
+    bool isQuantized() const { return is_quantized; }
+
+    /**
+     * @return The scale that turns the stored positions into model space. It is one if the model is not quantized.
+     */
+    float getPositionScale() const { return position_scale; }
+
     /**
      * This method is specialized for exporting bone animations.
      * This method transforms the position and normal vertices by the matrix.
@@ -414,6 +479,34 @@ public:
      */
     int getTransformation( glm::vec4& attributes, unsigned morph_vertex_component_index, unsigned vertex_index, unsigned frame_index ) const;
 
+    /**
+     * This reads a vertex component of a range of vertices into one array.
+     * Unlike getTransformation, the component is only looked up once, and the loop over the vertices is specialized for the component type.
+     * @note This is only defined for glm::vec2, glm::vec3, glm::vec4, glm::u8vec4 and glm::i16vec2. Floating point values are converted like getTransformation. Integer values are not normalized.
+     * @param attributes This gets resized to vertex_amount, and filled with default_value before the component is read.
+     * @param vertex_component_index This indicates gets the vertex component (positions, uv, colors, etc).
+     * @param first_vertex The index of the first vertex to read.
+     * @param vertex_amount The amount of vertices to read.
+     * @param default_value The value for the elements that the vertex component does not have.
+     * @return false if the vertex component does not exist or the range goes past the vertices. Then attributes only has default_value.
+     */
+    template<class T>
+    bool getAttributes( std::vector<T> &attributes, unsigned vertex_component_index, unsigned first_vertex, unsigned vertex_amount, const T &default_value = T( 0 ) ) const;
+
+    /**
+     * This reads a morph vertex component of a range of vertices into one array.
+     * @note This is only defined for the same types as getAttributes.
+     * @param attributes This gets resized to vertex_amount, and filled with default_value before the component is read.
+     * @param morph_vertex_component_index The index to the morph vertex component.
+     * @param frame_index The index of the morph frame.
+     * @param first_vertex The index of the first vertex to read.
+     * @param vertex_amount The amount of vertices to read.
+     * @param default_value The value for the elements that the vertex component does not have.
+     * @return false if the morph vertex component or the frame does not exist, or the range goes past the vertices.
+     */
+    template<class T>
+    bool getMorphAttributes( std::vector<T> &attributes, unsigned morph_vertex_component_index, unsigned frame_index, unsigned first_vertex, unsigned vertex_amount, const T &default_value = T( 0 ) ) const;
+
     /**
      * This writes a glTF file.
      * @param file_path this holds the path to where it is going to write to.
@@ -421,6 +514,15 @@ public:
      * @return true if the model is successfully written to the hard drive.
      */
     bool write( const std::filesystem::path& file_path, std::string title = "" ) const;
+
+    /**
+     * This writes a binary glTF file, where the json and the buffers are in one file.
+     * @note The buffers are written straight from this class without being copied.
+     * @param file_path this holds the path to where it is going to write to. The ".glb" extension is added to it.
+     * @param title if this is not some empty string then this will give the model a name when exported.
+     * @return true if the model is successfully written to the hard drive.
+     */
+    bool writeGLB( const std::filesystem::path& file_path, std::string title = "" ) const;
     
     /**
      * Display the number of vertices, vertex types, morph types, and what not.
@@ -430,7 +532,7 @@ public:
     
     /**
      * This is the combine function to create a model with all of the vertices.
-     * @param models must be a size of two in order for this program to work.
+     * @param models must be a size of two in order for this program to work. None of them can be welded.
      * @return a pointer to a valid ModelBuilder, or nullptr if it has an error.
      */
     static ModelBuilder* combine( const std::vector<ModelBuilder*>& models, int & status );
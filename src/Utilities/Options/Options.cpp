@@ -5,10 +5,12 @@ const std::string VIDEO = "video";
 const std::string VIDEO_WIDTH      = "width";
 const std::string VIDEO_HEIGHT     = "height";
 const std::string VIDEO_FULLSCREEN = "fullscreen";
+const std::string VIDEO_QUANTIZE_WORLD = "quantize_world";
 
 const std::string DATA = "data";
 const std::string DATA_LOAD_ALL_MAPS = "load_all_maps";
 const std::string DATA_PLATFORM      = "current_platform";
+const std::string DATA_INDEX_CACHE   = "use_index_cache";
 
 const std::string DIRECTORIES = "directories";
 const std::string DIRECTORIES_SAVES       = "user_saved_games";
@@ -36,6 +38,7 @@ Options::Options (Paths& paths, Parameters& parameters) : paths(paths), paramete
     changed |= init( VIDEO, VIDEO_WIDTH,      "800" );
     changed |= init( VIDEO, VIDEO_HEIGHT,     "600" );
     changed |= init( VIDEO, VIDEO_FULLSCREEN, "false" );
+    changed |= init( VIDEO, VIDEO_QUANTIZE_WORLD, "false" ); // Stores the map vertices in a compact layout to save video memory. Set to false by default.
 
     changed |= init( DIRECTORIES, DIRECTORIES_SAVES,       paths.getUserDirPath( Paths::SAVED_GAMES ).string());
     changed |= init( DIRECTORIES, DIRECTORIES_SCREENSHOTS, paths.getUserDirPath( Paths::SCREENSHOTS ).string());
@@ -46,6 +49,7 @@ Options::Options (Paths& paths, Parameters& parameters) : paths(paths), paramete
 
     changed |= init( DATA, DATA_PLATFORM, "windows" );
     changed |= init( DATA, DATA_LOAD_ALL_MAPS, "false" ); // Loads all maps from storage memory to Random Access Memory. Set to false by default.
+    changed |= init( DATA, DATA_INDEX_CACHE,   "false" ); // Writes an index file next to every map file, so the next load skips the chunk scan. Set to false by default.
 
     if(changed) {
         saveOptions();
@@ -77,6 +81,11 @@ bool Options::getLoadAllMaps() {
 }
 void Options::setLoadAllMaps(bool load_all_maps) { setBool(DATA, DATA_LOAD_ALL_MAPS, load_all_maps); this->modified.insert( DATA + DATA_LOAD_ALL_MAPS ); }
 
+bool Options::getUseIndexCache() {
+    return getBool( DATA, DATA_INDEX_CACHE );
+}
+void Options::setUseIndexCache(bool use_index_cache) { setBool(DATA, DATA_INDEX_CACHE, use_index_cache); }
+
 int Options::getVideoWidth() {
     if( this->modified.count( VIDEO + VIDEO_WIDTH ) == 1 )
         return getInt( VIDEO, VIDEO_WIDTH);
@@ -107,6 +116,11 @@ bool Options::getVideoFullscreen() {
 }
 void Options::setVideoFullscreen(bool value) { setBool(VIDEO, VIDEO_FULLSCREEN, value); this->modified.insert( VIDEO + VIDEO_FULLSCREEN ); }
 
+bool Options::getVideoQuantizeWorld() {
+    return getBool( VIDEO, VIDEO_QUANTIZE_WORLD );
+}
+void Options::setVideoQuantizeWorld(bool value) { setBool(VIDEO, VIDEO_QUANTIZE_WORLD, value); }
+
 std::filesystem::path Options::getSaveDirectory() {
     return getPath( DIRECTORIES, DIRECTORIES_SAVES);
 }
@@ -31,6 +31,9 @@ public:
     bool getLoadAllMaps();
     void setLoadAllMaps(bool load_all_maps);
 
+    bool getUseIndexCache();
+    void setUseIndexCache(bool use_index_cache);
+
     int getVideoWidth();
     void setVideoWidth(int value);
 
@@ -40,6 +43,9 @@ public:
     bool getVideoFullscreen();
     void setVideoFullscreen(bool value);
 
+    bool getVideoQuantizeWorld();
+    void setVideoQuantizeWorld(bool value);
+
     std::filesystem::path getSaveDirectory();
     void setSaveDirectory( std::filesystem::path value );
 
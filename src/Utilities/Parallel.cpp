@@ -0,0 +1,66 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+unsigned Utilities::Parallel::getThreadAmount( unsigned requested_amount ) {
+    if( requested_amount != 0 )
+        return requested_amount;
+
+    // hardware_concurrency is allowed to return zero if it does not know.
+    return std::max( 1u, std::thread::hardware_concurrency() );
+}
+
+void Utilities::Parallel::forEach( size_t task_amount, unsigned thread_amount, const std::function<void( size_t )> &task ) {
+    if( task_amount == 0 )
+        return;
+
+    const size_t worker_amount = std::min( static_cast<size_t>( getThreadAmount( thread_amount ) ), task_amount );
+
+    if( worker_amount == 1 ) {
+        for( size_t i = 0; i < task_amount; i++ )
+            task( i );
+        return;
+    }
+
+    std::atomic<size_t> next_index( 0 );
+    std::atomic<bool> stop( false );
+    std::mutex exception_lock;
+    std::exception_ptr first_exception;
+
+    auto work = [&]() {
+        size_t index;
+
+        while( !stop.load( std::memory_order_relaxed ) && ( index = next_index.fetch_add( 1 ) ) < task_amount ) {
+            try {
+                task( index );
+            }
+            catch( ... ) {
+                std::lock_guard<std::mutex> guard( exception_lock );
+
+                if( first_exception == nullptr )
+                    first_exception = std::current_exception();
+
+                stop = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve( worker_amount - 1 );
+
+    for( size_t i = 1; i < worker_amount; i++ )
+        threads.push_back( std::thread( work ) );
+
+    work();
+
+    for( auto &thread : threads )
+        thread.join();
+
+    if( first_exception != nullptr )
+        std::rethrow_exception( first_exception );
+}
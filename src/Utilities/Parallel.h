@@ -0,0 +1,35 @@
+#ifndef UTILITIES_PARALLEL_H
+#define UTILITIES_PARALLEL_H
+
+#include <functional>
+#include <stddef.h>
+
+namespace Utilities {
+
+/**
+ * This class runs independent tasks on multiple threads.
+ *
+ * The tasks are handed out one at a time, so a few slow tasks would not stall the other threads.
+ */
+class Parallel {
+public:
+    /**
+     * @param requested_amount The amount of threads wanted. Zero means every hardware thread.
+     * @return The amount of threads to use, which is never zero.
+     */
+    static unsigned getThreadAmount( unsigned requested_amount );
+
+    /**
+     * This calls task for every index from zero to task_amount - 1 and waits for all of them to finish.
+     * @note The calling thread also runs tasks, so a thread_amount of one runs everything in order on the calling thread.
+     * @note If any task throws an exception, the remaining tasks are skipped and the first exception is thrown again from this method.
+     * @param task_amount The amount of tasks to run.
+     * @param thread_amount The maximum amount of threads to use. Zero means every hardware thread.
+     * @param task The function that does the work of one index. It must be safe to call from multiple threads.
+     */
+    static void forEach( size_t task_amount, unsigned thread_amount, const std::function<void( size_t )> &task );
+};
+
+}
+
+#endif // UTILITIES_PARALLEL_H
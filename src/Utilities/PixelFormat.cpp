@@ -2,6 +2,16 @@
 
 #include <cmath>
 #include <cassert>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PIXEL_FORMAT_USE_SSE2
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define PIXEL_FORMAT_USE_NEON
+#endif
 
 namespace {
 
@@ -38,6 +48,422 @@ COLOR_CONVERSION_FUNCTIONS(MAX_UBYTE_VALUE, MAX_UBYTE_sRGB_VALUE, internalFromGe
 
 // The color function declarations are no longer needed.
 #undef COLOR_CONVERSION_FUNCTIONS
+
+// These are the channels of a pixel before they get packed. The 5-bit channels use the lower 5 bits.
+struct RawPixel {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    uint8_t alpha;
+};
+
+inline uint16_t loadWord( const uint8_t *bytes_r, bool swap ) {
+    uint16_t word;
+
+    std::memcpy( &word, bytes_r, sizeof( word ) );
+
+    if( swap )
+        word = (word >> 8) | (word << 8);
+
+    return word;
+}
+
+inline void storeWord( uint8_t *bytes_r, bool swap, uint16_t word ) {
+    if( swap )
+        word = (word >> 8) | (word << 8);
+
+    std::memcpy( bytes_r, &word, sizeof( word ) );
+}
+
+// Every pixel format has a struct that unpacks and packs its pixels for the kernels of the PixelFormatConverter.
+// COLOR_AMOUNT and ALPHA_AMOUNT are the amount of values that the color channels and the alpha can have.
+struct RawW8 {
+    static constexpr unsigned BYTE_SIZE = 1, COLOR_AMOUNT = 256, ALPHA_AMOUNT = 1, OPAQUE_ALPHA = 0;
+    static constexpr bool IS_LOSSLESS = true;
+
+    static RawPixel load( const uint8_t *bytes_r, bool /*swap*/ ) { return { bytes_r[0], bytes_r[0], bytes_r[0], 0 }; }
+    static void store( uint8_t *bytes_r, bool /*swap*/, RawPixel pixel ) { bytes_r[0] = pixel.red; }
+};
+
+struct RawW8A8 {
+    static constexpr unsigned BYTE_SIZE = 2, COLOR_AMOUNT = 256, ALPHA_AMOUNT = 256, OPAQUE_ALPHA = 255;
+    static constexpr bool IS_LOSSLESS = true;
+
+    static RawPixel load( const uint8_t *bytes_r, bool /*swap*/ ) { return { bytes_r[0], bytes_r[0], bytes_r[0], bytes_r[1] }; }
+    static void store( uint8_t *bytes_r, bool /*swap*/, RawPixel pixel ) {
+        bytes_r[0] = pixel.red;
+        bytes_r[1] = pixel.alpha;
+    }
+};
+
+struct RawR8G8B8 {
+    static constexpr unsigned BYTE_SIZE = 3, COLOR_AMOUNT = 256, ALPHA_AMOUNT = 1, OPAQUE_ALPHA = 0;
+    static constexpr bool IS_LOSSLESS = true;
+
+    static RawPixel load( const uint8_t *bytes_r, bool /*swap*/ ) { return { bytes_r[0], bytes_r[1], bytes_r[2], 0 }; }
+    static void store( uint8_t *bytes_r, bool /*swap*/, RawPixel pixel ) {
+        bytes_r[0] = pixel.red;
+        bytes_r[1] = pixel.green;
+        bytes_r[2] = pixel.blue;
+    }
+};
+
+struct RawR8G8B8A8 {
+    static constexpr unsigned BYTE_SIZE = 4, COLOR_AMOUNT = 256, ALPHA_AMOUNT = 256, OPAQUE_ALPHA = 255;
+    static constexpr bool IS_LOSSLESS = true;
+
+    static RawPixel load( const uint8_t *bytes_r, bool /*swap*/ ) { return { bytes_r[0], bytes_r[1], bytes_r[2], bytes_r[3] }; }
+    static void store( uint8_t *bytes_r, bool /*swap*/, RawPixel pixel ) {
+        bytes_r[0] = pixel.red;
+        bytes_r[1] = pixel.green;
+        bytes_r[2] = pixel.blue;
+        bytes_r[3] = pixel.alpha;
+    }
+};
+
+// The 16-bit formats only differ by the places of red and blue, and by the meaning of the top bit.
+// A semi-transparent format uses the alpha values 0 for opaque, 1 for semi-transparent and 2 for the clear pixel, which has no color.
+template<unsigned RED_SHIFT, unsigned BLUE_SHIFT, bool IS_SEMI_TRANSPARENT>
+struct RawWord {
+    static constexpr unsigned BYTE_SIZE = 2, COLOR_AMOUNT = 32, ALPHA_AMOUNT = IS_SEMI_TRANSPARENT ? 3 : 2, OPAQUE_ALPHA = IS_SEMI_TRANSPARENT ? 0 : 1;
+    static constexpr bool IS_LOSSLESS = !IS_SEMI_TRANSPARENT;
+    static constexpr uint8_t CLEAR_ALPHA = 2;
+
+    static RawPixel load( const uint8_t *bytes_r, bool swap ) {
+        const uint16_t word = loadWord( bytes_r, swap );
+        RawPixel pixel;
+
+        pixel.red   = (word >> RED_SHIFT)  & 0x1F;
+        pixel.green = (word >> 5)          & 0x1F;
+        pixel.blue  = (word >> BLUE_SHIFT) & 0x1F;
+        pixel.alpha = (word >> 15);
+
+        if( IS_SEMI_TRANSPARENT && (word & 0x7FFF) == 0 )
+            pixel.alpha = CLEAR_ALPHA;
+
+        return pixel;
+    }
+    static void store( uint8_t *bytes_r, bool swap, RawPixel pixel ) {
+        uint16_t word;
+
+        if( IS_SEMI_TRANSPARENT && pixel.alpha == CLEAR_ALPHA )
+            word = 0x8000;
+        else
+            word = (pixel.alpha << 15) | (pixel.red << RED_SHIFT) | (pixel.green << 5) | (pixel.blue << BLUE_SHIFT);
+
+        storeWord( bytes_r, swap, word );
+    }
+};
+
+typedef RawWord<10, 0, false> RawR5G5B5A1;
+typedef RawWord<0, 10, false> RawB5G5R5A1;
+typedef RawWord<10, 0, true>  RawR5G5B5T1;
+typedef RawWord<0, 10, true>  RawB5G5R5T1;
+
+template<class S, class D>
+void convertPixels( const Utilities::PixelFormatConverter::Tables &tables, const uint8_t *source_r, bool source_swap, uint8_t *destination_r, bool destination_swap, size_t pixel_amount ) {
+    for( size_t i = 0; i < pixel_amount; i++ ) {
+        RawPixel pixel = S::load( source_r, source_swap );
+
+        pixel.red   = tables.color[ pixel.red ];
+        pixel.green = tables.color[ pixel.green ];
+        pixel.blue  = tables.color[ pixel.blue ];
+        pixel.alpha = tables.alpha[ pixel.alpha ];
+
+        D::store( destination_r, destination_swap, pixel );
+
+        source_r      += S::BYTE_SIZE;
+        destination_r += D::BYTE_SIZE;
+    }
+}
+
+// This expands a 5-bit channel to an 8-bit channel with rounding, which is what the tables between the linear formats hold.
+inline uint8_t expandChannel5( uint8_t value ) {
+    return (value * 527 + 23) >> 6;
+}
+
+// The 16-bit formats to R8G8B8A8 is how every texture of the game gets loaded. This kernel computes the color channels
+// with expandChannel5 instead of looking them up, so the vector instructions can convert 8 pixels at a time.
+template<unsigned RED_SHIFT, unsigned BLUE_SHIFT, bool IS_SEMI_TRANSPARENT>
+void convertWordsToR8G8B8A8( const Utilities::PixelFormatConverter::Tables &tables, const uint8_t *source_r, bool source_swap, uint8_t *destination_r, bool destination_swap, size_t pixel_amount ) {
+    typedef RawWord<RED_SHIFT, BLUE_SHIFT, IS_SEMI_TRANSPARENT> Source;
+
+    size_t i = 0;
+
+#if defined(PIXEL_FORMAT_USE_SSE2)
+    const __m128i CHANNEL_MASK = _mm_set1_epi16( 0x1F );
+    const __m128i COLOR_MASK   = _mm_set1_epi16( 0x7FFF );
+    const __m128i MULTIPLIER   = _mm_set1_epi16( 527 );
+    const __m128i ROUNDING     = _mm_set1_epi16( 23 );
+    // The alpha goes to the high byte of the blue and alpha pair.
+    const __m128i ALPHA_CLEAR  = _mm_set1_epi16( tables.alpha[ Source::CLEAR_ALPHA ] << 8 );
+    const __m128i ALPHA_UNSET  = _mm_set1_epi16( tables.alpha[ 0 ] << 8 );
+    const __m128i ALPHA_SET    = _mm_set1_epi16( tables.alpha[ 1 ] << 8 );
+
+    for( ; i + 8 <= pixel_amount; i += 8 ) {
+        __m128i words = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source_r + 2 * i ) );
+
+        if( source_swap )
+            words = _mm_or_si128( _mm_slli_epi16( words, 8 ), _mm_srli_epi16( words, 8 ) );
+
+        const __m128i red   = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi16( words, RED_SHIFT ),  CHANNEL_MASK ), MULTIPLIER ), ROUNDING ), 6 );
+        const __m128i green = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi16( words, 5 ),          CHANNEL_MASK ), MULTIPLIER ), ROUNDING ), 6 );
+        const __m128i blue  = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi16( words, BLUE_SHIFT ), CHANNEL_MASK ), MULTIPLIER ), ROUNDING ), 6 );
+
+        const __m128i is_set = _mm_srai_epi16( words, 15 );
+        __m128i alpha = _mm_or_si128( _mm_and_si128( is_set, ALPHA_SET ), _mm_andnot_si128( is_set, ALPHA_UNSET ) );
+
+        if( IS_SEMI_TRANSPARENT ) {
+            const __m128i is_clear = _mm_cmpeq_epi16( _mm_and_si128( words, COLOR_MASK ), _mm_setzero_si128() );
+
+            alpha = _mm_or_si128( _mm_and_si128( is_clear, ALPHA_CLEAR ), _mm_andnot_si128( is_clear, alpha ) );
+        }
+
+        const __m128i red_green  = _mm_or_si128( red, _mm_slli_epi16( green, 8 ) );
+        const __m128i blue_alpha = _mm_or_si128( blue, alpha );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( destination_r + 4 * i +  0 ), _mm_unpacklo_epi16( red_green, blue_alpha ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( destination_r + 4 * i + 16 ), _mm_unpackhi_epi16( red_green, blue_alpha ) );
+    }
+#elif defined(PIXEL_FORMAT_USE_NEON)
+    const uint16x8_t CHANNEL_MASK = vdupq_n_u16( 0x1F );
+    const uint16x8_t COLOR_MASK   = vdupq_n_u16( 0x7FFF );
+    const uint16x8_t ROUNDING     = vdupq_n_u16( 23 );
+    const uint16x8_t ALPHA_CLEAR  = vdupq_n_u16( tables.alpha[ Source::CLEAR_ALPHA ] );
+    const uint16x8_t ALPHA_UNSET  = vdupq_n_u16( tables.alpha[ 0 ] );
+    const uint16x8_t ALPHA_SET    = vdupq_n_u16( tables.alpha[ 1 ] );
+    // vshrq_n_u16 does not take a zero, so the red and blue shifts are left shifts by a negative amount.
+    const int16x8_t RED_SHIFT_RIGHT  = vdupq_n_s16( -static_cast<int16_t>( RED_SHIFT ) );
+    const int16x8_t BLUE_SHIFT_RIGHT = vdupq_n_s16( -static_cast<int16_t>( BLUE_SHIFT ) );
+
+    for( ; i + 8 <= pixel_amount; i += 8 ) {
+        uint8x16_t bytes = vld1q_u8( source_r + 2 * i );
+
+        if( source_swap )
+            bytes = vrev16q_u8( bytes );
+
+        const uint16x8_t words = vreinterpretq_u16_u8( bytes );
+
+        const uint16x8_t red   = vshrq_n_u16( vmlaq_n_u16( ROUNDING, vandq_u16( vshlq_u16( words, RED_SHIFT_RIGHT ),  CHANNEL_MASK ), 527 ), 6 );
+        const uint16x8_t green = vshrq_n_u16( vmlaq_n_u16( ROUNDING, vandq_u16( vshrq_n_u16( words, 5 ),             CHANNEL_MASK ), 527 ), 6 );
+        const uint16x8_t blue  = vshrq_n_u16( vmlaq_n_u16( ROUNDING, vandq_u16( vshlq_u16( words, BLUE_SHIFT_RIGHT ), CHANNEL_MASK ), 527 ), 6 );
+
+        const uint16x8_t is_set = vreinterpretq_u16_s16( vshrq_n_s16( vreinterpretq_s16_u16( words ), 15 ) );
+        uint16x8_t alpha = vbslq_u16( is_set, ALPHA_SET, ALPHA_UNSET );
+
+        if( IS_SEMI_TRANSPARENT )
+            alpha = vbslq_u16( vceqq_u16( vandq_u16( words, COLOR_MASK ), vdupq_n_u16( 0 ) ), ALPHA_CLEAR, alpha );
+
+        uint8x8x4_t pixels;
+
+        pixels.val[0] = vmovn_u16( red );
+        pixels.val[1] = vmovn_u16( green );
+        pixels.val[2] = vmovn_u16( blue );
+        pixels.val[3] = vmovn_u16( alpha );
+
+        vst4_u8( destination_r + 4 * i, pixels );
+    }
+#endif
+
+    for( ; i < pixel_amount; i++ ) {
+        RawPixel pixel = Source::load( source_r + 2 * i, source_swap );
+
+        pixel.red   = expandChannel5( pixel.red );
+        pixel.green = expandChannel5( pixel.green );
+        pixel.blue  = expandChannel5( pixel.blue );
+        pixel.alpha = tables.alpha[ pixel.alpha ];
+
+        RawR8G8B8A8::store( destination_r + 4 * i, destination_swap, pixel );
+    }
+}
+
+// R8G8B8 to R8G8B8A8 with the same color interpolation only adds the alpha, so the vector instructions can do 4 pixels at a time.
+void convertR8G8B8ToR8G8B8A8( const Utilities::PixelFormatConverter::Tables &tables, const uint8_t *source_r, bool source_swap, uint8_t *destination_r, bool destination_swap, size_t pixel_amount ) {
+    size_t i = 0;
+
+#if defined(PIXEL_FORMAT_USE_SSE2)
+    const __m128i COLOR_MASK = _mm_set1_epi32( 0x00FFFFFF );
+    const __m128i ALPHA      = _mm_set1_epi32( static_cast<int>( static_cast<uint32_t>( tables.alpha[ 0 ] ) << 24 ) );
+
+    // 16 bytes are loaded for the 12 bytes of 4 pixels, so two more pixels must be in the source.
+    for( ; i + 6 <= pixel_amount; i += 4 ) {
+        const __m128i bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source_r + 3 * i ) );
+
+        // Each pixel is moved to the bottom of the register, and its first 4 bytes are gathered.
+        const __m128i first  = _mm_unpacklo_epi32( bytes, _mm_srli_si128( bytes, 3 ) );
+        const __m128i second = _mm_unpacklo_epi32( _mm_srli_si128( bytes, 6 ), _mm_srli_si128( bytes, 9 ) );
+        const __m128i pixels = _mm_unpacklo_epi64( first, second );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( destination_r + 4 * i ), _mm_or_si128( _mm_and_si128( pixels, COLOR_MASK ), ALPHA ) );
+    }
+#elif defined(PIXEL_FORMAT_USE_NEON)
+    for( ; i + 16 <= pixel_amount; i += 16 ) {
+        const uint8x16x3_t colors = vld3q_u8( source_r + 3 * i );
+        uint8x16x4_t pixels;
+
+        pixels.val[0] = colors.val[0];
+        pixels.val[1] = colors.val[1];
+        pixels.val[2] = colors.val[2];
+        pixels.val[3] = vdupq_n_u8( tables.alpha[ 0 ] );
+
+        vst4q_u8( destination_r + 4 * i, pixels );
+    }
+#endif
+
+    convertPixels<RawR8G8B8, RawR8G8B8A8>( tables, source_r + 3 * i, source_swap, destination_r + 4 * i, destination_swap, pixel_amount - i );
+}
+
+// Most pairs only have the table kernel. The pairs with a faster kernel use it when their tables allow it.
+template<class S, class D>
+struct KernelChooser {
+    static Utilities::PixelFormatConverter::Kernel choose( const Utilities::PixelFormatConverter::Tables & ) { return convertPixels<S, D>; }
+};
+
+template<unsigned RED_SHIFT, unsigned BLUE_SHIFT, bool IS_SEMI_TRANSPARENT>
+struct KernelChooser<RawWord<RED_SHIFT, BLUE_SHIFT, IS_SEMI_TRANSPARENT>, RawR8G8B8A8> {
+    static Utilities::PixelFormatConverter::Kernel choose( const Utilities::PixelFormatConverter::Tables &tables ) {
+        for( unsigned c = 0; c < 32; c++ ) {
+            if( tables.color[ c ] != expandChannel5( c ) )
+                return convertPixels<RawWord<RED_SHIFT, BLUE_SHIFT, IS_SEMI_TRANSPARENT>, RawR8G8B8A8>;
+        }
+        return convertWordsToR8G8B8A8<RED_SHIFT, BLUE_SHIFT, IS_SEMI_TRANSPARENT>;
+    }
+};
+
+template<>
+struct KernelChooser<RawR8G8B8, RawR8G8B8A8> {
+    static Utilities::PixelFormatConverter::Kernel choose( const Utilities::PixelFormatConverter::Tables &tables ) {
+        for( unsigned c = 0; c < 256; c++ ) {
+            if( tables.color[ c ] != c )
+                return convertPixels<RawR8G8B8, RawR8G8B8A8>;
+        }
+        return convertR8G8B8ToR8G8B8A8;
+    }
+};
+
+template<class S, class D>
+uint8_t convertThroughGeneric( const Utilities::PixelFormatColor &source, const Utilities::PixelFormatColor &destination, RawPixel pixel, bool is_alpha ) {
+    uint8_t source_bytes[ S::BYTE_SIZE ];
+    uint8_t destination_bytes[ D::BYTE_SIZE ];
+
+    S::store( source_bytes, false, pixel );
+
+    Utilities::Buffer::Reader reader( source_bytes, S::BYTE_SIZE );
+    Utilities::PixelFormatColor::GenericColor generic = source.readPixel( reader );
+
+    // The color channels are converted as opaque, because the semi-transparent formats clear the color of invisible pixels.
+    if( !is_alpha )
+        generic.alpha = 1.0;
+
+    Utilities::Buffer::Writer writer( destination_bytes, D::BYTE_SIZE );
+    destination.writePixel( writer, Utilities::Buffer::Endian::NO_SWAP, generic );
+
+    const RawPixel result = D::load( destination_bytes, false );
+
+    if( is_alpha )
+        return result.alpha;
+    else
+        return result.red;
+}
+
+template<class S, class D>
+Utilities::PixelFormatConverter makeConverter( const Utilities::PixelFormatColor &source, const Utilities::PixelFormatColor &destination ) {
+    Utilities::PixelFormatConverter::Tables tables;
+
+    std::memset( &tables, 0, sizeof( tables ) );
+
+    tables.is_copy = std::is_same<S, D>::value && S::IS_LOSSLESS;
+
+    for( unsigned c = 0; c < S::COLOR_AMOUNT; c++ ) {
+        const RawPixel pixel = { static_cast<uint8_t>( c ), static_cast<uint8_t>( c ), static_cast<uint8_t>( c ), S::OPAQUE_ALPHA };
+
+        tables.color[ c ] = convertThroughGeneric<S, D>( source, destination, pixel, false );
+        tables.is_copy &= (tables.color[ c ] == c);
+    }
+
+    for( unsigned a = 0; a < S::ALPHA_AMOUNT; a++ ) {
+        const uint8_t BRIGHTEST = S::COLOR_AMOUNT - 1;
+        const RawPixel pixel = { BRIGHTEST, BRIGHTEST, BRIGHTEST, static_cast<uint8_t>( a ) };
+
+        tables.alpha[ a ] = convertThroughGeneric<S, D>( source, destination, pixel, true );
+        tables.is_copy &= (tables.alpha[ a ] == a);
+    }
+
+    return Utilities::PixelFormatConverter( KernelChooser<S, D>::choose( tables ), tables, S::BYTE_SIZE );
+}
+
+typedef Utilities::PixelFormatConverter (*ConverterMaker)( const Utilities::PixelFormatColor &source, const Utilities::PixelFormatColor &destination );
+
+const unsigned FORMAT_TYPE_AMOUNT = 8;
+
+#define CONVERTER_MAKER_ROW(S) { \
+    makeConverter<S, RawW8>, makeConverter<S, RawW8A8>, \
+    makeConverter<S, RawR5G5B5A1>, makeConverter<S, RawB5G5R5A1>, \
+    makeConverter<S, RawR5G5B5T1>, makeConverter<S, RawB5G5R5T1>, \
+    makeConverter<S, RawR8G8B8>, makeConverter<S, RawR8G8B8A8> }
+
+// The rows are the source formats and the columns are the destination formats in the same order.
+const ConverterMaker CONVERTER_MAKERS[ FORMAT_TYPE_AMOUNT ][ FORMAT_TYPE_AMOUNT ] = {
+    CONVERTER_MAKER_ROW(RawW8),
+    CONVERTER_MAKER_ROW(RawW8A8),
+    CONVERTER_MAKER_ROW(RawR5G5B5A1),
+    CONVERTER_MAKER_ROW(RawB5G5R5A1),
+    CONVERTER_MAKER_ROW(RawR5G5B5T1),
+    CONVERTER_MAKER_ROW(RawB5G5R5T1),
+    CONVERTER_MAKER_ROW(RawR8G8B8),
+    CONVERTER_MAKER_ROW(RawR8G8B8A8)
+};
+
+#undef CONVERTER_MAKER_ROW
+
+class ConverterRegistry {
+private:
+    static constexpr unsigned FORMAT_AMOUNT = 2 * FORMAT_TYPE_AMOUNT;
+
+    const Utilities::PixelFormatColor *formats[ FORMAT_AMOUNT ];
+    Utilities::PixelFormatConverter converters[ FORMAT_AMOUNT ][ FORMAT_AMOUNT ];
+
+    int getFormatIndex( const Utilities::PixelFormatColor &format ) const {
+        for( unsigned i = 0; i < FORMAT_AMOUNT; i++ ) {
+            if( formats[ i ] == &format )
+                return i;
+        }
+        return -1;
+    }
+
+public:
+    ConverterRegistry() {
+        // The linear and the sRGB format of a type are next to each other, so the type is the index divided by two.
+        const Utilities::PixelFormatColor *const FORMATS[ FORMAT_AMOUNT ] = {
+            &Utilities::PixelFormatColor_W8::linear,        &Utilities::PixelFormatColor_W8::s_rgb,
+            &Utilities::PixelFormatColor_W8A8::linear,      &Utilities::PixelFormatColor_W8A8::s_rgb,
+            &Utilities::PixelFormatColor_R5G5B5A1::linear,  &Utilities::PixelFormatColor_R5G5B5A1::s_rgb,
+            &Utilities::PixelFormatColor_B5G5R5A1::linear,  &Utilities::PixelFormatColor_B5G5R5A1::s_rgb,
+            &Utilities::PixelFormatColor_R5G5B5T1::linear,  &Utilities::PixelFormatColor_R5G5B5T1::s_rgb,
+            &Utilities::PixelFormatColor_B5G5R5T1::linear,  &Utilities::PixelFormatColor_B5G5R5T1::s_rgb,
+            &Utilities::PixelFormatColor_R8G8B8::linear,    &Utilities::PixelFormatColor_R8G8B8::s_rgb,
+            &Utilities::PixelFormatColor_R8G8B8A8::linear,  &Utilities::PixelFormatColor_R8G8B8A8::s_rgb
+        };
+
+        for( unsigned s = 0; s < FORMAT_AMOUNT; s++ ) {
+            formats[ s ] = FORMATS[ s ];
+
+            for( unsigned d = 0; d < FORMAT_AMOUNT; d++ )
+                converters[ s ][ d ] = CONVERTER_MAKERS[ s / 2 ][ d / 2 ]( *FORMATS[ s ], *FORMATS[ d ] );
+        }
+    }
+
+    const Utilities::PixelFormatConverter* get( const Utilities::PixelFormatColor &source, const Utilities::PixelFormatColor &destination ) const {
+        const int source_index      = getFormatIndex( source );
+        const int destination_index = getFormatIndex( destination );
+
+        if( source_index < 0 || destination_index < 0 )
+            return nullptr;
+
+        return &converters[ source_index ][ destination_index ];
+    }
+};
+
 }
 
 std::string Utilities::PixelFormatColor::GenericColor::getString() const {
@@ -441,6 +867,33 @@ Utilities::PixelFormatColor::GenericColor Utilities::PixelFormatColor_R8G8B8A8::
 const Utilities::PixelFormatColor_R8G8B8A8 Utilities::PixelFormatColor_R8G8B8A8::linear = Utilities::PixelFormatColor_R8G8B8A8(Utilities::PixelFormatColor::LINEAR);
 const Utilities::PixelFormatColor_R8G8B8A8 Utilities::PixelFormatColor_R8G8B8A8::s_rgb  = Utilities::PixelFormatColor_R8G8B8A8(Utilities::PixelFormatColor::sRGB);
 
+Utilities::PixelFormatConverter::PixelFormatConverter() : kernel_r( nullptr ), source_byte_size( 0 ) {
+    std::memset( &tables, 0, sizeof( tables ) );
+}
+
+Utilities::PixelFormatConverter::PixelFormatConverter( Kernel kernel, const Tables &tables_param, uint_fast8_t source_byte_size_param ) :
+    kernel_r( kernel ), tables( tables_param ), source_byte_size( source_byte_size_param )
+{
+}
+
+const Utilities::PixelFormatConverter* Utilities::PixelFormatConverter::get( const PixelFormatColor &source, const PixelFormatColor &destination ) {
+    static const ConverterRegistry registry;
+
+    return registry.get( source, destination );
+}
+
+void Utilities::PixelFormatConverter::convert( const uint8_t *source_r, Buffer::Endian source_endian, uint8_t *destination_r, Buffer::Endian destination_endian, size_t pixel_amount ) const {
+    assert( kernel_r != nullptr );
+
+    const bool source_swap      = Buffer::getSwap( source_endian );
+    const bool destination_swap = Buffer::getSwap( destination_endian );
+
+    if( tables.is_copy && source_swap == destination_swap )
+        std::memcpy( destination_r, source_r, pixel_amount * static_cast<size_t>( source_byte_size ) );
+    else
+        kernel_r( tables, source_r, source_swap, destination_r, destination_swap, pixel_amount );
+}
+
 Utilities::ColorPalette::ColorPalette( const Utilities::PixelFormatColor& color_palette, Buffer::Endian endianess_param ) :
     color_r( &color_palette ), buffer(), endianess( endianess_param )
 {
@@ -509,3 +962,30 @@ bool Utilities::ColorPalette::setAmount( uint16_t amount )
     else // Do nothing if the size matches.
         return true;
 }
+
+std::vector<uint8_t> Utilities::ColorPalette::getColorTable( const PixelFormatColor &format, Buffer::Endian endian ) const
+{
+    const size_t TABLE_AMOUNT = 256;
+    const size_t color_amount = empty() ? 0 : static_cast<size_t>( getLastIndex() ) + 1;
+
+    std::vector<uint8_t> table( TABLE_AMOUNT * format.byteSize(), 0 );
+
+    if( color_amount == 0 )
+        return table;
+
+    auto converter_r = PixelFormatConverter::get( *this->color_r, format );
+
+    if( converter_r != nullptr ) {
+        auto reader = buffer.getReader();
+
+        converter_r->convert( reader.readSpan( color_amount * this->color_r->byteSize() ), endianess, table.data(), endian, color_amount );
+    }
+    else {
+        Buffer::Writer writer( table.data(), table.size() );
+
+        for( size_t i = 0; i < color_amount; i++ )
+            format.writePixel( writer, endian, getIndex( i ) );
+    }
+
+    return table;
+}
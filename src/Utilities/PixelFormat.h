@@ -270,6 +270,52 @@ namespace Utilities {
         static const PixelFormatColor_R8G8B8A8  s_rgb;
     };
 
+    /**
+     * This class converts rows of pixels from one pixel format to another without going through GenericColor.
+     *
+     * Every pair of the pixel formats in this header has its own kernel. The kernel only unpacks the channels,
+     * looks them up in the tables and packs them again. The tables are made by readPixel and writePixel,
+     * so a converter writes the same bytes as the GenericColor path does.
+     */
+    class PixelFormatConverter {
+    public:
+        struct Tables {
+            uint8_t color[256]; // The source channel to the destination channel.
+            uint8_t alpha[256]; // The source alpha to the destination alpha.
+            bool is_copy; // The formats are the same and the tables do not change anything.
+        };
+
+        typedef void (*Kernel)( const Tables &tables, const uint8_t *source_r, bool source_swap, uint8_t *destination_r, bool destination_swap, size_t pixel_amount );
+
+    private:
+        Kernel kernel_r;
+        Tables tables;
+        uint_fast8_t source_byte_size;
+
+    public:
+        PixelFormatConverter();
+        PixelFormatConverter( Kernel kernel, const Tables &tables, uint_fast8_t source_byte_size );
+
+        /**
+         * This gets the converter between two of the pixel formats of this header.
+         * @note The converters are made at the first call, after that this method can be called from multiple threads.
+         * @param source The pixel format that would be read.
+         * @param destination The pixel format that would be written.
+         * @return The converter or nullptr if the formats have no kernel, in which case readPixel and writePixel should be used.
+         */
+        static const PixelFormatConverter* get( const PixelFormatColor &source, const PixelFormatColor &destination );
+
+        /**
+         * This converts pixels that are next to each other in memory.
+         * @param source_r The pixels to read. This must not overlap with destination_r.
+         * @param source_endian The endian of the source pixels.
+         * @param destination_r The pixels to write.
+         * @param destination_endian The endian of the destination pixels.
+         * @param pixel_amount The amount of pixels to convert.
+         */
+        void convert( const uint8_t *source_r, Buffer::Endian source_endian, uint8_t *destination_r, Buffer::Endian destination_endian, size_t pixel_amount ) const;
+    };
+
     class ColorPalette {
     private:
         const PixelFormatColor *color_r;
@@ -291,6 +337,14 @@ namespace Utilities {
         
         bool setIndex( palette_index index, const PixelFormatColor::GenericColor &color );
         bool setAmount( uint16_t amount );
+        
+        /**
+         * This converts every color of the palette to another pixel format, so palette indexes can be expanded by only copying bytes.
+         * @param format The pixel format of the table.
+         * @param endian The endian of the table.
+         * @return 256 colors in the format. The colors after the last index are zero.
+         */
+        std::vector<uint8_t> getColorTable( const PixelFormatColor &format, Buffer::Endian endian ) const;
     };
 }
 